@@ -0,0 +1,100 @@
+/**
+ * @file par_command.h
+ * @brief Par命令类定义
+ */
+
+#ifndef DASH_PAR_COMMAND_H
+#define DASH_PAR_COMMAND_H
+
+#include <string>
+#include <vector>
+#include "builtins/builtin_command.h"
+
+namespace dash
+{
+
+    /**
+     * @brief Par命令类
+     *
+     * 实现shell的par内置命令：对每个输入项启动一次外部命令，
+     * 同时最多保持 N 个子进程运行，每结束一个就补上一个。
+     * 子进程登记在作业表中，运行期间 jobs 可见。
+     */
+    class ParCommand : public BuiltinCommand
+    {
+    private:
+        /**
+         * @brief 运行中的子进程
+         */
+        struct Slot
+        {
+            int job_id;
+            int output_fd; // 分组输出时保存子进程输出的匿名文件，否则为 -1
+        };
+
+        /**
+         * @brief 用输入项替换命令模板中的 {}，模板中没有 {} 时追加在末尾
+         *
+         * @param command 命令模板
+         * @param item 输入项
+         * @return std::vector<std::string> 参数列表
+         */
+        static std::vector<std::string> buildArgs(const std::vector<std::string> &command, const std::string &item);
+
+        /**
+         * @brief 等待任意一个子进程结束并回收它的槽位
+         *
+         * @param running 运行中的子进程
+         * @param failed 失败的子进程计数
+         * @return int 1 回收了一个槽位；0 被 SIGINT 中断；-1 剩下的子进程都已停止
+         */
+        int collect(std::vector<Slot> &running, int &failed);
+
+        /**
+         * @brief 向所有运行中的子进程转发 SIGINT
+         *
+         * @param running 运行中的子进程
+         */
+        void interrupt(const std::vector<Slot> &running);
+
+        /**
+         * @brief 输出分组保存的内容并关闭文件
+         *
+         * @param slot 子进程槽位
+         */
+        static void flushOutput(Slot &slot);
+
+    public:
+        /**
+         * @brief 构造函数
+         *
+         * @param shell Shell对象指针
+         */
+        explicit ParCommand(Shell *shell);
+
+        /**
+         * @brief 执行命令
+         *
+         * @param args 命令参数
+         * @return int 执行结果状态码，失败的子进程个数（最多 101）
+         */
+        int execute(const std::vector<std::string> &args) override;
+
+        /**
+         * @brief 获取命令名
+         *
+         * @return std::string 命令名
+         */
+        std::string getName() const override;
+
+        /**
+         * @brief 获取命令帮助信息
+         *
+         * @return std::string 帮助信息
+         */
+        std::string getHelp() const override;
+    };
+
+} // namespace dash
+
+#endif // DASH_PAR_COMMAND_H
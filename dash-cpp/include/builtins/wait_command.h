@@ -45,7 +45,7 @@ namespace dash
          *
          * @return std::string 帮助信息
          */
-        std::string getHelp() const override { return "wait [pid | %job_id ...]"; }
+        std::string getHelp() const override { return "wait [-n] [pid | %job_id ...]"; }
     };
 
 } // namespace dash
@@ -0,0 +1,106 @@
+/**
+ * @file arena.h
+ * @brief 语法树内存池定义
+ */
+
+#ifndef DASH_ARENA_H
+#define DASH_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace dash
+{
+
+    /**
+     * @brief 语法树中使用的字符串类型（从当前内存池分配）
+     */
+    using AstString = std::pmr::string;
+
+    /**
+     * @brief 语法树中使用的容器类型（从当前内存池分配）
+     */
+    template <typename T>
+    using AstVector = std::pmr::vector<T>;
+
+    /**
+     * @brief 单次解析使用的内存池
+     *
+     * 一次解析产生的节点、字符串和容器都从同一块单调增长的缓冲区中分配，
+     * 释放时不逐个归还，而是在内存池析构时一次性释放。
+     *
+     * 内存池总是由 shared_ptr 管理，函数定义可以借此延长其函数体所在内存池的生命周期。
+     */
+    class Arena : public std::enable_shared_from_this<Arena>
+    {
+    private:
+        std::pmr::monotonic_buffer_resource resource_;
+
+    public:
+        /**
+         * @brief 构造函数
+         */
+        Arena();
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        /**
+         * @brief 分配内存
+         *
+         * @param size 字节数
+         * @param align 对齐要求
+         * @return void* 内存地址
+         */
+        void *allocate(std::size_t size, std::size_t align) { return resource_.allocate(size, align); }
+
+        /**
+         * @brief 获取内存资源
+         *
+         * @return std::pmr::memory_resource* 内存资源
+         */
+        std::pmr::memory_resource *resource() { return &resource_; }
+
+        /**
+         * @brief 获取当前生效的内存池
+         *
+         * @return Arena* 当前内存池，不在解析过程中时为 nullptr
+         */
+        static Arena *current();
+    };
+
+    /**
+     * @brief 内存池作用域
+     *
+     * 在作用域内把指定内存池设为当前内存池，并作为 pmr 容器的默认内存资源；
+     * 离开作用域时恢复之前的设置，因此可以嵌套（例如命令替换的重入解析）。
+     */
+    class ArenaScope
+    {
+    private:
+        Arena *previous_;
+        std::pmr::memory_resource *previous_resource_;
+
+    public:
+        /**
+         * @brief 构造函数
+         *
+         * @param arena 内存池
+         */
+        explicit ArenaScope(Arena *arena);
+
+        /**
+         * @brief 析构函数
+         */
+        ~ArenaScope();
+
+        ArenaScope(const ArenaScope &) = delete;
+        ArenaScope &operator=(const ArenaScope &) = delete;
+    };
+
+} // namespace dash
+
+#endif // DASH_ARENA_H
@@ -7,14 +7,117 @@
 #define DASH_ARITHMETIC_H
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 #include "../dash.h"
-#include "../core/lexer.h"
+#include "core/arena.h"
+#include "variable/symbol_table.h"
 
 namespace dash {
 
+class VariableManager;
+
+/**
+ * @brief 算术表达式节点的运算
+ */
+enum class ArithOp : uint8_t {
+    NUMBER,    // 常量
+    VARIABLE,  // 变量引用
+    NEGATE,    // -a
+    NOT,       // !a
+    BIT_NOT,   // ~a
+    PRE_INC,   // ++v
+    PRE_DEC,   // --v
+    POST_INC,  // v++
+    POST_DEC,  // v--
+    MUL, DIV, MOD,
+    ADD, SUB,
+    SHL, SHR,
+    LT, LE, GT, GE,
+    EQ, NE,
+    BIT_AND, BIT_XOR, BIT_OR,
+    AND, OR,   // && ||（短路求值）
+    COND,      // a ? b : c
+    ASSIGN,    // v = a 或复合赋值 v op= a
+    COMMA      // a , b
+};
+
+/**
+ * @brief 编译后的算术表达式
+ *
+ * 表达式在构造时解析一次，得到存放在一个数组中的语法树，
+ * 不含变量和副作用的子表达式在构建时就折叠为常量。
+ * 之后每次求值只需遍历这棵树，不再重新扫描文本。
+ * 变量名在第一次求值时解析为符号表句柄并缓存。
+ *
+ * 解析失败不抛出异常，错误推迟到求值时报告，与其他 shell 的行为一致。
+ */
+class ArithmeticProgram {
+public:
+    /**
+     * @brief 编译表达式
+     *
+     * @param expression 表达式文本（$(( 和 )) 之间的部分）
+     */
+    explicit ArithmeticProgram(std::string_view expression);
+
+    /**
+     * @brief 求值
+     *
+     * @param variables 变量管理器，用于读取和赋值变量
+     * @return long 结果
+     * @throws ShellException 语法错误、除以零或非法数字
+     */
+    long evaluate(VariableManager &variables) const;
+
+    /**
+     * @brief 表达式是否解析成功
+     *
+     * @return bool 是否有效
+     */
+    bool isValid() const { return error_.empty(); }
+
+    /**
+     * @brief 表达式是否已折叠为常量
+     *
+     * @return bool 是否是常量
+     */
+    bool isConstant() const;
+
+private:
+    /**
+     * @brief 语法树节点，子节点用下标引用
+     */
+    struct Node {
+        ArithOp op;
+        ArithOp assign_op; // ASSIGN 的复合运算，普通赋值为 NUMBER
+        uint32_t a, b, c;  // 子节点下标；变量节点的 a 是 vars_ 的下标
+        long value;        // 常量值
+    };
+
+    /**
+     * @brief 表达式中引用的变量
+     */
+    struct Var {
+        AstString name;
+        mutable VarHandle handle; // 第一次求值时解析
+    };
+
+    AstVector<Node> nodes_;
+    AstVector<Var> vars_;
+    uint32_t root_;
+    AstString error_;  // 解析错误信息，为空表示成功
+
+    friend class ArithmeticParser;
+
+    long eval(uint32_t index, VariableManager &variables) const;
+    long readVar(uint32_t var, VariableManager &variables) const;
+    void writeVar(uint32_t var, long value, VariableManager &variables) const;
+};
+
 /**
  * @brief 算术表达式计算类
  */
@@ -22,7 +125,7 @@ class Arithmetic {
 public:
     /**
      * @brief 构造函数
-     * 
+     *
      * @param shell Shell实例引用
      */
     explicit Arithmetic(Shell& shell);
@@ -34,7 +137,9 @@ public:
 
     /**
      * @brief 计算算术表达式的值
-     * 
+     *
+     * 同一表达式文本只编译一次。
+     *
      * @param expression 算术表达式字符串
      * @return long 表达式计算结果
      * @throws ShellException 表达式语法错误
@@ -43,7 +148,7 @@ public:
 
     /**
      * @brief 检查表达式语法是否正确
-     * 
+     *
      * @param expression 算术表达式字符串
      * @return bool 表达式是否有效
      */
@@ -51,26 +156,17 @@ public:
 
 private:
     Shell& shell_;  // Shell实例引用
+    std::unordered_map<std::string, std::unique_ptr<ArithmeticProgram>> cache_; // 已编译的表达式
 
     /**
-     * @brief 词法分析，将表达式转换为词法单元序列
-     * 
+     * @brief 获取表达式的编译结果，未编译过时编译并缓存
+     *
      * @param expression 算术表达式字符串
-     * @return std::vector<Token> 词法单元序列
+     * @return const ArithmeticProgram& 编译结果
      */
-    std::vector<Token> tokenize(const std::string& expression);
-
-    /**
-     * @brief 语法分析并计算表达式
-     * 
-     * @param tokens 词法单元序列
-     * @return long 计算结果
-     */
-    long parse(const std::vector<Token>& tokens);
-
-    // 其他辅助方法
+    const ArithmeticProgram& compile(const std::string& expression);
 };
 
 } // namespace dash
 
-#endif // DASH_ARITHMETIC_H 
\ No newline at end of file
+#endif // DASH_ARITHMETIC_H
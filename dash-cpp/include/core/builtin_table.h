@@ -0,0 +1,143 @@
+/**
+ * @file builtin_table.h
+ * @brief 内置命令分派表定义
+ */
+
+#ifndef DASH_BUILTIN_TABLE_H
+#define DASH_BUILTIN_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace dash
+{
+
+    /**
+     * @brief 内置命令名，下标即内置命令的槽位
+     *
+     * 执行器按同样的槽位存放内置命令对象。
+     */
+    constexpr std::array<std::string_view, 23> BUILTIN_NAMES = {
+        "cd", "echo", "exit", "pwd", "jobs", "fg", "bg", "history", "sprf", "help",
+        "debug", "source", "tsl", "otr", "su", "alias", "unalias", "type", "hash", "kill",
+        "wait", "par", "return"};
+
+    constexpr size_t BUILTIN_COUNT = BUILTIN_NAMES.size();
+
+    constexpr uint8_t NO_BUILTIN = 0xFF;         // 不是内置命令
+    constexpr uint8_t UNRESOLVED_BUILTIN = 0xFE; // 命令名要展开后才能确定
+
+    namespace builtin_table_detail
+    {
+        constexpr size_t TABLE_SIZE = 64; // 与 hash() 取的 6 位高位对应
+
+        /**
+         * @brief 带种子的 FNV-1a 哈希，映射到表中的位置
+         *
+         * FNV-1a 的低位只受输入低位影响，因此取高位作为位置。
+         */
+        constexpr size_t hash(std::string_view name, uint32_t seed)
+        {
+            uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+            for (char c : name)
+            {
+                h ^= static_cast<unsigned char>(c);
+                h *= 16777619u;
+            }
+            return h >> 26;
+        }
+
+        /**
+         * @brief 检查种子是否使所有名字落在不同的位置
+         */
+        constexpr bool isPerfect(uint32_t seed)
+        {
+            std::array<bool, TABLE_SIZE> used{};
+            for (std::string_view name : BUILTIN_NAMES)
+            {
+                size_t index = hash(name, seed);
+                if (used[index])
+                {
+                    return false;
+                }
+                used[index] = true;
+            }
+            return true;
+        }
+
+        /**
+         * @brief 在编译期搜索第一个无冲突的种子
+         */
+        constexpr uint32_t findSeed()
+        {
+            uint32_t seed = 0;
+            while (!isPerfect(seed))
+            {
+                ++seed;
+            }
+            return seed;
+        }
+
+        constexpr uint32_t SEED = findSeed();
+
+        /**
+         * @brief 构建位置到槽位的映射
+         */
+        constexpr std::array<uint8_t, TABLE_SIZE> buildSlots()
+        {
+            std::array<uint8_t, TABLE_SIZE> slots{};
+            for (size_t i = 0; i < TABLE_SIZE; ++i)
+            {
+                slots[i] = NO_BUILTIN;
+            }
+            for (size_t i = 0; i < BUILTIN_COUNT; ++i)
+            {
+                slots[hash(BUILTIN_NAMES[i], SEED)] = static_cast<uint8_t>(i);
+            }
+            return slots;
+        }
+
+        constexpr std::array<uint8_t, TABLE_SIZE> SLOTS = buildSlots();
+
+        constexpr size_t maxNameLength()
+        {
+            size_t length = 0;
+            for (std::string_view name : BUILTIN_NAMES)
+            {
+                length = name.size() > length ? name.size() : length;
+            }
+            return length;
+        }
+
+        constexpr size_t MAX_NAME_LENGTH = maxNameLength();
+    }
+
+    /**
+     * @brief 查找内置命令的槽位
+     *
+     * 编译期生成的完美哈希：一次哈希加一次字符串比较，不分配内存。
+     *
+     * @param name 命令名
+     * @return uint8_t 槽位，不是内置命令时为 NO_BUILTIN
+     */
+    constexpr uint8_t lookupBuiltin(std::string_view name)
+    {
+        using namespace builtin_table_detail;
+        if (name.empty() || name.size() > MAX_NAME_LENGTH)
+        {
+            return NO_BUILTIN;
+        }
+        uint8_t slot = SLOTS[hash(name, SEED)];
+        return slot != NO_BUILTIN && BUILTIN_NAMES[slot] == name ? slot : NO_BUILTIN;
+    }
+
+    static_assert(lookupBuiltin("echo") == 1 && lookupBuiltin("return") == BUILTIN_COUNT - 1,
+                  "builtin table must map every name to its own slot");
+    static_assert(lookupBuiltin("ech") == NO_BUILTIN && lookupBuiltin("ls") == NO_BUILTIN,
+                  "builtin table must reject unknown names");
+
+} // namespace dash
+
+#endif // DASH_BUILTIN_TABLE_H
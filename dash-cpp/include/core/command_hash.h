@@ -0,0 +1,106 @@
+/**
+ * @file command_hash.h
+ * @brief 命令路径哈希表定义
+ */
+
+#ifndef DASH_COMMAND_HASH_H
+#define DASH_COMMAND_HASH_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ctime>
+
+namespace dash
+{
+
+    /**
+     * @brief 命令路径哈希表
+     *
+     * 缓存命令名到绝对路径的映射，避免每次执行外部命令都扫描 PATH。
+     * PATH 改变时整体失效，缓存的路径失效时由调用者删除单个条目。
+     * 同时缓存 PATH 中各目录的可执行文件列表，供命令补全使用。
+     */
+    class CommandHash
+    {
+    public:
+        /**
+         * @brief 哈希表条目
+         */
+        struct Entry
+        {
+            std::string path; // 命令的完整路径
+            int hits;         // 命中次数
+        };
+
+        /**
+         * @brief 查找命令路径
+         *
+         * 命中缓存时直接返回；否则扫描 PATH，并缓存绝对路径的结果。
+         * 命令名包含 '/' 时不查表。
+         *
+         * @param name 命令名
+         * @param path_var PATH 的值
+         * @return std::string 命令路径，找不到时为空字符串
+         */
+        std::string find(const std::string &name, const std::string &path_var);
+
+        /**
+         * @brief 删除单个条目（例如缓存的路径已不存在）
+         *
+         * @param name 命令名
+         * @return true 条目存在并已删除
+         * @return false 条目不存在
+         */
+        bool remove(const std::string &name);
+
+        /**
+         * @brief 清空哈希表和目录缓存
+         */
+        void clear();
+
+        /**
+         * @brief 获取所有条目
+         *
+         * @return const std::unordered_map<std::string, Entry>& 条目表
+         */
+        const std::unordered_map<std::string, Entry> &entries() const { return table_; }
+
+        /**
+         * @brief 列出 PATH 中以指定前缀开头的可执行文件
+         *
+         * 每个目录的列表在目录修改时间变化时才重新扫描。
+         *
+         * @param prefix 前缀
+         * @param path_var PATH 的值
+         * @return std::vector<std::string> 匹配的命令名
+         */
+        std::vector<std::string> complete(const std::string &prefix, const std::string &path_var);
+
+        /**
+         * @brief 在 PATH 中搜索命令（不使用缓存）
+         *
+         * @param name 命令名
+         * @param path_var PATH 的值
+         * @return std::string 命令路径，找不到时为空字符串
+         */
+        static std::string search(const std::string &name, const std::string &path_var);
+
+    private:
+        /**
+         * @brief 目录列表缓存
+         */
+        struct DirCache
+        {
+            std::string dir;                 // 目录路径
+            time_t mtime;                    // 扫描时目录的修改时间
+            std::vector<std::string> names;  // 可执行文件名
+        };
+
+        std::unordered_map<std::string, Entry> table_;
+        std::unordered_map<std::string, DirCache> dirs_;
+    };
+
+} // namespace dash
+
+#endif // DASH_COMMAND_HASH_H
@@ -0,0 +1,165 @@
+/**
+ * @file event_loop.h
+ * @brief 交互模式的事件循环定义
+ */
+
+#ifndef DASH_EVENT_LOOP_H
+#define DASH_EVENT_LOOP_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <signal.h>
+#include <sys/types.h>
+
+namespace dash
+{
+
+    /**
+     * @brief 基于 epoll 的事件循环
+     *
+     * SIGCHLD 和 SIGINT 被屏蔽后改由 signalfd 读取，后台进程另用 pidfd 监视
+     * （每个进程退出都单独触发，不受 SIGCHLD 合并递送的影响），
+     * 与终端输入放在同一个 epoll 集合中。等待输入时到达的事件立即分发，
+     * 不必等到用户按下回车。
+     *
+     * 打开期间 fork 出的子进程会通过 pthread_atfork 恢复原来的信号掩码。
+     */
+    class EventLoop
+    {
+    public:
+        /**
+         * @brief 事件回调，参数为 SIGINT 或 SIGCHLD（子进程状态变化）
+         */
+        using SignalCallback = std::function<void(int)>;
+
+    private:
+        int epoll_fd_;
+        int signal_fd_;
+        int input_fd_;                              // 已加入 epoll 的输入描述符
+        sigset_t saved_mask_;                       // 打开前的信号掩码
+        std::unordered_map<pid_t, int> pidfds_;     // 进程 ID 到 pidfd
+        std::vector<pid_t> exited_;                 // pidfd 报告已退出、尚未取走的进程
+        SignalCallback callback_;
+
+        /**
+         * @brief 等待一批事件
+         *
+         * @param timeout 超时（毫秒），-1 表示一直等待
+         * @param readable 输出：输入描述符是否可读
+         * @return unsigned 到达的事件位，出错时为 EVENT_ERROR
+         */
+        unsigned poll(int timeout, bool &readable);
+
+        /**
+         * @brief 按事件位调用回调，每种事件只调用一次
+         *
+         * @param events 事件位
+         * @param onSignal 回调
+         */
+        static void deliver(unsigned events, const SignalCallback &onSignal);
+
+        // 防止拷贝构造和赋值操作
+        EventLoop(const EventLoop &) = delete;
+        EventLoop &operator=(const EventLoop &) = delete;
+
+    public:
+        /**
+         * @brief 构造函数
+         */
+        EventLoop();
+
+        /**
+         * @brief 析构函数
+         */
+        ~EventLoop();
+
+        /**
+         * @brief 屏蔽 SIGCHLD 和 SIGINT，创建 signalfd 和 epoll
+         *
+         * @return true 成功
+         * @return false 失败，事件循环保持关闭
+         */
+        bool open();
+
+        /**
+         * @brief 关闭所有描述符并恢复信号掩码
+         */
+        void close();
+
+        /**
+         * @brief 检查事件循环是否已打开
+         *
+         * fork 出的子进程（如管道中的内置命令）继承了描述符，但 epoll 实例与
+         * 父进程共享，修改会影响父进程，因此在子进程中视为未打开。
+         *
+         * @return true 已打开
+         * @return false 未打开
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief 设置默认的事件回调
+         *
+         * @param callback 回调
+         */
+        void setSignalCallback(SignalCallback callback) { callback_ = std::move(callback); }
+
+        /**
+         * @brief 分发事件给默认回调
+         *
+         * @param signo SIGINT 或 SIGCHLD
+         */
+        void dispatch(int signo);
+
+        /**
+         * @brief 等待描述符可读，期间到达的事件交给 onSignal 处理
+         *
+         * @param fd 描述符
+         * @param onSignal 事件回调
+         * @return true 描述符可读
+         * @return false epoll 出错
+         */
+        bool waitReadable(int fd, const SignalCallback &onSignal);
+
+        /**
+         * @brief 等待下一个信号事件，不关心终端输入
+         *
+         * @return int SIGINT 或 SIGCHLD，epoll 出错时返回 -1
+         */
+        int waitSignal();
+
+        /**
+         * @brief 不阻塞地分发已到达的事件
+         */
+        void dispatchPending();
+
+        /**
+         * @brief 用 pidfd 监视进程退出
+         *
+         * 内核不支持 pidfd 或进程已不存在时忽略，仍由 SIGCHLD 兜底。
+         *
+         * @param pid 进程 ID
+         */
+        void watchProcess(pid_t pid);
+
+        /**
+         * @brief 停止监视进程
+         *
+         * @param pid 进程 ID
+         */
+        void unwatchProcess(pid_t pid);
+
+        /**
+         * @brief 取出 pidfd 报告已退出的进程
+         *
+         * 已被其他地方回收的进程无法再用 waitpid 得知退出，由此补充。
+         *
+         * @return std::vector<pid_t> 进程 ID 列表
+         */
+        std::vector<pid_t> takeExitedProcesses();
+    };
+
+} // namespace dash
+
+#endif // DASH_EVENT_LOOP_H
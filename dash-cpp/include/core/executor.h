@@ -10,8 +10,10 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
-#include <functional>
+#include <array>
 #include "core/node.h"
+#include "core/builtin_table.h"
+#include "core/command_hash.h"
 
 namespace dash
 {
@@ -30,10 +32,24 @@ namespace dash
     class Executor
     {
     private:
+        /**
+         * @brief 已定义的函数
+         *
+         * 内存池在前声明，析构时函数体先于其所在的内存池释放。
+         */
+        struct Function
+        {
+            std::shared_ptr<Arena> arena;
+            std::shared_ptr<const Node> body;
+        };
+
         Shell *shell_;
-        std::unordered_map<std::string, std::function<int(const std::vector<std::string> &)>> builtins_;
-        std::vector<std::shared_ptr<BuiltinCommand>> builtin_commands_; // 存储内置命令对象
+        std::array<std::unique_ptr<BuiltinCommand>, BUILTIN_COUNT> builtins_; // 按槽位存放的内置命令对象
+        std::unordered_map<std::string, Function> functions_;                 // 函数表
+        CommandHash command_hash_;                                       // 命令路径哈希表
         int last_status_;
+        int function_depth_;   // 正在执行的函数调用层数
+        bool return_requested_; // return 已被请求，正在退出函数体
 
         /**
          * @brief 执行重定向
@@ -42,7 +58,7 @@ namespace dash
          * @param saved_fds 保存的文件描述符映射
          * @return bool 是否成功
          */
-        bool applyRedirections(const std::vector<Redirection> &redirections, std::unordered_map<int, int> &saved_fds);
+        bool applyRedirections(const AstVector<Redirection> &redirections, std::unordered_map<int, int> &saved_fds);
 
         /**
          * @brief 恢复重定向
@@ -59,14 +75,89 @@ namespace dash
          */
         int executeCommand(const CommandNode *command);
 
+        /**
+         * @brief 展开命令参数
+         *
+         * @param command 命令节点
+         * @return std::vector<std::string> 展开后的参数
+         */
+        std::vector<std::string> expandArgs(const CommandNode *command);
+
+        /**
+         * @brief 执行命令前的变量赋值
+         *
+         * @param command 命令节点
+         * @param flags 变量标志
+         */
+        void applyAssignments(const CommandNode *command, int flags);
+
+        /**
+         * @brief 展开命令前缀赋值，得到 "NAME=value" 形式的环境条目
+         *
+         * @param command 命令节点
+         * @return std::vector<std::string> 环境条目
+         */
+        std::vector<std::string> expandAssignments(const CommandNode *command);
+
         /**
          * @brief 执行管道
          *
+         * 将整条管道展开为 N 个阶段，一次性创建 N-1 个管道并 fork 恰好 N 个子进程，
+         * 然后作为一个整体等待（或作为一个后台作业登记）。
+         *
          * @param pipe 管道节点
-         * @return int 执行结果状态码
+         * @return int 执行结果状态码（最后一个阶段的状态）
          */
         int executePipe(const PipeNode *pipe);
 
+        /**
+         * @brief 在管道子进程中执行一个阶段，不返回
+         *
+         * @param node 阶段节点
+         */
+        [[noreturn]] void execPipelineStage(const Node *node);
+
+        /**
+         * @brief 使用 posix_spawn 启动外部命令（不复制 shell 地址空间）
+         *
+         * 重定向被翻译为 posix_spawn 文件动作。失败时返回 -1，
+         * 调用者应回退到 fork + exec 路径以输出错误信息。
+         *
+         * @param args 已展开的参数列表
+         * @param redirections 重定向列表
+         * @param envp 子进程的环境变量数组
+         * @param in_fd 作为标准输入的描述符，-1 表示不变
+         * @param out_fd 作为标准输出的描述符，-1 表示不变
+         * @param close_fds 子进程中需要关闭的描述符
+         * @param pgid 进程组 ID，-1 表示不设置，0 表示新建进程组
+         * @return pid_t 子进程 ID，失败返回 -1
+         */
+        pid_t spawnExternal(const std::vector<std::string> &args, const AstVector<Redirection> &redirections,
+                            char *const *envp, int in_fd = -1, int out_fd = -1, const std::vector<int> &close_fds = {},
+                            pid_t pgid = -1);
+
+        /**
+         * @brief 启动后台外部命令并登记为作业
+         *
+         * 作业控制未启用时标准输入来自 /dev/null，重定向在其后应用。
+         *
+         * @param args 已展开的参数列表
+         * @param redirections 重定向列表
+         * @param env_overlay 叠加到子进程环境中的前缀赋值
+         * @return int 执行结果状态码
+         */
+        int spawnBackground(const std::vector<std::string> &args, const AstVector<Redirection> &redirections,
+                            const std::vector<std::string> &env_overlay = {});
+
+        /**
+         * @brief 将已启动的后台进程登记为一个作业并输出作业号
+         *
+         * @param command 作业的命令文本
+         * @param pgid 进程组 ID
+         * @param pids 作业的全部进程
+         */
+        void registerBackgroundJob(const std::string &command, pid_t pgid, const std::vector<pid_t> &pids);
+
         /**
          * @brief 执行列表
          *
@@ -115,6 +206,26 @@ namespace dash
          */
         int executeSubshell(const SubshellNode *subshell);
 
+        /**
+         * @brief 登记函数定义
+         *
+         * @param function 函数定义节点
+         * @return int 执行结果状态码
+         */
+        int defineFunction(const FunctionNode *function);
+
+        /**
+         * @brief 调用函数
+         *
+         * 参数作为位置参数，调用期间替换调用者的位置参数，返回后恢复。
+         * 函数体中的 return 在这里结束。
+         *
+         * @param command 命令节点（提供前缀赋值和重定向）
+         * @param args 参数列表，args[0] 是函数名
+         * @return int 执行结果状态码
+         */
+        int callFunction(const CommandNode *command, const std::vector<std::string> &args);
+
         /**
          * @brief 执行外部命令
          *
@@ -122,10 +233,12 @@ namespace dash
          * @param args 参数列表
          * @param redirections 重定向列表
          * @param background 是否后台运行
+         * @param env_overlay 叠加到子进程环境中的前缀赋值
          * @return int 执行结果状态码
          */
         int executeExternalCommand(const std::string &command, const std::vector<std::string> &args,
-                                   const std::vector<Redirection> &redirections, bool background);
+                                   const AstVector<Redirection> &redirections, bool background,
+                                   const std::vector<std::string> &env_overlay = {});
 
         /**
          * @brief 检查是否是内置命令
@@ -136,27 +249,64 @@ namespace dash
         bool isBuiltin(const std::string &command) const;
 
         /**
-         * @brief 执行内置命令
+         * @brief 检查是否是已定义的函数
          *
          * @param command 命令名
+         * @return bool 是否是函数
+         */
+        bool isFunction(const std::string &command) const;
+
+        /**
+         * @brief 执行内置命令
+         *
+         * @param slot 内置命令槽位
          * @param args 参数列表
          * @return int 执行结果状态码
          */
-        int executeBuiltin(const std::string &command, const std::vector<std::string> &args);
+        int executeBuiltin(uint8_t slot, const std::vector<std::string> &args);
+
+        /**
+         * @brief 获取命令的内置命令槽位
+         *
+         * 优先使用解析时缓存在节点上的槽位，命令名含展开时才按展开结果查找。
+         *
+         * @param command 命令节点
+         * @param name 展开后的命令名
+         * @return uint8_t 槽位，不是内置命令时为 NO_BUILTIN
+         */
+        static uint8_t builtinSlot(const CommandNode *command, const std::string &name);
 
         /**
          * @brief 注册内置命令
          */
         void registerBuiltins();
 
+        /**
+         * @brief 创建内置命令对象并放入它在分派表中的槽位
+         *
+         * @tparam T 内置命令类型
+         */
+        template <typename T>
+        void installBuiltin();
+
     public:
         /**
          * @brief 在子进程中执行命令
          *
          * @param command 命令
          * @param args 参数列表
+         * @param envp 环境变量数组，nullptr 表示使用导出变量的快照
+         */
+        void exec_in_child(const std::string &command, const std::vector<std::string> &args,
+                           char *const *envp = nullptr);
+
+        /**
+         * @brief 将管道节点展开为扁平的阶段列表
+         *
+         * @param node 管道或叶子节点
+         * @param stages 输出的阶段列表（从左到右）
          */
-        void exec_in_child(const std::string &command, const std::vector<std::string> &args);
+        static void collectPipeline(const Node *node, std::vector<const Node *> &stages);
 
         /**
          * @brief 构造函数
@@ -186,11 +336,11 @@ namespace dash
         int getLastStatus() const { return last_status_; }
 
         /**
-         * @brief 设置上一次执行状态
+         * @brief 设置上一次执行状态，同时更新 $?
          *
          * @param status 状态码
          */
-        void setLastStatus(int status) { last_status_ = status; }
+        void setLastStatus(int status);
 
         /**
          * @brief 获取 Shell 对象
@@ -206,6 +356,82 @@ namespace dash
          * @return bool 是否存在该内置命令
          */
         bool hasBuiltinCommand(const std::string &command) const;
+
+        /**
+         * @brief 检查是否是无副作用的内置命令
+         *
+         * 这类内置命令只产生输出，不修改 shell 状态，
+         * 可以在命令替换中不 fork 直接执行。
+         *
+         * @param command 命令名
+         * @return bool 是否是无副作用的内置命令
+         */
+        bool isPureBuiltin(const std::string &command) const;
+
+        /**
+         * @brief 在当前进程中执行纯内置命令并捕获标准输出
+         *
+         * 仅当节点是一条不带赋值、重定向和后台标志的纯内置命令时才执行。
+         *
+         * @param node 命令树
+         * @param output 捕获的输出
+         * @param status 执行结果状态码
+         * @return true 已在当前进程中执行
+         * @return false 不满足条件，未执行
+         */
+        bool runCaptured(const Node *node, std::string &output, int &status);
+
+        /**
+         * @brief 获取命令路径哈希表
+         *
+         * @return CommandHash& 命令路径哈希表
+         */
+        CommandHash &getCommandHash() { return command_hash_; }
+
+        /**
+         * @brief 通过哈希表查找外部命令的路径
+         *
+         * @param command 命令名
+         * @return std::string 命令路径，找不到时为空字符串
+         */
+        std::string findCommand(const std::string &command);
+
+        /**
+         * @brief 在新的进程组中启动外部命令，不等待也不登记作业
+         *
+         * 先走 posix_spawn 快速路径，失败时回退到 fork + exec，由子进程输出错误信息。
+         *
+         * @param args 已展开的参数列表
+         * @param redirections 重定向列表
+         * @param in_fd 作为标准输入的描述符，-1 表示不变
+         * @param out_fd 作为标准输出的描述符，-1 表示不变
+         * @param env_overlay 叠加到子进程环境中的前缀赋值
+         * @return pid_t 子进程 ID（同时是进程组 ID）
+         * @throws ShellException fork 失败
+         */
+        pid_t startExternal(const std::vector<std::string> &args, const AstVector<Redirection> &redirections,
+                            int in_fd = -1, int out_fd = -1, const std::vector<std::string> &env_overlay = {});
+
+        /**
+         * @brief 检查是否正在执行函数
+         *
+         * @return bool 是否在函数体内
+         */
+        bool inFunction() const { return function_depth_ > 0; }
+
+        /**
+         * @brief 请求从当前函数返回
+         *
+         * 列表和循环在当前命令结束后停止，由 callFunction 清除请求。
+         */
+        void requestReturn() { return_requested_ = true; }
+
+        /**
+         * @brief 检查是否应停止执行后续命令
+         *
+         * @return bool exit 或 return 已被请求
+         */
+        bool isUnwinding() const;
     };
 
 } // namespace dash
@@ -0,0 +1,107 @@
+/**
+ * @file glob.h
+ * @brief 路径名展开（通配符匹配）定义
+ */
+
+#ifndef DASH_GLOB_H
+#define DASH_GLOB_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/arena.h"
+#include "core/pattern.h"
+
+namespace dash
+{
+
+    /**
+     * @brief 编译后的路径名模式
+     *
+     * 模式按 '/' 拆分为路径分量，每个分量预先编译为一个 PatternMatcher。
+     * 不含通配符的分量直接用 openat/fstatat 定位，不读取目录，
+     * 因此模式开头的字面路径前缀不会产生任何目录扫描；
+     * 含通配符的分量用 getdents64 一次读完目录并逐项匹配。
+     */
+    class GlobPattern
+    {
+    public:
+        /**
+         * @brief 展开方式
+         */
+        enum class Mode
+        {
+            NONE,    // 不做路径名展开（带引号或不含通配符的单词）
+            STATIC,  // 单词本身就是模式，解析时已编译
+            DYNAMIC  // 单词含变量引用或命令替换，求值后再决定是否编译
+        };
+
+    private:
+        Mode mode_;
+        bool absolute_;  // 模式以 '/' 开头
+        bool dir_only_;  // 模式以 '/' 结尾，只匹配目录
+        AstVector<PatternMatcher> components_;
+
+        /**
+         * @brief 编译模式
+         *
+         * @param pattern 模式文本
+         */
+        void compile(std::string_view pattern);
+
+        /**
+         * @brief 从指定目录开始匹配第 index 个分量
+         *
+         * @param dirfd 目录描述符（AT_FDCWD 表示当前目录）
+         * @param path 已匹配的路径前缀
+         * @param index 分量下标
+         * @param results 匹配结果
+         */
+        void walk(int dirfd, std::string &path, size_t index, std::vector<std::string> &results) const;
+
+        /**
+         * @brief 执行匹配，结果按字节序排序后追加到 out
+         *
+         * @param out 输出列表
+         * @return bool 是否至少匹配到一个路径
+         */
+        bool run(std::vector<std::string> &out) const;
+
+    public:
+        /**
+         * @brief 构造不做展开的模式
+         */
+        GlobPattern();
+
+        /**
+         * @brief 为解析得到的单词构造模式
+         *
+         * 带引号的单词不展开；含变量引用或命令替换的单词推迟到求值后处理；
+         * 其余含通配符的单词在此立即编译。
+         *
+         * @param word 单词原文
+         * @param quoted 单词是否含引号
+         */
+        GlobPattern(std::string_view word, bool quoted);
+
+        /**
+         * @brief 获取展开方式
+         *
+         * @return Mode 展开方式
+         */
+        Mode getMode() const { return mode_; }
+
+        /**
+         * @brief 对单词求值结果做路径名展开
+         *
+         * 没有匹配时按 POSIX 保留原单词。
+         *
+         * @param value 单词求值结果
+         * @param out 输出列表，展开结果追加到末尾
+         */
+        void expand(const std::string &value, std::vector<std::string> &out) const;
+    };
+
+} // namespace dash
+
+#endif // DASH_GLOB_H
@@ -18,6 +18,7 @@ namespace dash
 
     // 前向声明
     class Shell;
+    class EventLoop;
 
     /**
      * @brief 输入源基类
@@ -150,6 +151,8 @@ namespace dash
         bool interactive_;
         std::string prompt_;
         bool use_readline_;  // 是否使用readline库
+        EventLoop *event_loop_;  // 等待输入时分发事件的事件循环，可为空
+        bool reading_;           // 是否正在以回调方式读取一行
 
         // Tab自动补全相关函数类型定义
         using CompletionFunc = std::function<std::vector<std::string>(const std::string&, int, int)>;
@@ -172,6 +175,15 @@ namespace dash
          */
         std::string readLineWithReadline();
 
+        /**
+         * @brief 由事件循环驱动 readline 读取一行
+         *
+         * 等待输入期间到达的子进程事件立即分发，Ctrl+C 丢弃当前行。
+         *
+         * @return char* readline 分配的行，EOF 时为 nullptr
+         */
+        char *readLineWithEventLoop();
+
     public:
         /**
          * @brief 构造函数
@@ -228,6 +240,20 @@ namespace dash
          */
         void setCompletionFunction(CompletionFunc func);
 
+        /**
+         * @brief 设置等待输入时使用的事件循环
+         *
+         * @param event_loop 事件循环，为空或未打开时直接阻塞读取
+         */
+        void setEventLoop(EventLoop *event_loop) { event_loop_ = event_loop; }
+
+        /**
+         * @brief 输出异步通知，正在编辑的行在通知之后重画
+         *
+         * @param text 通知文本
+         */
+        void showNotification(const std::string &text);
+
         /**
          * @brief 执行Tab自动补全
          * 
@@ -344,6 +370,13 @@ namespace dash
          */
         void setPrompt(const std::string &prompt);
 
+        /**
+         * @brief 输出异步通知（如后台作业完成），不打乱正在编辑的输入行
+         *
+         * @param text 通知文本
+         */
+        void showNotification(const std::string &text);
+
         /**
          * @brief Tab自动补全函数（公共版本，用于测试）
          * 
@@ -7,9 +7,10 @@
 #define DASH_LEXER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
-#include <queue>
+#include <array>
 
 namespace dash
 {
@@ -32,16 +33,26 @@ namespace dash
 
     /**
      * @brief 词法单元类
+     *
+     * 值类型的小对象。值是输入缓冲区的切片；需要去引号的单词则指向
+     * 词法分析器内部的暂存区。两者都在词法分析器重新设置输入之前有效。
      */
     class Token
     {
     private:
         TokenType type_;
-        std::string value_;
+        std::string_view value_;
+        std::string_view raw_;  // 单词在输入中的原样切片（含引号）
+        bool quote_removed_;    // 值经过去引号处理，不是输入的原样切片
         int line_number_;
         int column_;
 
     public:
+        /**
+         * @brief 默认构造函数（输入结束）
+         */
+        Token();
+
         /**
          * @brief 构造函数
          *
@@ -49,8 +60,11 @@ namespace dash
          * @param value 词法单元值
          * @param line_number 行号
          * @param column 列号
+         * @param quote_removed 值是否经过去引号处理
+         * @param raw 单词在输入中的原样切片，为空时与值相同
          */
-        Token(TokenType type, const std::string &value, int line_number, int column);
+        Token(TokenType type, std::string_view value, int line_number, int column, bool quote_removed = false,
+              std::string_view raw = std::string_view());
 
         /**
          * @brief 获取词法单元类型
@@ -62,9 +76,24 @@ namespace dash
         /**
          * @brief 获取词法单元值
          *
-         * @return const std::string& 词法单元值
+         * @return std::string_view 词法单元值
+         */
+        std::string_view getValue() const { return value_; }
+
+        /**
+         * @brief 获取单词在输入中的原样文本，保留引号，用于需要区分逐个字符是否带引号的场合
+         *
+         * @return std::string_view 原样文本
+         */
+        std::string_view getRaw() const { return raw_; }
+
+        /**
+         * @brief 值是否经过去引号处理，即单词中是否含有引号
+         *
+         * @return true 单词中含有引号，值已去掉引号
+         * @return false 值是输入的原样切片
          */
-        const std::string &getValue() const { return value_; }
+        bool isQuoteRemoved() const { return quote_removed_; }
 
         /**
          * @brief 获取行号
@@ -99,9 +128,20 @@ namespace dash
         size_t position_;
         int line_number_;
         int column_;
-        std::queue<std::unique_ptr<Token>> token_queue_;
         bool eof_seen_;
 
+        // 前瞻词法单元的环形缓冲区
+        static constexpr size_t TOKEN_RING_SIZE = 4;
+        std::array<Token, TOKEN_RING_SIZE> token_ring_;
+        size_t ring_head_;
+        size_t ring_count_;
+
+        // 去引号后的单词文本：scratch_ 用于拼接当前单词，完成后复制到按块分配的暂存区
+        std::string scratch_;
+        std::vector<std::unique_ptr<char[]>> cooked_chunks_;
+        size_t cooked_used_;
+        size_t cooked_capacity_;
+
         /**
          * @brief 获取当前字符
          *
@@ -129,16 +169,31 @@ namespace dash
         /**
          * @brief 解析单词
          *
-         * @return std::unique_ptr<Token> 单词词法单元
+         * @return Token 单词词法单元
          */
-        std::unique_ptr<Token> parseWord();
+        Token parseWord();
 
         /**
          * @brief 解析操作符
          *
-         * @return std::unique_ptr<Token> 操作符词法单元
+         * @return Token 操作符词法单元
+         */
+        Token parseOperator();
+
+        /**
+         * @brief 从输入中读取下一个词法单元（不经过前瞻缓冲区）
+         *
+         * @return Token 词法单元
+         */
+        Token scanToken();
+
+        /**
+         * @brief 将去引号后的单词文本保存到暂存区
+         *
+         * @param text 单词文本
+         * @return std::string_view 暂存区中的文本
          */
-        std::unique_ptr<Token> parseOperator();
+        std::string_view storeCooked(const std::string &text);
 
         /**
          * @brief 解析注释
@@ -181,23 +236,23 @@ namespace dash
         /**
          * @brief 获取下一个词法单元
          *
-         * @return std::unique_ptr<Token> 下一个词法单元
+         * @return Token 下一个词法单元
          */
-        std::unique_ptr<Token> nextToken();
+        Token nextToken();
 
         /**
          * @brief 前瞻下一个词法单元
          *
-         * @return const Token* 下一个词法单元的指针，不转移所有权
+         * @return const Token* 下一个词法单元的指针，指向前瞻缓冲区
          */
         const Token *peekToken();
 
         /**
-         * @brief 将词法单元放回队列
+         * @brief 将词法单元放回前瞻缓冲区
          *
          * @param token 要放回的词法单元
          */
-        void ungetToken(std::unique_ptr<Token> token);
+        void ungetToken(const Token &token);
     };
 
 } // namespace dash
@@ -9,7 +9,12 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <string_view>
 #include "../dash.h"
+#include "core/arena.h"
+#include "core/builtin_table.h"
+#include "core/glob.h"
+#include "variable/expansion_program.h"
 
 namespace dash
 {
@@ -35,12 +40,13 @@ namespace dash
      */
     struct Redirection
     {
-        RedirType type;       // 重定向类型
-        int fd;               // 文件描述符
-        std::string filename; // 文件名或目标文件描述符
+        RedirType type;           // 重定向类型
+        int fd;                   // 文件描述符
+        AstString filename;       // 文件名或目标文件描述符
+        ExpansionProgram program; // 文件名的展开程序
 
-        Redirection(RedirType t, int f, const std::string &fn)
-            : type(t), fd(f), filename(fn) {}
+        Redirection(RedirType t, int f, std::string_view fn)
+            : type(t), fd(f), filename(fn), program(fn) {}
     };
 
     /**
@@ -64,6 +70,25 @@ namespace dash
          */
         virtual ~Node() = default;
 
+        /**
+         * @brief 分配节点内存
+         *
+         * 解析过程中（存在当前内存池时）从内存池分配，否则从堆上分配。
+         *
+         * @param size 字节数
+         * @return void* 内存地址
+         */
+        static void *operator new(std::size_t size);
+
+        /**
+         * @brief 释放节点内存
+         *
+         * 内存池中的节点只析构不释放，内存随内存池一起回收。
+         *
+         * @param ptr 内存地址
+         */
+        static void operator delete(void *ptr);
+
         /**
          * @brief 获取节点类型
          *
@@ -85,10 +110,14 @@ namespace dash
     class CommandNode : public Node
     {
     private:
-        std::vector<std::string> args_;
-        std::vector<std::string> assignments_;
-        std::vector<Redirection> redirections_;
+        AstVector<AstString> args_;
+        AstVector<AstString> assignments_;
+        AstVector<Redirection> redirections_;
+        AstVector<ExpansionProgram> arg_programs_;        // 每个参数的展开程序
+        AstVector<ExpansionProgram> assignment_programs_; // 每个赋值右侧的展开程序
+        AstVector<GlobPattern> arg_globs_;                // 每个参数的路径名展开模式
         bool background_; // 是否在后台运行
+        uint8_t builtin_slot_; // 命令名对应的内置命令槽位，解析时确定
 
     public:
         /**
@@ -115,15 +144,16 @@ namespace dash
          * @brief 添加参数
          *
          * @param arg 参数
+         * @param quoted 参数是否含引号（带引号的参数不做路径名展开）
          */
-        void addArg(const std::string &arg);
+        void addArg(std::string_view arg, bool quoted = false);
 
         /**
          * @brief 添加变量赋值
          *
          * @param assignment 变量赋值
          */
-        void addAssignment(const std::string &assignment);
+        void addAssignment(std::string_view assignment);
 
         /**
          * @brief 添加重定向
@@ -135,23 +165,53 @@ namespace dash
         /**
          * @brief 获取参数
          *
-         * @return const std::vector<std::string>& 参数列表
+         * @return const AstVector<AstString>& 参数列表
          */
-        const std::vector<std::string> &getArgs() const { return args_; }
+        const AstVector<AstString> &getArgs() const { return args_; }
 
         /**
          * @brief 获取变量赋值
          *
-         * @return const std::vector<std::string>& 变量赋值列表
+         * @return const AstVector<AstString>& 变量赋值列表
          */
-        const std::vector<std::string> &getAssignments() const { return assignments_; }
+        const AstVector<AstString> &getAssignments() const { return assignments_; }
 
         /**
          * @brief 获取重定向
          *
-         * @return const std::vector<Redirection>& 重定向列表
+         * @return const AstVector<Redirection>& 重定向列表
          */
-        const std::vector<Redirection> &getRedirections() const { return redirections_; }
+        const AstVector<Redirection> &getRedirections() const { return redirections_; }
+
+        /**
+         * @brief 获取参数的展开程序（与 getArgs() 一一对应）
+         *
+         * @return const AstVector<ExpansionProgram>& 展开程序列表
+         */
+        const AstVector<ExpansionProgram> &getArgPrograms() const { return arg_programs_; }
+
+        /**
+         * @brief 获取参数的路径名展开模式（与 getArgs() 一一对应）
+         *
+         * @return const AstVector<GlobPattern>& 模式列表
+         */
+        const AstVector<GlobPattern> &getArgGlobs() const { return arg_globs_; }
+
+        /**
+         * @brief 获取赋值右侧的展开程序（与 getAssignments() 一一对应）
+         *
+         * @return const AstVector<ExpansionProgram>& 展开程序列表
+         */
+        const AstVector<ExpansionProgram> &getAssignmentPrograms() const { return assignment_programs_; }
+
+        /**
+         * @brief 获取命令名对应的内置命令槽位
+         *
+         * 命令名是字面量时在解析时查好；含展开时为 UNRESOLVED_BUILTIN，由执行器按展开结果查找。
+         *
+         * @return uint8_t 槽位、NO_BUILTIN 或 UNRESOLVED_BUILTIN
+         */
+        uint8_t getBuiltinSlot() const { return builtin_slot_; }
 
         /**
          * @brief 打印节点
@@ -224,8 +284,9 @@ namespace dash
     class ListNode : public Node
     {
     private:
-        std::vector<std::unique_ptr<Node>> commands_;
-        std::vector<std::string> operators_;
+        std::shared_ptr<Arena> arena_; // 语法树所在的内存池（仅根节点持有，最后销毁）
+        AstVector<std::unique_ptr<Node>> commands_;
+        AstVector<AstString> operators_;
 
     public:
         /**
@@ -233,27 +294,45 @@ namespace dash
          */
         ListNode();
 
+        /**
+         * @brief 将内存池中的根节点转移到堆上，并由它持有整个内存池
+         *
+         * 根节点本身不能放在内存池里，否则释放内存池后无法再安全地释放根节点。
+         *
+         * @param root 内存池中解析出的根节点
+         * @param arena 内存池
+         * @return std::unique_ptr<Node> 堆上的根节点
+         */
+        static std::unique_ptr<Node> adoptArena(std::unique_ptr<Node> root, std::shared_ptr<Arena> arena);
+
+        /**
+         * @brief 获取语法树所在的内存池
+         *
+         * @return const std::shared_ptr<Arena>& 内存池（非根节点为空）
+         */
+        const std::shared_ptr<Arena> &getArena() const { return arena_; }
+
         /**
          * @brief 添加命令
          *
          * @param command 命令节点
          * @param op 操作符（如 ;, &&, ||）
          */
-        void addCommand(std::unique_ptr<Node> command, const std::string &op = "");
+        void addCommand(std::unique_ptr<Node> command, std::string_view op = "");
 
         /**
          * @brief 获取命令列表
          *
-         * @return const std::vector<std::unique_ptr<Node>>& 命令列表
+         * @return const AstVector<std::unique_ptr<Node>>& 命令列表
          */
-        const std::vector<std::unique_ptr<Node>> &getCommands() const { return commands_; }
+        const AstVector<std::unique_ptr<Node>> &getCommands() const { return commands_; }
 
         /**
          * @brief 获取操作符列表
          *
-         * @return const std::vector<std::string>& 操作符列表
+         * @return const AstVector<AstString>& 操作符列表
          */
-        const std::vector<std::string> &getOperators() const { return operators_; }
+        const AstVector<AstString> &getOperators() const { return operators_; }
 
         /**
          * @brief 打印节点
@@ -318,8 +397,10 @@ namespace dash
     class ForNode : public Node
     {
     private:
-        std::string var_;
-        std::vector<std::string> words_;
+        AstString var_;
+        AstVector<AstString> words_;
+        AstVector<ExpansionProgram> word_programs_; // 每个单词的展开程序
+        AstVector<GlobPattern> word_globs_;         // 每个单词的路径名展开模式
         std::unique_ptr<Node> body_;
 
     public:
@@ -329,22 +410,38 @@ namespace dash
          * @param var 循环变量
          * @param words 单词列表
          * @param body 循环体
+         * @param quoted 每个单词是否含引号，为空表示都不含
          */
-        ForNode(const std::string &var, const std::vector<std::string> &words, std::unique_ptr<Node> body);
+        ForNode(const std::string &var, const std::vector<std::string> &words, std::unique_ptr<Node> body,
+                const std::vector<bool> &quoted = {});
 
         /**
          * @brief 获取循环变量
          *
-         * @return const std::string& 循环变量
+         * @return const AstString& 循环变量
          */
-        const std::string &getVar() const { return var_; }
+        const AstString &getVar() const { return var_; }
 
         /**
          * @brief 获取单词列表
          *
-         * @return const std::vector<std::string>& 单词列表
+         * @return const AstVector<AstString>& 单词列表
+         */
+        const AstVector<AstString> &getWords() const { return words_; }
+
+        /**
+         * @brief 获取单词的展开程序（与 getWords() 一一对应）
+         *
+         * @return const AstVector<ExpansionProgram>& 展开程序列表
          */
-        const std::vector<std::string> &getWords() const { return words_; }
+        const AstVector<ExpansionProgram> &getWordPrograms() const { return word_programs_; }
+
+        /**
+         * @brief 获取单词的路径名展开模式（与 getWords() 一一对应）
+         *
+         * @return const AstVector<GlobPattern>& 模式列表
+         */
+        const AstVector<GlobPattern> &getWordGlobs() const { return word_globs_; }
 
         /**
          * @brief 获取循环体
@@ -417,21 +514,58 @@ namespace dash
     class CaseNode : public Node
     {
     public:
+        /**
+         * @brief 含展开的模式中按引号切分出的一段
+         */
+        struct PatternPart
+        {
+            AstString text;           // 不含展开的段：模式文本，带引号的字符已转义
+            ExpansionProgram program; // 含展开的段：执行时求值
+            bool quoted;              // 展开结果在双引号内，按字面匹配
+        };
+
+        /**
+         * @brief 一个 case 模式
+         *
+         * 不含 $ 和反引号的模式在解析时编译；其余模式在执行时逐段展开，
+         * 带引号的部分转义后拼成模式文本再编译。
+         */
+        struct CasePattern
+        {
+            PatternMatcher matcher;       // 静态模式
+            AstVector<PatternPart> parts; // 动态模式的各段，为空表示静态模式
+
+            /**
+             * @brief 从单词的原样文本（含引号）编译模式
+             *
+             * @param raw 原样文本
+             */
+            explicit CasePattern(std::string_view raw);
+        };
+
         /**
          * @brief Case 项
          */
         struct CaseItem
         {
-            std::vector<std::string> patterns;
+            AstVector<AstString> patterns;  // 模式的原样文本
+            AstVector<CasePattern> matchers; // 与 patterns 一一对应
             std::unique_ptr<Node> commands;
 
             CaseItem(const std::vector<std::string> &p, std::unique_ptr<Node> c)
-                : patterns(p), commands(std::move(c)) {}
+                : patterns(p.begin(), p.end()), commands(std::move(c))
+            {
+                for (const auto &pattern : p)
+                {
+                    matchers.emplace_back(pattern);
+                }
+            }
         };
 
     private:
-        std::string word_;
-        std::vector<std::unique_ptr<CaseItem>> items_;
+        AstString word_;
+        ExpansionProgram word_program_; // 匹配词的展开程序
+        AstVector<CaseItem> items_;
 
     public:
         /**
@@ -444,7 +578,7 @@ namespace dash
         /**
          * @brief 添加 Case 项
          *
-         * @param patterns 模式列表
+         * @param patterns 模式列表（原样文本，含引号）
          * @param commands 命令
          */
         void addItem(const std::vector<std::string> &patterns, std::unique_ptr<Node> commands);
@@ -452,16 +586,23 @@ namespace dash
         /**
          * @brief 获取匹配词
          *
-         * @return const std::string& 匹配词
+         * @return const AstString& 匹配词
          */
-        const std::string &getWord() const { return word_; }
+        const AstString &getWord() const { return word_; }
+
+        /**
+         * @brief 获取匹配词的展开程序
+         *
+         * @return const ExpansionProgram& 展开程序
+         */
+        const ExpansionProgram &getWordProgram() const { return word_program_; }
 
         /**
          * @brief 获取 Case 项列表
          *
-         * @return const std::vector<std::unique_ptr<CaseItem>>& Case 项列表
+         * @return const AstVector<CaseItem>& Case 项列表
          */
-        const std::vector<std::unique_ptr<CaseItem>> &getItems() const { return items_; }
+        const AstVector<CaseItem> &getItems() const { return items_; }
 
         /**
          * @brief 打印节点
@@ -478,7 +619,7 @@ namespace dash
     {
     private:
         std::unique_ptr<Node> commands_;
-        std::vector<Redirection> redirections_;
+        AstVector<Redirection> redirections_;
 
     public:
         /**
@@ -505,9 +646,61 @@ namespace dash
         /**
          * @brief 获取重定向列表
          *
-         * @return const std::vector<Redirection>& 重定向列表
+         * @return const AstVector<Redirection>& 重定向列表
+         */
+        const AstVector<Redirection> &getRedirections() const { return redirections_; }
+
+        /**
+         * @brief 打印节点
+         *
+         * @param indent 缩进级别
+         */
+        void print(int indent = 0) const override;
+    };
+
+    /**
+     * @brief 函数定义节点
+     *
+     * 函数体以 shared_ptr 持有，并同时持有函数体所在的内存池。
+     * 执行定义时二者一起登记到执行器的函数表中，定义所在的语法树释放后函数体仍然有效；
+     * 调用函数时直接执行这棵函数体，不重新词法分析或解析。
+     */
+    class FunctionNode : public Node
+    {
+    private:
+        AstString name_;
+        std::shared_ptr<Arena> arena_;     // 函数体所在的内存池，函数体在堆上时为空
+        std::shared_ptr<const Node> body_; // 函数体
+
+    public:
+        /**
+         * @brief 构造函数
+         *
+         * @param name 函数名
+         * @param body 函数体
+         */
+        FunctionNode(std::string_view name, std::unique_ptr<Node> body);
+
+        /**
+         * @brief 获取函数名
+         *
+         * @return const AstString& 函数名
+         */
+        const AstString &getName() const { return name_; }
+
+        /**
+         * @brief 获取函数体
+         *
+         * @return const std::shared_ptr<const Node>& 函数体
+         */
+        const std::shared_ptr<const Node> &getBody() const { return body_; }
+
+        /**
+         * @brief 获取函数体所在的内存池
+         *
+         * @return const std::shared_ptr<Arena>& 内存池
          */
-        const std::vector<Redirection> &getRedirections() const { return redirections_; }
+        const std::shared_ptr<Arena> &getArena() const { return arena_; }
 
         /**
          * @brief 打印节点
@@ -10,6 +10,7 @@
 #include <vector>
 #include <memory>
 #include <ostream>
+#include <streambuf>
 #include "../dash.h"
 
 namespace dash {
@@ -143,6 +144,92 @@ private:
     void output(const std::string& message, OutputType type, bool newline);
 };
 
+/**
+ * @brief 按文件描述符缓冲的输出
+ *
+ * 与 dash 的 struct output 相同：数据先写入固定大小的缓冲区，
+ * 缓冲区满或显式 flush() 时才用 write() 写到描述符，写满整块的数据直接写出不经过缓冲区。
+ * 写入的是描述符本身而不是某个打开的文件，因此重定向用 dup2 改变描述符后，
+ * 之后写出的数据自然到达新的目标；改变描述符之前必须先 flush()。
+ *
+ * Shell 把标准输出的缓冲区装为 std::cout 的流缓冲区，内置命令仍然写 std::cout。
+ */
+class OutputBuffer : public std::streambuf {
+public:
+    static constexpr size_t BUFFER_SIZE = 8192;
+
+    /**
+     * @brief 构造函数
+     *
+     * @param fd 文件描述符
+     */
+    explicit OutputBuffer(int fd);
+
+    /**
+     * @brief 析构函数，写出剩余数据
+     */
+    ~OutputBuffer() override;
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    /**
+     * @brief 写出缓冲区中的全部数据
+     *
+     * @return bool 是否成功（写入失败时丢弃数据）
+     */
+    bool flush();
+
+    /**
+     * @brief 获取文件描述符
+     *
+     * @return int 文件描述符
+     */
+    int getFd() const { return fd_; }
+
+    /**
+     * @brief 获取 Shell 共用的标准输出缓冲区
+     *
+     * @return OutputBuffer& 标准输出缓冲区
+     */
+    static OutputBuffer& standardOutput();
+
+    /**
+     * @brief 让 std::cout 经过标准输出缓冲区
+     *
+     * std::cerr 仍绑定 std::cout，输出错误信息前会先写出标准输出中已缓冲的数据。
+     */
+    static void install();
+
+    /**
+     * @brief 命令边界
+     *
+     * 标准输出是终端时在每条命令结束后写出，保证交互时及时可见；
+     * 否则留在缓冲区中，直到缓冲区满、重定向、fork 或读取输入前才写出。
+     */
+    static void commandBoundary();
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    int sync() override;
+
+private:
+    int fd_;
+    bool terminal_;                     // 描述符是否是终端
+    char buffer_[BUFFER_SIZE];
+    std::streambuf* previous_ = nullptr; // 安装前 std::cout 的流缓冲区
+
+    /**
+     * @brief 把数据完整写到描述符，处理 EINTR 和部分写
+     *
+     * @param data 数据
+     * @param size 长度
+     * @return bool 是否成功
+     */
+    bool writeAll(const char* data, size_t size);
+};
+
 } // namespace dash
 
 #endif // DASH_OUTPUT_H 
\ No newline at end of file
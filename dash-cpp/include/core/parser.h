@@ -54,9 +54,10 @@ namespace dash
         /**
          * @brief 解析命令列表
          *
+         * @param stop_at_newline 遇到换行符时结束（不消耗），用于逐条解析脚本的顶层命令
          * @return std::unique_ptr<Node> 列表节点
          */
-        std::unique_ptr<Node> parseList();
+        std::unique_ptr<Node> parseList(bool stop_at_newline = false);
 
         /**
          * @brief 解析 if 语句
@@ -94,6 +95,23 @@ namespace dash
          */
         std::unique_ptr<Node> parseSubshell();
 
+        /**
+         * @brief 解析花括号命令组 { list; }
+         *
+         * @return std::unique_ptr<Node> 列表节点
+         */
+        std::unique_ptr<Node> parseBraceGroup();
+
+        /**
+         * @brief 解析函数定义 name() compound-command
+         *
+         * 调用时函数名已被消耗，下一个词法单元是 '('。
+         *
+         * @param name 函数名
+         * @return std::unique_ptr<Node> 函数定义节点
+         */
+        std::unique_ptr<Node> parseFunction(std::string_view name);
+
         /**
          * @brief 解析重定向
          *
@@ -114,9 +132,9 @@ namespace dash
          *
          * @param type 期望的词法单元类型
          * @param error_message 错误消息
-         * @return std::unique_ptr<Token> 词法单元
+         * @return Token 词法单元
          */
-        std::unique_ptr<Token> expectToken(TokenType type, const std::string &error_message);
+        Token expectToken(TokenType type, const std::string &error_message);
 
         /**
          * @brief 跳过换行符
@@ -139,6 +157,39 @@ namespace dash
          */
         bool isRedirectionOperator(const Token *token) const;
 
+        /**
+         * @brief 解析 if 之后的条件、分支直到 fi（elif 递归使用）
+         *
+         * @return std::unique_ptr<Node> if 节点
+         */
+        std::unique_ptr<Node> parseIfBody();
+
+        /**
+         * @brief 使用临时词法分析器解析文本，不影响当前解析状态
+         *
+         * @param text 要解析的文本
+         * @return std::unique_ptr<Node> 语法树根节点
+         */
+        std::unique_ptr<Node> parseReentrant(const std::string &text);
+
+        /**
+         * @brief 检查节点是否以 & 结束
+         *
+         * @param node 节点
+         * @return true 是后台命令
+         * @return false 不是后台命令
+         */
+        static bool isBackgroundNode(const Node *node);
+
+        /**
+         * @brief 检查词法单元是否是结束命令列表的保留字（then、fi、done 等）
+         *
+         * @param token 词法单元
+         * @return true 是结束保留字
+         * @return false 不是结束保留字
+         */
+        static bool isListTerminator(const Token *token);
+
     public:
         /**
          * @brief 构造函数
@@ -168,6 +219,30 @@ namespace dash
          */
         std::unique_ptr<Node> parseCommand(bool interactive = false);
 
+        /**
+         * @brief 解析命令替换的文本
+         *
+         * 使用独立的词法分析器并展开别名，不影响当前解析状态和最后命令记录，
+         * 因此可以在执行外层命令期间调用。
+         *
+         * @param input 命令替换中的命令文本
+         * @return std::unique_ptr<Node> 命令树根节点
+         */
+        std::unique_ptr<Node> parseSubstitution(const std::string &input);
+
+        /**
+         * @brief 从脚本的词法分析器中解析下一条顶层命令
+         *
+         * 顶层命令以换行符结束，跨行的 if/while 等复合命令整体作为一条。
+         * 解析期间临时换入 lexer，结束后换回，因此可在执行外层命令期间调用；
+         * 不展开别名。
+         *
+         * @param lexer 脚本自己的词法分析器，保存两次调用之间的读取位置
+         * @return std::unique_ptr<Node> 列表节点，脚本结束返回空指针
+         * @throws ShellException 语法错误（SYNTAX）
+         */
+        std::unique_ptr<Node> parseScriptCommand(std::unique_ptr<Lexer> &lexer);
+
         /**
          * @brief 设置输入
          *
@@ -0,0 +1,151 @@
+/**
+ * @file pattern.h
+ * @brief shell 模式匹配定义
+ */
+
+#ifndef DASH_PATTERN_H
+#define DASH_PATTERN_H
+
+#include <bitset>
+#include <cstdint>
+#include <string_view>
+#include "core/arena.h"
+
+namespace dash
+{
+
+    /**
+     * @brief 编译后的 shell 模式（*、?、[...]）
+     *
+     * 模式在构造时编译一次。常见形状（纯字面、前缀 lit*、后缀 *lit、
+     * 包含 *lit*、单独的 *）直接用字符串比较；其余模式按 '*' 切成若干定长片段，
+     * 首尾片段锚定匹配，中间片段取最左出现位置，不做回溯，匹配时间与字符串长度成线性。
+     *
+     * case 语句的每个模式和路径名展开的每个路径分量都使用这个类。
+     */
+    class PatternMatcher
+    {
+    private:
+        /**
+         * @brief 模式原子
+         */
+        struct Atom
+        {
+            enum class Kind : uint8_t
+            {
+                CHAR,  // 普通字符
+                ANY,   // ?
+                CLASS, // [...]
+                STAR   // *
+            };
+
+            Kind kind;
+            unsigned char ch; // CHAR 的字符
+            uint16_t cls;     // CLASS 在 classes_ 中的下标
+        };
+
+        /**
+         * @brief 两个 '*' 之间的定长片段 [begin, end)
+         */
+        struct Piece
+        {
+            uint32_t begin;
+            uint32_t end;
+        };
+
+        /**
+         * @brief 模式形状，决定匹配时走哪条快速路径
+         */
+        enum class Shape : uint8_t
+        {
+            LITERAL, // 不含通配符
+            PREFIX,  // lit*
+            SUFFIX,  // *lit
+            INFIX,   // *lit*
+            ANY,     // *
+            GENERAL  // 其他
+        };
+
+        Shape shape_;
+        AstString text_;         // 快速路径使用的字面文本（已去掉转义）
+        AstVector<Atom> atoms_;  // GENERAL 形状的原子序列
+        AstVector<Piece> pieces_;
+        AstVector<std::bitset<256>> classes_;
+        size_t min_length_;      // 能匹配的最短字符串长度
+        bool leading_dot_;       // 模式以字面 '.' 开头
+
+        /**
+         * @brief 编译模式
+         *
+         * @param pattern 模式文本
+         */
+        void compile(std::string_view pattern);
+
+        /**
+         * @brief 判断定长片段是否在指定位置匹配
+         */
+        bool matchPiece(const Piece &piece, std::string_view str, size_t pos) const;
+
+    public:
+        /**
+         * @brief 构造只匹配空字符串的模式
+         */
+        PatternMatcher();
+
+        /**
+         * @brief 编译模式
+         *
+         * @param pattern 模式文本
+         * @param quoted 模式带引号，所有字符都按字面匹配
+         */
+        explicit PatternMatcher(std::string_view pattern, bool quoted = false);
+
+        /**
+         * @brief 判断字符串是否匹配模式
+         *
+         * @param str 字符串
+         * @return bool 是否匹配
+         */
+        bool matches(std::string_view str) const;
+
+        /**
+         * @brief 模式是否不含通配符
+         *
+         * @return bool 是否是纯字面模式
+         */
+        bool isLiteral() const { return shape_ == Shape::LITERAL; }
+
+        /**
+         * @brief 获取字面模式的文本（仅当 isLiteral() 为 true 时有意义）
+         *
+         * @return const AstString& 去掉转义后的文本
+         */
+        const AstString &getLiteral() const { return text_; }
+
+        /**
+         * @brief 模式是否以字面 '.' 开头（路径名展开中只有这样的模式能匹配隐藏文件）
+         *
+         * @return bool 是否以 '.' 开头
+         */
+        bool hasLeadingDot() const { return leading_dot_; }
+
+        /**
+         * @brief 转义文本中的 *、?、[、] 和反斜杠，使其按字面匹配
+         *
+         * @param text 文本
+         * @return std::string 模式文本
+         */
+        static std::string escape(std::string_view text);
+
+        /**
+         * @brief 检查单词是否含未转义的通配符
+         *
+         * @param word 单词
+         * @return bool 是否含 *、? 或 [
+         */
+        static bool hasMeta(std::string_view word);
+    };
+
+} // namespace dash
+
+#endif // DASH_PATTERN_H
@@ -0,0 +1,122 @@
+/**
+ * @file script_cache.h
+ * @brief 脚本缓存定义
+ */
+
+#ifndef DASH_SCRIPT_CACHE_H
+#define DASH_SCRIPT_CACHE_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <sys/types.h>
+#include <ctime>
+
+namespace dash
+{
+
+    // 前向声明
+    class Shell;
+    class Node;
+    class Lexer;
+
+    /**
+     * @brief 按顶层命令增量解析的脚本
+     *
+     * 执行时解析一条顶层命令、执行它，再解析下一条，因此后面的语法错误
+     * 不会影响前面命令的执行。已解析的命令保存下来，再次执行时直接复用。
+     */
+    class Script
+    {
+    public:
+        /**
+         * @brief 构造函数
+         *
+         * @param shell Shell 对象指针
+         * @param text 脚本全文
+         */
+        Script(Shell *shell, const std::string &text);
+
+        /**
+         * @brief 析构函数
+         */
+        ~Script();
+
+        /**
+         * @brief 依次执行脚本中的命令，请求退出时停止
+         *
+         * @return int 最后一条命令的退出状态，空脚本为 0
+         * @throws ShellException 遇到语法错误（SYNTAX），此前的命令已执行
+         */
+        int execute();
+
+    private:
+        /**
+         * @brief 获取第 index 条顶层命令，尚未解析时从词法分析器继续解析
+         *
+         * @param index 命令序号
+         * @return const Node* 命令节点，脚本结束返回空指针
+         * @throws ShellException 语法错误（SYNTAX）
+         */
+        const Node *command(size_t index);
+
+        Shell *shell_;
+        std::unique_ptr<Lexer> lexer_;               // 解析位置；整个脚本解析完或出错后释放
+        std::vector<std::unique_ptr<Node>> commands_; // 已解析的顶层命令
+        std::string error_;                           // 解析停止处的语法错误，再次执行时原样报告
+    };
+
+    /**
+     * @brief 脚本缓存
+     *
+     * 以 (路径, 修改时间, 大小, inode) 为键在会话内缓存脚本。
+     * 同一个文件被多次 source 时，只要文件未变化就复用已解析的命令。
+     */
+    class ScriptCache
+    {
+    public:
+        /**
+         * @brief 构造函数
+         *
+         * @param shell Shell 对象指针
+         */
+        explicit ScriptCache(Shell *shell);
+
+        /**
+         * @brief 加载脚本
+         *
+         * 文件未变化时返回缓存的脚本，否则读取整个文件；命令在执行时才解析。
+         *
+         * @param path 脚本路径
+         * @return std::shared_ptr<Script> 脚本
+         * @throws ShellException 文件无法读取（IO）
+         */
+        std::shared_ptr<Script> load(const std::string &path);
+
+        /**
+         * @brief 清空缓存
+         */
+        void clear() { entries_.clear(); }
+
+    private:
+        /**
+         * @brief 缓存条目
+         */
+        struct Entry
+        {
+            time_t mtime;                  // 修改时间（秒）
+            long mtime_nsec;               // 修改时间（纳秒部分）
+            off_t size;                    // 文件大小
+            ino_t inode;                   // inode 编号
+            dev_t device;                  // 所在设备
+            std::shared_ptr<Script> script; // 脚本及其已解析的命令
+        };
+
+        Shell *shell_;
+        std::unordered_map<std::string, Entry> entries_;
+    };
+
+} // namespace dash
+
+#endif // DASH_SCRIPT_CACHE_H
@@ -20,10 +20,10 @@ namespace dash
     class Executor;
     class VariableManager;
     class JobControl;
-    class PipeNode;
-    class BGJobAdapter; // 添加适配器的前向声明
     class History;  // 添加History类前向声明
     class AliasManager; // 添加AliasManager类前向声明
+    class ScriptCache;
+    class EventLoop;
 
     /**
      * @brief Shell 类
@@ -38,9 +38,10 @@ namespace dash
         std::unique_ptr<Parser> parser_;
         std::unique_ptr<Executor> executor_;
         std::unique_ptr<JobControl> job_control_;
-        std::unique_ptr<BGJobAdapter> bg_job_adapter_; // 添加后台任务控制适配器
         std::unique_ptr<History> history_;  // 添加History成员变量
         std::unique_ptr<AliasManager> alias_manager_; // 添加AliasManager成员变量
+        std::unique_ptr<ScriptCache> script_cache_;    // 已解析脚本的语法树缓存
+        std::unique_ptr<EventLoop> event_loop_;        // 交互模式的事件循环
 
         bool interactive_;
         bool exit_requested_;
@@ -89,12 +90,16 @@ namespace dash
         void displayPrompt();
 
         /**
-         * @brief 执行管道
+         * @brief 处理事件循环分发的信号事件
          *
-         * @param node 管道节点
-         * @return int 执行结果状态码
+         * @param signo SIGINT 或 SIGCHLD
          */
-        int execute_pipeline(const PipeNode *node);
+        void handleEvent(int signo);
+
+        /**
+         * @brief 回收子进程并通知已完成的作业
+         */
+        void reapChildren();
 
     public:
         // 信号处理相关
@@ -162,13 +167,6 @@ namespace dash
          */
         JobControl *getJobControl() const;
 
-        /**
-         * @brief 获取后台任务控制适配器
-         *
-         * @return BGJobAdapter* 后台任务控制适配器指针
-         */
-        BGJobAdapter *getBGJobAdapter() const;
-
         /**
          * @brief 获取历史记录管理器
          *
@@ -183,6 +181,20 @@ namespace dash
          */
         AliasManager *getAliasManager() const;
 
+        /**
+         * @brief 获取脚本语法树缓存
+         *
+         * @return ScriptCache* 脚本语法树缓存指针
+         */
+        ScriptCache *getScriptCache() const;
+
+        /**
+         * @brief 获取事件循环
+         *
+         * @return EventLoop* 事件循环指针，只在交互模式下打开
+         */
+        EventLoop *getEventLoop() const;
+
         /**
          * @brief 是否是交互式模式
          *
@@ -197,16 +209,14 @@ namespace dash
          * @return int 退出状态码
          */
         int getExitStatus() const;
-        
+
         /**
-         * @brief 执行后台命令
+         * @brief 是否已请求退出
          *
-         * @param command 命令字符串
-         * @param args 参数数组
-         * @return int 执行结果状态码
+         * @return true 已调用 exit
+         * @return false 未请求退出
          */
-        int executeBackground(const std::string &command, std::vector<std::string> &args);
-
+        bool isExitRequested() const { return exit_requested_; }
     };
 
 } // namespace dash
@@ -51,7 +51,8 @@ enum class NodeType
     FOR,     // for 循环
     WHILE,   // while/until 循环
     CASE,    // case 语句
-    SUBSHELL // 子 shell
+    SUBSHELL, // 子 shell
+    FUNCTION  // 函数定义
 };
 
 // 词法单元类型（仅供内部使用，优先使用core/lexer.h中的定义）
@@ -205,12 +205,14 @@ namespace dash
         JobStatus getStatus() const { return status_; }
 
         /**
-         * @brief 更新作业状态
+         * @brief 根据各进程已记录的完成和停止标志同步作业状态
+         *
+         * 不调用 waitpid，子进程由 JobControl::updateStatus() 统一回收。
          *
          * @return true 状态已更改
          * @return false 状态未更改
          */
-        bool updateStatus();
+        bool syncStatus();
 
         /**
          * @brief 将作业放入前台
@@ -246,13 +248,27 @@ namespace dash
 
     /**
      * @brief 作业控制类
+     *
+     * 所有作业放在同一张作业表中：作业 n 位于连续槽位数组的第 n-1 项，
+     * 空出的作业号放入空闲表，新作业优先复用最小的作业号；
+     * 另有进程 ID 索引用于回收子进程时定位所属作业。
      */
     class JobControl
     {
     private:
+        /**
+         * @brief 进程 ID 索引项
+         */
+        struct ProcessRef
+        {
+            Job *job;
+            Process *process;
+        };
+
         Shell *shell_;
-        std::unordered_map<int, std::unique_ptr<Job>> jobs_;
-        int next_job_id_;
+        std::vector<std::unique_ptr<Job>> jobs_;          // 作业槽位，作业 n 在下标 n-1，空槽位为 nullptr
+        std::vector<int> free_ids_;                       // 空出的作业号，按最小堆组织
+        std::unordered_map<pid_t, ProcessRef> pid_index_; // 进程 ID 到所属作业和进程的索引
         bool enabled_;
         int terminal_fd_;
         pid_t shell_pgid_;
@@ -273,14 +289,6 @@ namespace dash
         JobControl(const JobControl&) = delete;
         JobControl& operator=(const JobControl&) = delete;
 
-        /**
-         * @brief 查找作业
-         *
-         * @param id 作业 ID
-         * @return Job* 作业指针，如果找不到则返回 nullptr
-         */
-        Job *findJob(int id) const;
-
         /**
          * @brief 查找当前作业
          * 
@@ -288,7 +296,55 @@ namespace dash
          */
         Job *findCurrentJob() const;
 
+        /**
+         * @brief 查找上一个作业（当前作业之外作业号最大的作业）
+         *
+         * @return Job* 作业指针，如果没有则返回 nullptr
+         */
+        Job *findPreviousJob() const;
+
+        /**
+         * @brief 按进程 ID 查找进程
+         *
+         * @param pid 进程 ID
+         * @return ProcessRef 所属作业和进程，找不到时均为 nullptr
+         */
+        ProcessRef findProcess(pid_t pid) const;
+
+        /**
+         * @brief 从进程 ID 索引中移除作业的所有进程
+         *
+         * @param job 作业指针
+         */
+        void unindexJob(const Job *job);
+
+        /**
+         * @brief 释放作业的槽位，作业号放回空闲表
+         *
+         * @param job_id 作业 ID
+         */
+        void releaseJob(int job_id);
+
+        /**
+         * @brief 结束对作业的等待：已完成的作业不再通知，直接释放
+         *
+         * @param job 作业指针
+         */
+        void finishWait(Job *job);
+
+        /**
+         * @brief 将所有未完成的进程记为已完成
+         *
+         * 只在内核报告 shell 已没有子进程时调用，作业表中的进程都是 shell 的子进程。
+         */
+        void markAllCompleted();
+
     public:
+        /**
+         * @brief 等待被 SIGINT 中断时的返回值
+         */
+        static constexpr int WAIT_INTERRUPTED = -2;
+
         /**
          * @brief 构造函数
          *
@@ -323,6 +379,34 @@ namespace dash
          */
         int addJob(const std::string &command, pid_t pgid);
 
+        /**
+         * @brief 查找作业
+         *
+         * @param id 作业 ID
+         * @return Job* 作业指针，如果找不到则返回 nullptr
+         */
+        Job *findJob(int id) const;
+
+        /**
+         * @brief 按进程 ID 查找作业
+         *
+         * @param pid 作业中任一进程的 ID
+         * @return Job* 作业指针，如果找不到则返回 nullptr
+         */
+        Job *findJobByPid(pid_t pid) const;
+
+        /**
+         * @brief 解析作业规格
+         *
+         * 支持 %n、%% 或 %+（当前作业）、%-（上一个作业）、
+         * %前缀（命令以前缀开头）和 %?子串（命令包含子串），
+         * 开头的 % 可以省略；空串表示当前作业。
+         *
+         * @param spec 作业规格
+         * @return Job* 作业指针，如果找不到或有歧义则返回 nullptr
+         */
+        Job *resolveJobSpec(const std::string &spec) const;
+
         /**
          * @brief 添加进程到作业
          *
@@ -342,13 +426,60 @@ namespace dash
         void updateStatus(pid_t wait_for_pid);
 
         /**
-         * @brief 等待作业
+         * @brief 记录已知已退出的进程
+         *
+         * 用于 pidfd 报告的退出：进程已被其他地方回收时 waitpid 取不到状态，
+         * 只能记为已完成。
+         *
+         * @param pid 进程 ID
+         */
+        void processExited(pid_t pid);
+
+        /**
+         * @brief 阻塞到有子进程状态变化为止，然后更新作业表
+         *
+         * 所有等待都建立在这一个原语上，不逐个作业轮询：交互模式下在事件循环的
+         * epoll 集合上等待（signalfd 和 pidfd，Ctrl+C 可以打断），其他情况下
+         * 阻塞在 waitid(WNOWAIT) 上，醒来后统一由 updateStatus() 回收。
+         *
+         * @return int 1 有状态变化；0 被 SIGINT 中断；-1 已没有子进程，剩余进程都记为已完成
+         */
+        int waitForChange();
+
+        /**
+         * @brief 等待作业完成或停止
          *
          * @param job_id 作业 ID
-         * @return int 作业的退出状态
+         * @return int 最后一个进程的退出状态，作业不存在时返回 -1，被中断时返回 WAIT_INTERRUPTED
          */
         int waitForJob(int job_id);
 
+        /**
+         * @brief 等待作业中的一个进程结束
+         *
+         * @param pid 进程 ID
+         * @return int 进程的退出状态，不是作业中的进程时返回 127，被中断时返回 WAIT_INTERRUPTED
+         */
+        int waitForProcess(pid_t pid);
+
+        /**
+         * @brief 等待一组作业中任意一个完成
+         *
+         * 已完成但尚未等待过的作业立即返回。
+         *
+         * @param job_ids 作业 ID 列表，为空时等待任意作业
+         * @param finished 输出：完成的作业 ID
+         * @return int 该作业的退出状态，没有可等待的作业时返回 127，被中断时返回 WAIT_INTERRUPTED
+         */
+        int waitForAnyJob(const std::vector<int> &job_ids, int &finished);
+
+        /**
+         * @brief 等待所有运行中的作业完成，已停止的作业不等待
+         *
+         * @return int 0，被中断时返回 WAIT_INTERRUPTED
+         */
+        int waitForAllJobs();
+
         /**
          * @brief 将作业放入前台
          *
@@ -390,11 +521,11 @@ namespace dash
         void cleanupJobs();
 
         /**
-         * @brief 获取所有作业
+         * @brief 获取作业表
          * 
-         * @return const std::unordered_map<int, std::unique_ptr<Job>>& 所有作业的引用
+         * @return const std::vector<std::unique_ptr<Job>>& 按作业号排列的槽位，空槽位为 nullptr
          */
-        const std::unordered_map<int, std::unique_ptr<Job>>& getJobs() const { return jobs_; }
+        const std::vector<std::unique_ptr<Job>>& getJobs() const { return jobs_; }
 
         /**
          * @brief 获取终端文件描述符
@@ -10,6 +10,7 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <sys/types.h>
 #include "../dash.h"
 
 namespace dash {
@@ -23,8 +24,68 @@ struct HistoryEntry {
     time_t timestamp;       // 时间戳
 };
 
+/**
+ * @brief 历史记录的只读视图
+ *
+ * 直接引用 History 的环形缓冲区，不复制条目；History 被修改后视图失效。
+ */
+class HistoryView {
+public:
+    /**
+     * @brief 按逻辑顺序（从旧到新）遍历的迭代器
+     */
+    class iterator {
+    public:
+        iterator(const HistoryView* view, size_t pos) : view_(view), pos_(pos) {}
+        const HistoryEntry& operator*() const { return (*view_)[pos_]; }
+        const HistoryEntry* operator->() const { return &(*view_)[pos_]; }
+        iterator& operator++() { ++pos_; return *this; }
+        bool operator==(const iterator& other) const { return pos_ == other.pos_; }
+        bool operator!=(const iterator& other) const { return pos_ != other.pos_; }
+
+    private:
+        const HistoryView* view_;
+        size_t pos_;
+    };
+
+    /**
+     * @brief 构造函数
+     *
+     * @param ring 环形缓冲区
+     * @param start 第一个条目在缓冲区中的位置
+     * @param size 条目数量
+     */
+    HistoryView(const std::vector<HistoryEntry>& ring, size_t start, size_t size)
+        : ring_(&ring), start_(start), size_(size) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief 按逻辑位置访问条目
+     *
+     * @param i 逻辑位置（0 为最旧）
+     * @return const HistoryEntry& 条目
+     */
+    const HistoryEntry& operator[](size_t i) const {
+        size_t pos = start_ + i;
+        return (*ring_)[pos < ring_->size() ? pos : pos - ring_->size()];
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size_); }
+
+private:
+    const std::vector<HistoryEntry>* ring_;
+    size_t start_;
+    size_t size_;
+};
+
 /**
  * @brief 历史记录管理类
+ *
+ * 条目存放在容量为 maxSize 的环形缓冲区中：未满时追加，满后覆盖最旧的条目，
+ * 添加一条命令的代价与历史记录长度无关。条目的编号连续，按编号查找是 O(1)。
  */
 class History {
 public:
@@ -60,16 +121,25 @@ public:
      * @brief 获取最近的N条历史记录
      * 
      * @param count 要获取的历史记录数量
-     * @return std::vector<HistoryEntry> 历史记录列表
+     * @return HistoryView 历史记录视图
      */
-    std::vector<HistoryEntry> getRecentCommands(size_t count) const;
+    HistoryView getRecentCommands(size_t count) const;
 
     /**
      * @brief 获取所有历史记录
      * 
-     * @return const std::vector<HistoryEntry>& 历史记录列表
+     * @return HistoryView 历史记录视图
+     */
+    HistoryView getAllCommands() const;
+
+    /**
+     * @brief 设置最大历史记录数量
+     *
+     * 缩小时只保留最近的条目。
+     *
+     * @param maxSize 最大历史记录数量
      */
-    const std::vector<HistoryEntry>& getAllCommands() const;
+    void setMaxSize(size_t maxSize);
 
     /**
      * @brief 清除历史记录
@@ -92,6 +162,22 @@ public:
      */
     bool saveToFile(const std::string& filename) const;
 
+    /**
+     * @brief 加载历史记录文件，并把它作为追加日志打开
+     *
+     * 之后每条新命令只用 O_APPEND 追加一行，不再重写整个文件；
+     * 文件中的行数超过 maxSize 的两倍时才压缩为最近的 maxSize 条。
+     *
+     * @param filename 历史记录文件名
+     * @return bool 是否成功打开
+     */
+    bool openJournal(const std::string& filename);
+
+    /**
+     * @brief 关闭追加日志
+     */
+    void closeJournal();
+
     /**
      * @brief 搜索历史记录
      * 
@@ -102,9 +188,67 @@ public:
 
 private:
     Shell& shell_;                  // Shell实例引用
-    std::vector<HistoryEntry> history_;  // 历史记录列表
+    std::vector<HistoryEntry> ring_; // 环形缓冲区，未满时按顺序存放
+    size_t head_;                   // 最旧条目在缓冲区中的位置
     size_t maxSize_;                // 最大历史记录数量
     int nextIndex_;                 // 下一条历史记录的索引
+    int journalFd_;                 // 追加日志的文件描述符，未打开时为 -1
+    std::string journalPath_;       // 追加日志的文件名
+    size_t journalLines_;           // 追加日志中的行数
+    off_t journalOffset_;           // 日志中已由内存条目表示的前缀长度，之后的内容可能来自其他 shell
+    int journalBase_;               // 编号小于它的内存条目就是该前缀中的条目
+
+    /**
+     * @brief 把条目格式化为一行 "时间戳 命令\n"，追加到 out
+     *
+     * @param entry 历史记录条目
+     * @param out 输出缓冲区
+     */
+    static void formatEntry(const HistoryEntry& entry, std::string& out);
+
+    /**
+     * @brief 把条目追加到日志，必要时压缩
+     *
+     * @param entry 历史记录条目
+     */
+    void appendToJournal(const HistoryEntry& entry);
+
+    /**
+     * @brief 对日志加锁，并确认描述符仍指向当前的日志文件
+     *
+     * 追加用共享锁，压缩和清空用独占锁。其他 shell 压缩后日志被新文件替换，
+     * 此时重新打开并对新文件加锁。
+     *
+     * @param operation LOCK_SH 或 LOCK_EX
+     * @return bool 是否成功
+     */
+    bool lockJournal(int operation);
+
+    /**
+     * @brief 压缩日志，只保留最近的 maxSize 条
+     *
+     * 在独占锁下读出 journalOffset_ 之后由本 shell 和其他 shell 追加的内容，
+     * 接在内存中的前缀条目之后一起写入临时文件，再 rename 替换原文件，
+     * 压缩中途失败不会损坏原文件。
+     *
+     * @param mergeTail 是否合并日志尾部；为 false 时只写入内存中的条目
+     * @return bool 是否成功
+     */
+    bool compactJournal(bool mergeTail = true);
+
+    /**
+     * @brief 存入一个条目，缓冲区已满时覆盖最旧的条目
+     *
+     * @param entry 历史记录条目
+     */
+    void push(HistoryEntry entry);
+
+    /**
+     * @brief 获取最新的条目
+     *
+     * @return const HistoryEntry& 最新的条目（缓冲区不能为空）
+     */
+    const HistoryEntry& back() const;
 };
 
 } // namespace dash
@@ -0,0 +1,129 @@
+/**
+ * @file expansion_program.h
+ * @brief 单词展开程序定义
+ */
+
+#ifndef DASH_EXPANSION_PROGRAM_H
+#define DASH_EXPANSION_PROGRAM_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include "core/arena.h"
+#include "core/arithmetic.h"
+#include "variable/symbol_table.h"
+
+namespace dash
+{
+
+    class ExpansionProgram;
+
+    /**
+     * @brief 展开程序中的一段
+     */
+    struct ExpansionSegment
+    {
+        /**
+         * @brief 段类型
+         */
+        enum class Kind
+        {
+            LITERAL,  // 字面文本
+            VARIABLE,  // 变量引用 $NAME、${NAME}、$?
+            COMMAND,   // 命令替换 $(cmd) 或 `cmd`
+            ARITHMETIC // 算术展开 $((expr))
+        };
+
+        Kind kind;
+        AstString text;           // 字面文本、变量名、命令文本或算术表达式
+        mutable VarHandle handle; // 变量段第一次求值时解析出的符号表句柄
+        mutable std::shared_ptr<const ArithmeticProgram> arithmetic; // 算术段编译后的表达式
+
+        // 算术表达式含命令替换或复杂的 ${...} 时，先按此程序展开再编译；
+        // arithmetic 是上次展开结果 expanded 编译出的表达式，展开结果不变时直接复用
+        std::shared_ptr<const ExpansionProgram> expansion;
+        mutable std::string expanded;
+
+        ExpansionSegment(Kind k, std::string_view t)
+            : kind(k), text(t), handle(INVALID_VAR_HANDLE) {}
+    };
+
+    /**
+     * @brief 单词展开程序
+     *
+     * 把一个单词预先拆分为字面文本、变量引用、命令替换和算术展开组成的段序列。
+     * 解析器在构建语法树时编译一次，之后每次执行只需按顺序求值各段，
+     * 不再重新扫描单词中的 $ 和反引号。
+     */
+    class ExpansionProgram
+    {
+    private:
+        AstVector<ExpansionSegment> segments_;
+        bool literal_; // 不含任何展开，求值结果就是单词本身
+
+        /**
+         * @brief 追加字面文本，与前一个字面段合并
+         *
+         * @param text 字面文本
+         */
+        void appendLiteral(std::string_view text);
+
+        /**
+         * @brief 查找算术展开结尾 )) 的位置
+         *
+         * @param str 单词
+         * @param start $(( 之后的位置
+         * @return size_t 第一个 ) 的位置，没有配对时为 npos
+         */
+        static size_t findArithmeticEnd(std::string_view str, size_t start);
+
+        /**
+         * @brief 算术表达式是否需要先展开再编译
+         *
+         * 编译器自己处理 $name、${name} 和特殊参数；命令替换、反引号
+         * 和带运算符的 ${...} 需要先展开。
+         *
+         * @param expression 表达式文本
+         * @return bool 是否需要先展开
+         */
+        static bool needsExpansion(std::string_view expression);
+
+    public:
+        /**
+         * @brief 构造空程序
+         */
+        ExpansionProgram();
+
+        /**
+         * @brief 编译单词
+         *
+         * @param word 单词
+         */
+        explicit ExpansionProgram(std::string_view word);
+
+        /**
+         * @brief 是否不含任何展开
+         *
+         * @return true 只有字面文本
+         * @return false 含有变量引用或命令替换
+         */
+        bool isLiteral() const { return literal_; }
+
+        /**
+         * @brief 获取字面程序的文本
+         *
+         * @return std::string_view 单词本身（仅当 isLiteral() 为 true 时有意义）
+         */
+        std::string_view getLiteral() const;
+
+        /**
+         * @brief 获取段列表
+         *
+         * @return const AstVector<ExpansionSegment>& 段列表
+         */
+        const AstVector<ExpansionSegment> &getSegments() const { return segments_; }
+    };
+
+} // namespace dash
+
+#endif // DASH_EXPANSION_PROGRAM_H
@@ -25,11 +25,30 @@ namespace dash {
         static void resetColors() ;
         //设置显示模式
         static void setPromptMode(unsigned int mode) ;
+        //当前工作目录已改变，下次渲染时重新读取 cwd
+        static void invalidateCwd() ;
 
     private:
         // 静态变量用于存储当前的显示模式
         static int promptMode;
+
+        // 用户名、主机名和 uid 在会话内不变，只读取一次
+        static bool identityLoaded;
+        static std::string user;
+        static std::string hostname;
+        static bool isRoot;
+        // 工作目录只在 cd 后重新读取
+        static bool cwdValid;
+        static std::string cwd;
+        // 渲染结果，组成部分或显示模式改变时失效
+        static bool rawValid;
+        static std::string rawPrompt;
+        static bool formattedValid;
+        static std::string formattedPrompt;
+
+        static void loadIdentity() ;
+        static const std::string &currentCwd() ;
     };
 }
 
-#endif // GETPROMPTINFO_H
\ No newline at end of file
+#endif // GETPROMPTINFO_H
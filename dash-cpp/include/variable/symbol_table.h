@@ -0,0 +1,143 @@
+/**
+ * @file symbol_table.h
+ * @brief 变量符号表定义
+ */
+
+#ifndef DASH_SYMBOL_TABLE_H
+#define DASH_SYMBOL_TABLE_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "variable/variable.h"
+
+namespace dash
+{
+
+    /**
+     * @brief 变量句柄
+     *
+     * 变量名在符号表中驻留后得到的编号。句柄在符号表的整个生命周期内有效，
+     * 变量被 unset 后句柄仍然指向同一个槽位，因此调用者可以缓存句柄。
+     */
+    using VarHandle = uint32_t;
+
+    /**
+     * @brief 无效句柄
+     */
+    constexpr VarHandle INVALID_VAR_HANDLE = UINT32_MAX;
+
+    /**
+     * @brief 变量符号表
+     *
+     * 变量对象按句柄连续存放在数组中；名字到句柄的映射使用开放寻址（线性探测）
+     * 的哈希索引，查找时直接对 string_view 求哈希，不构造临时字符串。
+     * 条目只增不删，unset 只把槽位标记为未定义。
+     */
+    class SymbolTable
+    {
+    private:
+        /**
+         * @brief 符号表条目
+         */
+        struct Entry
+        {
+            Variable variable; // 变量（名字即驻留的名字）
+            uint32_t hash;     // 名字的哈希值
+            bool defined;      // 变量当前是否已定义
+        };
+
+        /**
+         * @brief 哈希索引槽位
+         */
+        struct Slot
+        {
+            uint32_t hash;
+            VarHandle handle; // INVALID_VAR_HANDLE 表示空槽
+        };
+
+        std::vector<Entry> entries_;
+        std::vector<Slot> slots_; // 大小为 2 的幂，装载因子不超过 1/2
+
+        /**
+         * @brief 计算名字的哈希值（FNV-1a）
+         *
+         * @param name 变量名
+         * @return uint32_t 哈希值
+         */
+        static uint32_t hashName(std::string_view name);
+
+        /**
+         * @brief 扩大哈希索引并重新插入所有句柄
+         */
+        void grow();
+
+    public:
+        /**
+         * @brief 构造函数
+         */
+        SymbolTable();
+
+        /**
+         * @brief 查找变量名的句柄
+         *
+         * @param name 变量名
+         * @return VarHandle 句柄，名字从未驻留时返回 INVALID_VAR_HANDLE
+         */
+        VarHandle find(std::string_view name) const;
+
+        /**
+         * @brief 驻留变量名，返回句柄（名字不存在时创建一个未定义的条目）
+         *
+         * @param name 变量名
+         * @return VarHandle 句柄
+         */
+        VarHandle intern(std::string_view name);
+
+        /**
+         * @brief 获取句柄对应的变量
+         *
+         * @param handle 句柄
+         * @return Variable& 变量
+         */
+        Variable &at(VarHandle handle) { return entries_[handle].variable; }
+
+        /**
+         * @brief 获取句柄对应的变量
+         *
+         * @param handle 句柄
+         * @return const Variable& 变量
+         */
+        const Variable &at(VarHandle handle) const { return entries_[handle].variable; }
+
+        /**
+         * @brief 句柄对应的变量是否已定义
+         *
+         * @param handle 句柄
+         * @return true 已定义
+         * @return false 未定义或句柄无效
+         */
+        bool isDefined(VarHandle handle) const
+        {
+            return handle < entries_.size() && entries_[handle].defined;
+        }
+
+        /**
+         * @brief 设置句柄对应的变量是否已定义
+         *
+         * @param handle 句柄
+         * @param defined 是否已定义
+         */
+        void setDefined(VarHandle handle, bool defined) { entries_[handle].defined = defined; }
+
+        /**
+         * @brief 获取句柄数量（句柄取值范围是 [0, size())）
+         *
+         * @return size_t 句柄数量
+         */
+        size_t size() const { return entries_.size(); }
+    };
+
+} // namespace dash
+
+#endif // DASH_SYMBOL_TABLE_H
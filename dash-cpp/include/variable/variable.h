@@ -0,0 +1,117 @@
+/**
+ * @file variable.h
+ * @brief 变量类定义
+ */
+
+#ifndef DASH_VARIABLE_H
+#define DASH_VARIABLE_H
+
+#include <string>
+#include <string_view>
+
+namespace dash
+{
+
+    /**
+     * @brief 变量类
+     */
+    class Variable
+    {
+    public:
+        /**
+         * @brief 变量标志
+         */
+        enum Flags
+        {
+            VAR_NONE = 0,
+            VAR_EXPORT = 1,         // 导出到环境变量
+            VAR_READONLY = 2,       // 只读变量
+            VAR_SPECIAL = 4,        // 特殊变量（如 $?, $#, $0 等）
+            VAR_UPDATE_ON_READ = 8  // 在读取时更新值
+        };
+
+    private:
+        std::string name_;
+        mutable std::string value_; // 读时更新的变量在 getValue() 中刷新
+        int flags_;
+        // 函数指针，用于更新变量值
+        std::string (*updateValueFunc_)();
+
+    public:
+        /**
+         * @brief 构造函数
+         *
+         * @param name 变量名
+         * @param value 变量值
+         * @param flags 变量标志
+         */
+        Variable(const std::string &name, const std::string &value, int flags = VAR_NONE);
+
+        /**
+         * @brief 获取变量名
+         *
+         * @return const std::string& 变量名
+         */
+        const std::string &getName() const { return name_; }
+
+        /**
+         * @brief 获取变量值
+         *
+         * @return const std::string& 变量值
+         */
+        const std::string &getValue() const {
+            //修改：如果变量是在读时需要更新的，则更新值
+            if (hasFlag(VAR_UPDATE_ON_READ) && updateValueFunc_) {
+                value_ = updateValueFunc_();
+            }
+            return value_; 
+        }
+
+        /**
+         * @brief 设置更新值函数
+         * 
+         */
+        void setUpdateValueFunc(std::string (*func)()) {updateValueFunc_ = func; }
+        /**
+         * @brief 设置变量值
+         *
+         * @param value 变量值
+         * @return true 设置成功
+         * @return false 设置失败（如变量是只读的）
+         */
+        bool setValue(std::string_view value);
+
+        /**
+         * @brief 获取变量标志
+         *
+         * @return int 变量标志
+         */
+        int getFlags() const { return flags_; }
+
+        /**
+         * @brief 设置变量标志
+         *
+         * @param flags 变量标志
+         */
+        void setFlags(int flags) { flags_ = flags; }
+
+        /**
+         * @brief 检查变量是否有指定标志
+         *
+         * @param flag 要检查的标志
+         * @return true 有指定标志
+         * @return false 没有指定标志
+         */
+        bool hasFlag(int flag) const { return (flags_ & flag) != 0; }
+
+        /**
+         * @brief 添加变量标志
+         *
+         * @param flag 要添加的标志
+         */
+        void addFlag(int flag) { flags_ |= flag; }
+    };
+
+} // namespace dash
+
+#endif // DASH_VARIABLE_H
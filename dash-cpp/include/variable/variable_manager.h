@@ -7,9 +7,11 @@
 #define DASH_VARIABLE_MANAGER_H
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 #include <memory>
+#include "variable/variable.h"
+#include "variable/symbol_table.h"
+#include "variable/expansion_program.h"
 
 namespace dash
 {
@@ -18,123 +20,104 @@ namespace dash
     class Shell;
 
     /**
-     * @brief 变量类
+     * @brief 特殊参数的固定句柄
+     *
+     * 这些名字在符号表创建时最先驻留，句柄固定不变。
      */
-    class Variable
+    enum SpecialParam : VarHandle
     {
-    public:
-        /**
-         * @brief 变量标志
-         */
-        enum Flags
-        {
-            VAR_NONE = 0,
-            VAR_EXPORT = 1,         // 导出到环境变量
-            VAR_READONLY = 2,       // 只读变量
-            VAR_SPECIAL = 4,        // 特殊变量（如 $?, $#, $0 等）
-            VAR_UPDATE_ON_READ = 8  // 在读取时更新值
-        };
+        SPECIAL_STATUS = 0, // $?
+        SPECIAL_PID = 1,    // $$
+        SPECIAL_ARGC = 2,   // $#
+        SPECIAL_ARG0 = 3    // $0
+    };
 
+    /**
+     * @brief 位置参数 $1、$2 … 的句柄起点
+     *
+     * 位置参数不进入符号表，$n 的句柄是 POSITIONAL_HANDLE_BASE + n - 1。
+     */
+    constexpr VarHandle POSITIONAL_HANDLE_BASE = 0x80000000u;
+
+    /**
+     * @brief 变量管理器类
+     *
+     * 负责管理 shell 变量和环境变量。
+     */
+    class VariableManager
+    {
     private:
-        std::string name_;
-        std::string value_;
-        int flags_;
-        // 函数指针，用于更新变量值
-        std::string (*updateValueFunc_)();
+        Shell *shell_;
+        mutable SymbolTable symbols_; // 驻留新名字不改变任何变量的值，const 查找也可以驻留
+        bool initialized_; // 初始化完成前 Shell 的其他组件尚未构造
+        VarHandle path_handle_;
+        std::vector<std::string> positional_; // 位置参数 $1 $2 …
+
+        // 导出变量集合的版本号；集合或其中任一值改变时递增
+        uint64_t export_generation_;
+
+        // 按需重建的 envp 快照：所有 "NAME=value" 连续存放在 envp_storage_ 中
+        mutable uint64_t envp_generation_;
+        mutable std::vector<char> envp_storage_;
+        mutable std::vector<char *> envp_;
 
-    public:
         /**
-         * @brief 构造函数
+         * @brief 按句柄设置变量
          *
-         * @param name 变量名
+         * @param handle 句柄
          * @param value 变量值
          * @param flags 变量标志
+         * @return true 设置成功
+         * @return false 设置失败（如变量是只读的）
          */
-        Variable(const std::string &name, const std::string &value, int flags = VAR_NONE);
+        bool setByHandle(VarHandle handle, std::string_view value, int flags);
 
         /**
-         * @brief 获取变量名
+         * @brief 更新数值型特殊参数（不分配内存）
          *
-         * @return const std::string& 变量名
+         * @param handle 特殊参数句柄
+         * @param value 数值
          */
-        const std::string &getName() const { return name_; }
+        void setSpecialNumber(VarHandle handle, long value);
 
         /**
-         * @brief 获取变量值
+         * @brief 判断名字是否是位置参数 $1 $2 …
          *
-         * @return const std::string& 变量值
+         * @param name 变量名
+         * @param index 输出：位置参数在 positional_ 中的下标
+         * @return bool 是否是位置参数
          */
-        const std::string &getValue() { 
-            //修改：如果变量是在读时需要更新的，则更新值
-            if (hasFlag(VAR_UPDATE_ON_READ)) {
-                value_ = updateValueFunc_();
-            }
-            return value_; 
-        }
+        static bool positionalIndex(std::string_view name, size_t &index);
 
         /**
-         * @brief 设置更新值函数
+         * @brief 执行命令替换并返回输出
          * 
+         * @param cmd 要执行的命令
+         * @return std::string 命令的输出（已去除尾部换行符）
          */
-        void setUpdateValueFunc(std::string (*func)()) {updateValueFunc_ = func; }
-        /**
-         * @brief 设置变量值
-         *
-         * @param value 变量值
-         * @return true 设置成功
-         * @return false 设置失败（如变量是只读的）
-         */
-        bool setValue(const std::string &value);
+        std::string executeCommandSubstitution(const std::string &cmd) const;
 
         /**
-         * @brief 获取变量标志
+         * @brief 读取描述符中的全部数据，追加到字符串末尾
          *
-         * @return int 变量标志
-         */
-        int getFlags() const { return flags_; }
-
-        /**
-         * @brief 设置变量标志
+         * 数据直接读入字符串的空闲空间，读取大小自适应增长，保留 NUL 字节。
          *
-         * @param flags 变量标志
+         * @param fd 文件描述符
+         * @param output 输出字符串
          */
-        void setFlags(int flags) { flags_ = flags; }
+        static void readAll(int fd, std::string &output);
 
         /**
-         * @brief 检查变量是否有指定标志
+         * @brief 原地去除尾部的所有换行符
          *
-         * @param flag 要检查的标志
-         * @return true 有指定标志
-         * @return false 没有指定标志
+         * @param output 输出字符串
          */
-        bool hasFlag(int flag) const { return (flags_ & flag) != 0; }
+        static void trimTrailingNewlines(std::string &output);
 
         /**
-         * @brief 添加变量标志
-         *
-         * @param flag 要添加的标志
+         * @brief 使命令路径哈希表失效（PATH 改变时调用）
          */
-        void addFlag(int flag) { flags_ |= flag; }
-    };
-
-    /**
-     * @brief 变量管理器类
-     *
-     * 负责管理 shell 变量和环境变量。
-     */
-    class VariableManager
-    {
-    private:
-        Shell *shell_;
-        std::unordered_map<std::string, std::unique_ptr<Variable>> variables_;
-
-        /**
-         * @brief 执行命令替换并返回输出
-         * 
-         * @param cmd 要执行的命令
-         * @return std::string 命令的输出
-         */
-        std::string executeCommandSubstitution(const std::string &cmd) const;
+        void invalidateCommandHash();
 
     public:
         /**
@@ -183,6 +166,48 @@ namespace dash
          */
         std::string get(const std::string &name) const;
 
+        /**
+         * @brief 解析变量名，得到可缓存的句柄
+         *
+         * 名字尚未定义时也会返回句柄，之后定义的变量使用同一个句柄。
+         *
+         * @param name 变量名
+         * @return VarHandle 句柄
+         */
+        VarHandle resolve(std::string_view name) const;
+
+        /**
+         * @brief 按句柄获取变量值
+         *
+         * @param handle 由 resolve() 得到的句柄
+         * @return const std::string& 变量值，变量未定义时为空字符串
+         */
+        const std::string &get(VarHandle handle) const;
+
+        /**
+         * @brief 与当前的位置参数整体交换
+         *
+         * 函数调用用它换入参数、返回时再换回，两次都只交换指针，不复制参数。
+         * 交换后同时更新 $#。
+         *
+         * @param params 新的位置参数，返回时持有原来的位置参数
+         */
+        void swapPositional(std::vector<std::string> &params);
+
+        /**
+         * @brief 获取位置参数
+         *
+         * @return const std::vector<std::string>& 位置参数 $1 $2 …
+         */
+        const std::vector<std::string> &getPositional() const { return positional_; }
+
+        /**
+         * @brief 设置上一个命令的退出状态 $?
+         *
+         * @param exit_status 退出状态
+         */
+        void setLastStatus(int exit_status);
+
         /**
          * @brief 检查变量是否存在
          *
@@ -242,6 +267,36 @@ namespace dash
          */
         std::vector<std::string> getEnvironment() const;
 
+        /**
+         * @brief 获取导出变量的 envp 快照
+         *
+         * 快照在导出变量集合改变后第一次调用时重建，其余调用直接复用。
+         * 返回的指针在下一次修改导出变量之前有效。
+         *
+         * @return char *const* 以 nullptr 结尾的环境变量数组
+         */
+        char *const *getEnvp() const;
+
+        /**
+         * @brief 在 envp 快照上叠加命令前缀赋值（FOO=1 cmd）
+         *
+         * 不修改 shell 变量，也不重建快照：只复制指针数组，
+         * 被覆盖的条目替换为 overlay 中的字符串，新名字追加在末尾。
+         * overlay 为空时直接返回快照。
+         *
+         * @param overlay "NAME=value" 形式的前缀赋值，调用者需保证其在使用期间有效
+         * @param envp 用于存放叠加后指针数组的缓冲区
+         * @return char *const* 以 nullptr 结尾的环境变量数组
+         */
+        char *const *getEnvp(const std::vector<std::string> &overlay, std::vector<char *> &envp) const;
+
+        /**
+         * @brief 获取导出变量集合的版本号
+         *
+         * @return uint64_t 版本号
+         */
+        uint64_t getExportGeneration() const { return export_generation_; }
+
         /**
          * @brief 展开字符串中的变量
          *
@@ -250,6 +305,14 @@ namespace dash
          */
         std::string expand(const std::string &str) const;
 
+        /**
+         * @brief 对预先编译的展开程序求值
+         *
+         * @param program 展开程序
+         * @return std::string 展开后的字符串
+         */
+        std::string evaluate(const ExpansionProgram &program) const;
+
         /**
          * @brief 更新特殊变量
          *
@@ -45,6 +45,13 @@ echo "1 + 2 = 3"
 echo "5 * 3 = 15"
 echo "10 / 2 = 5"
 echo "复杂表达式: (5 + 3) * 2 = 16"
+NUM=4
+echo "算术展开: NUM * 2 = $((NUM * 2))"
+echo "预期结果: 算术展开: NUM * 2 = 8"
+echo "算术展开中的命令替换: echo 5 的输出 + 1 = $(( $(echo 5) + 1 ))"
+echo "预期结果: 算术展开中的命令替换: echo 5 的输出 + 1 = 6"
+echo "嵌套的算术展开: (1 + 2) * NUM = $(( $((1 + 2)) * NUM ))"
+echo "预期结果: 嵌套的算术展开: (1 + 2) * NUM = 12"
 echo "============================================"
 
 # 6. 测试环境变量
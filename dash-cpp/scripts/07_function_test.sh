@@ -0,0 +1,132 @@
+#!/bin/sh
+
+# Dash-CPP函数测试脚本
+
+# 1. 输出测试标题
+echo "============================================"
+echo "Dash-CPP Shell 函数测试"
+echo "============================================"
+
+# 2. 测试函数内外的位置参数
+echo "测试函数内外的位置参数..."
+show_args() {
+    echo "函数内: 参数个数=$# 第一个参数=$1"
+}
+caller() {
+    echo "命令: show_args a b c"
+    show_args a b c
+    echo "预期结果: 函数内: 参数个数=3 第一个参数=a"
+    echo "调用后: 参数个数=$# 第一个参数=$1"
+    echo "预期结果: 调用后: 参数个数=2 第一个参数=outer1"
+}
+caller outer1 outer2
+echo "============================================"
+
+# 3. 测试嵌套调用恢复调用者的参数
+echo "测试嵌套调用恢复调用者的参数..."
+inner() {
+    echo "inner: $1"
+}
+outer() {
+    echo "outer 调用前: $1 $2"
+    inner x
+    echo "outer 调用后: $1 $2"
+}
+echo "命令: outer p q"
+outer p q
+echo "预期结果: 依次显示 outer 调用前: p q / inner: x / outer 调用后: p q"
+echo "============================================"
+
+# 4. 测试命令替换捕获函数输出
+echo "测试命令替换捕获函数输出..."
+greet() {
+    echo "hello $1"
+}
+RESULT=$(greet dash)
+echo "命令: RESULT=(greet dash 的命令替换)"
+echo "捕获结果: $RESULT"
+echo "预期结果: 捕获结果: hello dash"
+echo "============================================"
+
+# 5. 测试函数输出重定向到文件
+echo "测试函数输出重定向到文件..."
+echo "命令: greet file > function_test1.txt"
+greet file > function_test1.txt
+echo "文件内容:"
+cat function_test1.txt
+echo "预期结果: hello file"
+echo "============================================"
+
+# 6. 测试函数输出通过管道
+echo "测试函数输出通过管道..."
+echo "命令: greet pipe | cat"
+greet pipe | cat
+echo "预期结果: hello pipe"
+echo "============================================"
+
+# 7. 测试函数中的 exit
+echo "测试函数中的 exit..."
+leave() {
+    echo "exit 之前"
+    exit 3
+    echo "exit 之后"
+}
+echo "命令: 在子shell中调用 leave，然后显示退出状态"
+(leave)
+echo "退出状态: $?"
+echo "预期结果: 只显示 exit 之前，退出状态: 3"
+echo "============================================"
+
+# 8. 测试函数中的 return
+echo "测试函数中的 return..."
+ret3() {
+    return 3
+    echo "return 之后"
+}
+echo "命令: ret3（函数体为 return 3 后接 echo）"
+ret3
+echo "退出状态: $?"
+echo "预期结果: 不显示 return 之后，退出状态: 3"
+find_two() {
+    for i in 1 2 3; do
+        if [ $i = 2 ]; then
+            return 7
+        fi
+        echo "循环: $i"
+    done
+    echo "循环之后"
+}
+echo "命令: find_two（在 for 循环中的 if 里 return 7）"
+find_two
+echo "退出状态: $?"
+echo "预期结果: 只显示 循环: 1，退出状态: 7"
+echo "============================================"
+
+# 9. 测试 return 后恢复调用者的参数
+echo "测试 return 后恢复调用者的参数..."
+fail_inner() {
+    false
+    return
+}
+ret_outer() {
+    fail_inner x y
+    echo "fail_inner 的退出状态: $?"
+    echo "调用后: $1 $2"
+}
+echo "命令: ret_outer p q（fail_inner 执行 false 后不带参数 return）"
+ret_outer p q
+echo "预期结果: fail_inner 的退出状态: 1 / 调用后: p q"
+echo "============================================"
+
+# 10. 测试函数外的 return
+echo "测试函数外的 return..."
+echo "命令: return 1"
+return 1
+echo "退出状态: $?"
+echo "预期结果: 显示只能在函数中使用的错误信息，退出状态: 1"
+echo "============================================"
+
+# 清理临时文件
+echo "清理临时文件..."
+rm -f function_test1.txt
+echo "函数测试完成!"
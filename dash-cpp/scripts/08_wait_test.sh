@@ -0,0 +1,66 @@
+#!/bin/sh
+
+# Dash-CPP wait命令测试脚本
+
+# 1. 输出测试标题
+echo "============================================"
+echo "Dash-CPP Shell wait命令测试"
+echo "============================================"
+
+# 2. 测试 wait -n 等待最先结束的作业
+echo "测试 wait -n 等待最先结束的作业..."
+echo "命令: 后台启动 sleep 2 后以 5 退出、sleep 1 后以 4 退出的两个作业，然后 wait -n"
+sh -c "sleep 2; exit 5" &
+sh -c "sleep 1; exit 4" &
+wait -n
+echo "退出状态: $?"
+echo "预期结果: 退出状态: 4"
+echo "============================================"
+
+# 3. 测试 wait %n 等待指定作业
+echo "测试 wait %n 等待指定作业..."
+echo "命令: wait %1"
+wait %1
+echo "退出状态: $?"
+echo "预期结果: 退出状态: 5"
+echo "============================================"
+
+# 4. 测试 wait pid 等待指定进程
+echo "测试 wait pid 等待指定进程..."
+sh -c "sleep 1; exit 3" &
+PID=$(jobs -l | sed -n "s/.*(\([0-9]*\)).*/\1/p")
+echo "命令: wait $PID"
+wait $PID
+echo "退出状态: $?"
+echo "预期结果: 退出状态: 3"
+echo "============================================"
+
+# 5. 测试等待不是子进程的 pid
+echo "测试等待不是子进程的 pid..."
+echo "命令: wait 999999"
+wait 999999
+echo "退出状态: $?"
+echo "预期结果: 显示不是子进程的错误信息，退出状态: 127"
+echo "============================================"
+
+# 6. 测试没有作业时的 wait -n
+echo "测试没有作业时的 wait -n..."
+echo "命令: wait -n"
+wait -n
+echo "退出状态: $?"
+echo "预期结果: 退出状态: 127"
+echo "============================================"
+
+# 7. 测试不带参数的 wait 等待所有作业
+echo "测试不带参数的 wait 等待所有作业..."
+echo "命令: 后台启动两个以 2 和 6 退出的作业，然后 wait"
+sh -c "sleep 1; exit 2" &
+sh -c "exit 6" &
+wait
+echo "退出状态: $?"
+echo "作业列表:"
+jobs
+echo "预期结果: 退出状态: 0，作业列表为空"
+echo "============================================"
+
+echo "wait命令测试完成!"
@@ -0,0 +1,69 @@
+#!/bin/sh
+
+# Dash-CPP par命令测试脚本
+
+# 1. 输出测试标题
+echo "============================================"
+echo "Dash-CPP Shell par命令测试"
+echo "============================================"
+
+# 2. 测试 -j 限制同时运行的子进程数
+echo "测试 -j 限制同时运行的子进程数..."
+echo "命令: par -j 2 sleep ::: 1 1 1 1"
+START=$(date +%s)
+par -j 2 sleep ::: 1 1 1 1
+END=$(date +%s)
+echo "耗时: $((END - START)) 秒"
+echo "预期结果: 耗时约 2 秒（4 个 sleep 1，每次最多运行 2 个）"
+echo "命令: par -j 4 sleep ::: 1 1 1 1"
+START=$(date +%s)
+par -j 4 sleep ::: 1 1 1 1
+END=$(date +%s)
+echo "耗时: $((END - START)) 秒"
+echo "预期结果: 耗时约 1 秒"
+echo "============================================"
+
+# 3. 测试 {} 替换为输入项
+echo "测试 {} 替换为输入项..."
+echo "命令: par -j 1 echo 值={} ::: a b"
+par -j 1 echo "值={}" ::: a b
+echo "预期结果: 依次显示 值=a 和 值=b"
+echo "============================================"
+
+# 4. 测试没有 {} 时输入项追加在末尾
+echo "测试没有 {} 时输入项追加在末尾..."
+echo "命令: par -j 1 echo 项目 ::: x y"
+par -j 1 echo 项目 ::: x y
+echo "预期结果: 依次显示 项目 x 和 项目 y"
+echo "============================================"
+
+# 5. 测试从标准输入读取输入项
+echo "测试从标准输入读取输入项..."
+echo "命令: printf 的两行输出通过管道传给 par -j 1 echo 行"
+printf "第一行\n第二行\n" | par -j 1 echo 行
+echo "预期结果: 依次显示 行 第一行 和 行 第二行"
+echo "============================================"
+
+# 6. 测试 -g 将每个子进程的输出放在一起
+echo "测试 -g 将每个子进程的输出放在一起..."
+echo "命令: par -g -j 2 sh -c 后接 echo {}开始、sleep {}、echo {}结束 三条命令 ::: 2 1"
+par -g -j 2 sh -c "echo {}开始; sleep {}; echo {}结束" ::: 2 1
+echo "预期结果: 依次显示 1开始、1结束、2开始、2结束"
+echo "不使用 -g 时的输出:"
+par -j 2 sh -c "echo {}开始; sleep {}; echo {}结束" ::: 2 1
+echo "预期结果: 两个作业的输出交错，先显示 1开始 和 2开始（顺序不定），再依次显示 1结束、2结束"
+echo "============================================"
+
+# 7. 测试退出状态为失败的子进程个数
+echo "测试退出状态为失败的子进程个数..."
+echo "命令: par sh -c 后接 exit {} ::: 0 1 2 0 3"
+par sh -c "exit {}" ::: 0 1 2 0 3
+echo "退出状态: $?"
+echo "预期结果: 退出状态: 3"
+echo "命令: par true ::: a b c"
+par true ::: a b c
+echo "退出状态: $?"
+echo "预期结果: 退出状态: 0"
+echo "============================================"
+
+echo "par命令测试完成!"
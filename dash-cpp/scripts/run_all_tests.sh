@@ -58,6 +58,30 @@ echo ""
 echo "测试 06_variable_expansion_test.sh 完成"
 echo ""
 
+echo "============================================"
+echo "执行测试: 07_function_test.sh"
+echo "============================================"
+source scripts/07_function_test.sh
+echo ""
+echo "测试 07_function_test.sh 完成"
+echo ""
+
+echo "============================================"
+echo "执行测试: 08_wait_test.sh"
+echo "============================================"
+source scripts/08_wait_test.sh
+echo ""
+echo "测试 08_wait_test.sh 完成"
+echo ""
+
+echo "============================================"
+echo "执行测试: 09_par_test.sh"
+echo "============================================"
+source scripts/09_par_test.sh
+echo ""
+echo "测试 09_par_test.sh 完成"
+echo ""
+
 echo "============================================"
 echo "所有测试已完成!"
 echo "============================================" 
\ No newline at end of file
@@ -24,10 +24,10 @@ namespace dash
             //读取所有alias
             auto m = AliasManager::getNowAliasManager()->getAllAliases();
             if(m.size()>0){
-                std::cout<<"别名\t命令"<<std::endl;
+                std::cout<<"别名\t命令"<< '\n';
             }
             for(auto mm : m){
-                std::cout<<mm.first<<"\t"<<mm.second<<std::endl;
+                std::cout<<mm.first<<"\t"<<mm.second<< '\n';
             }
         }else if(args[1]=="-s"){
             if (args.size()>2){
@@ -77,9 +77,9 @@ namespace dash
                 else if(AliasManager::getNowAliasManager()->hasAlias(args[i])){
                     if(f){
                         f = 0;
-                        std::cout<<"别名\t命令"<<std::endl;
+                        std::cout<<"别名\t命令"<< '\n';
                     }
-                    std::cout<<args[i]<<"\t"<<AliasManager::getNowAliasManager()->getAlias(args[i])<<std::endl;
+                    std::cout<<args[i]<<"\t"<<AliasManager::getNowAliasManager()->getAlias(args[i])<< '\n';
                 }else{
                     std::cerr<<"没有检查到别名："<<args[i]<<std::endl;
                     return 1;
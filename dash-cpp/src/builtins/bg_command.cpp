@@ -26,36 +26,15 @@ namespace dash
             return 1;
         }
 
-        int job_id;
-
-        // 如果没有指定作业ID，使用最近的已停止作业
-        if (args.size() < 2)
-        {
-            // TODO: 获取最近的已停止作业ID
-            // 暂时简单实现，使用ID为1的作业
-            job_id = 1;
-        }
-        else
+        // 未指定作业时使用当前作业
+        std::string spec = args.size() < 2 ? "%%" : args[1];
+        Job *job = shell_->getJobControl()->resolveJobSpec(spec);
+        if (!job)
         {
-            // 解析作业ID
-            std::string job_arg = args[1];
-
-            // 检查是否是作业ID格式（以%开头）
-            if (job_arg[0] == '%')
-            {
-                job_arg = job_arg.substr(1);
-            }
-
-            try
-            {
-                job_id = std::stoi(job_arg);
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << "bg: " << job_arg << ": 无效的作业规格" << std::endl;
-                return 1;
-            }
+            std::cerr << "bg: " << spec << ": 无此作业" << std::endl;
+            return 1;
         }
+        int job_id = job->getId();
 
         // 将作业放入后台并继续运行
         try
@@ -11,6 +11,7 @@
 #include "builtins/cd_command.h"
 #include "core/shell.h"
 #include "variable/variable_manager.h"
+#include "variable/prompt_string.h"
 #include "utils/error.h"
 
 namespace dash
@@ -32,6 +33,9 @@ namespace dash
             return 1;
         }
 
+        // 提示符中缓存的工作目录失效
+        prompt_string::invalidateCwd();
+
         // 更新PWD和OLDPWD环境变量
         updatePwdVariables(target_dir);
 
@@ -69,7 +73,7 @@ namespace dash
             {
                 throw ShellException(ExceptionType::RUNTIME, "cd: OLDPWD not set");
             }
-            std::cout << oldpwd << std::endl;
+            std::cout << oldpwd << '\n';
             return oldpwd;
         }
 
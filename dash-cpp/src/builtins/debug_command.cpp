@@ -24,29 +24,29 @@ namespace dash
     
     void DebugCommand::showHelp() const
     {
-        std::cout << "debug [选项]" << std::endl;
-        std::cout << "  控制调试信息的显示。" << std::endl;
-        std::cout << "  选项:" << std::endl;
-        std::cout << "    on/off          - 开启/关闭所有调试信息" << std::endl;
-        std::cout << "    status          - 显示当前调试状态" << std::endl;
-        std::cout << "    command on/off  - 开启/关闭命令调试信息" << std::endl;
-        std::cout << "    parser on/off   - 开启/关闭解析器调试信息" << std::endl;
-        std::cout << "    executor on/off - 开启/关闭执行器调试信息" << std::endl;
-        std::cout << "    completion on/off - 开启/关闭补全调试信息" << std::endl;
-        std::cout << "  示例:" << std::endl;
-        std::cout << "    debug on        - 开启所有调试信息" << std::endl;
-        std::cout << "    debug command on - 只开启命令调试信息" << std::endl;
-        std::cout << "    debug status    - 显示当前调试状态" << std::endl;
+        std::cout << "debug [选项]" << '\n';
+        std::cout << "  控制调试信息的显示。" << '\n';
+        std::cout << "  选项:" << '\n';
+        std::cout << "    on/off          - 开启/关闭所有调试信息" << '\n';
+        std::cout << "    status          - 显示当前调试状态" << '\n';
+        std::cout << "    command on/off  - 开启/关闭命令调试信息" << '\n';
+        std::cout << "    parser on/off   - 开启/关闭解析器调试信息" << '\n';
+        std::cout << "    executor on/off - 开启/关闭执行器调试信息" << '\n';
+        std::cout << "    completion on/off - 开启/关闭补全调试信息" << '\n';
+        std::cout << "  示例:" << '\n';
+        std::cout << "    debug on        - 开启所有调试信息" << '\n';
+        std::cout << "    debug command on - 只开启命令调试信息" << '\n';
+        std::cout << "    debug status    - 显示当前调试状态" << '\n';
     }
     
     void DebugCommand::showStatus() const
     {
-        std::cout << "调试状态:" << std::endl;
-        std::cout << "  全局调试模式:   " << (debug_enabled_ ? "开启" : "关闭") << std::endl;
-        std::cout << "  命令调试模式:   " << (command_debug_enabled_ ? "开启" : "关闭") << std::endl;
-        std::cout << "  解析器调试模式: " << (parser_debug_enabled_ ? "开启" : "关闭") << std::endl;
-        std::cout << "  执行器调试模式: " << (executor_debug_enabled_ ? "开启" : "关闭") << std::endl;
-        std::cout << "  补全调试模式:   " << (completion_debug_enabled_ ? "开启" : "关闭") << std::endl;
+        std::cout << "调试状态:" << '\n';
+        std::cout << "  全局调试模式:   " << (debug_enabled_ ? "开启" : "关闭") << '\n';
+        std::cout << "  命令调试模式:   " << (command_debug_enabled_ ? "开启" : "关闭") << '\n';
+        std::cout << "  解析器调试模式: " << (parser_debug_enabled_ ? "开启" : "关闭") << '\n';
+        std::cout << "  执行器调试模式: " << (executor_debug_enabled_ ? "开启" : "关闭") << '\n';
+        std::cout << "  补全调试模式:   " << (completion_debug_enabled_ ? "开启" : "关闭") << '\n';
     }
     
     int DebugCommand::execute(const std::vector<std::string>& args)
@@ -68,7 +68,7 @@ namespace dash
                 parser_debug_enabled_ = true;
                 executor_debug_enabled_ = true;
                 completion_debug_enabled_ = true;
-                std::cout << "已开启所有调试信息" << std::endl;
+                std::cout << "已开启所有调试信息" << '\n';
                 return 0;
             }
             else if (args[1] == "off")
@@ -79,7 +79,7 @@ namespace dash
                 parser_debug_enabled_ = false;
                 executor_debug_enabled_ = false;
                 completion_debug_enabled_ = false;
-                std::cout << "已关闭所有调试信息" << std::endl;
+                std::cout << "已关闭所有调试信息" << '\n';
                 return 0;
             }
             else if (args[1] == "status")
@@ -95,7 +95,7 @@ namespace dash
                 {
                     command_debug_enabled_ = true;
                     debug_enabled_ = true;  // 至少有一个模式开启时，全局调试也开启
-                    std::cout << "已开启命令调试信息" << std::endl;
+                    std::cout << "已开启命令调试信息" << '\n';
                     return 0;
                 }
                 else if (args[2] == "off")
@@ -106,7 +106,7 @@ namespace dash
                     {
                         debug_enabled_ = false;
                     }
-                    std::cout << "已关闭命令调试信息" << std::endl;
+                    std::cout << "已关闭命令调试信息" << '\n';
                     return 0;
                 }
             }
@@ -117,7 +117,7 @@ namespace dash
                 {
                     parser_debug_enabled_ = true;
                     debug_enabled_ = true;  // 至少有一个模式开启时，全局调试也开启
-                    std::cout << "已开启解析器调试信息" << std::endl;
+                    std::cout << "已开启解析器调试信息" << '\n';
                     return 0;
                 }
                 else if (args[2] == "off")
@@ -128,7 +128,7 @@ namespace dash
                     {
                         debug_enabled_ = false;
                     }
-                    std::cout << "已关闭解析器调试信息" << std::endl;
+                    std::cout << "已关闭解析器调试信息" << '\n';
                     return 0;
                 }
             }
@@ -139,7 +139,7 @@ namespace dash
                 {
                     executor_debug_enabled_ = true;
                     debug_enabled_ = true;  // 至少有一个模式开启时，全局调试也开启
-                    std::cout << "已开启执行器调试信息" << std::endl;
+                    std::cout << "已开启执行器调试信息" << '\n';
                     return 0;
                 }
                 else if (args[2] == "off")
@@ -150,7 +150,7 @@ namespace dash
                     {
                         debug_enabled_ = false;
                     }
-                    std::cout << "已关闭执行器调试信息" << std::endl;
+                    std::cout << "已关闭执行器调试信息" << '\n';
                     return 0;
                 }
             }
@@ -161,7 +161,7 @@ namespace dash
                 {
                     completion_debug_enabled_ = true;
                     debug_enabled_ = true;  // 至少有一个模式开启时，全局调试也开启
-                    std::cout << "已开启补全调试信息" << std::endl;
+                    std::cout << "已开启补全调试信息" << '\n';
                     return 0;
                 }
                 else if (args[2] == "off")
@@ -172,7 +172,7 @@ namespace dash
                     {
                         debug_enabled_ = false;
                     }
-                    std::cout << "已关闭补全调试信息" << std::endl;
+                    std::cout << "已关闭补全调试信息" << '\n';
                     return 0;
                 }
             }
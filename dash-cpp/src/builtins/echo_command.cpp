@@ -67,11 +67,7 @@ namespace dash
 
         if (!no_newline)
         {
-            std::cout << std::endl;
-        }
-        else
-        {
-            std::cout.flush();
+            std::cout << '\n';
         }
 
         return 0;
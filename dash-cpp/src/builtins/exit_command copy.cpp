@@ -76,8 +76,10 @@ namespace dash
         const auto &jobs = jc->getJobs();
         
         // 手动检查每个作业
-        for (const auto &pair : jobs) {
-            const auto &job = pair.second;
+        for (const auto &job : jobs) {
+            if (!job) {
+                continue;
+            }
             JobStatus job_status = job->getStatus();
             
             if (job_status == JobStatus::RUNNING || job_status == JobStatus::STOPPED) {
@@ -90,12 +92,14 @@ namespace dash
         if (has_active_jobs) {
             // 输出作业状态详细信息
             DebugLog::logCommand("当前有活动的作业:");
-            for (const auto &pair : jobs) {
-                const auto &job = pair.second;
+            for (const auto &job : jobs) {
+                if (!job) {
+                    continue;
+                }
                 JobStatus job_status = job->getStatus();
                 // 只显示活动的作业
                 if (job_status == JobStatus::RUNNING || job_status == JobStatus::STOPPED) {
-                    DebugLog::logCommand("  [" + std::to_string(pair.first) + "] " + 
+                    DebugLog::logCommand("  [" + std::to_string(job->getId()) + "] " + 
                         (job_status == JobStatus::RUNNING ? "Running" : "Stopped") + "\t" + job->getCommand());
                 }
             }
@@ -110,9 +114,8 @@ namespace dash
         // 检查是否有任何已完成但未清理的作业
         // 我们允许shell退出，但首先显示已完成的作业信息
         bool has_completed_jobs = false;
-        for (const auto &pair : jobs) {
-            const auto &job = pair.second;
-            if (job->getStatus() == JobStatus::DONE) {
+        for (const auto &job : jobs) {
+            if (job && job->getStatus() == JobStatus::DONE) {
                 has_completed_jobs = true;
                 break;
             }
@@ -0,0 +1,100 @@
+/**
+ * @file hash_command.cpp
+ * @brief Hash命令类实现
+ */
+
+#include <iostream>
+#include <algorithm>
+#include "builtins/hash_command.h"
+#include "core/shell.h"
+#include "core/executor.h"
+#include "core/command_hash.h"
+#include "variable/variable_manager.h"
+
+namespace dash
+{
+
+    HashCommand::HashCommand(Shell *shell)
+        : BuiltinCommand(shell)
+    {
+    }
+
+    int HashCommand::execute(const std::vector<std::string> &args)
+    {
+        CommandHash &hash = shell_->getExecutor()->getCommandHash();
+
+        size_t start_index = 1;
+        if (args.size() > 1 && args[1] == "-r")
+        {
+            // 清空哈希表
+            hash.clear();
+            start_index = 2;
+        }
+        else if (args.size() > 1 && !args[1].empty() && args[1][0] == '-')
+        {
+            std::cerr << "hash: " << args[1] << ": 无效选项" << std::endl;
+            std::cerr << "usage: hash [-r] [name ...]" << std::endl;
+            return 1;
+        }
+
+        if (args.size() == 1)
+        {
+            // 按命令名排序显示哈希表
+            const auto &entries = hash.entries();
+            if (entries.empty())
+            {
+                std::cout << "hash: 哈希表为空" << '\n';
+                return 0;
+            }
+
+            std::vector<std::string> names;
+            names.reserve(entries.size());
+            for (const auto &pair : entries)
+            {
+                names.push_back(pair.first);
+            }
+            std::sort(names.begin(), names.end());
+
+            std::cout << "hits\tcommand" << '\n';
+            for (const auto &name : names)
+            {
+                const auto &entry = entries.at(name);
+                std::cout << entry.hits << "\t" << entry.path << '\n';
+            }
+            return 0;
+        }
+
+        // 将指定的命令加入哈希表
+        int return_status = 0;
+        std::string path_var = shell_->getVariableManager()->get("PATH");
+        for (size_t i = start_index; i < args.size(); ++i)
+        {
+            const std::string &name = args[i];
+            if (shell_->getExecutor()->hasBuiltinCommand(name))
+            {
+                continue;
+            }
+
+            // 重新查找，而不是使用旧的缓存
+            hash.remove(name);
+            if (hash.find(name, path_var).empty())
+            {
+                std::cerr << "hash: " << name << ": 未找到" << std::endl;
+                return_status = 1;
+            }
+        }
+
+        return return_status;
+    }
+
+    std::string HashCommand::getName() const
+    {
+        return "hash";
+    }
+
+    std::string HashCommand::getHelp() const
+    {
+        return "hash [-r] [name ...] - 显示、添加或清空命令路径哈希表";
+    }
+
+} // namespace dash
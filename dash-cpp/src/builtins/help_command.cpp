@@ -128,6 +128,57 @@ namespace dash
             "    type ls         - 显示ls命令的类型\n"
             "    type cd alias   - 显示多个命令的类型\n"
             "    type ll         - 显示别名的定义";
+
+        command_help_["hash"] = 
+            "hash [-r] [命令名...]\n"
+            "  显示或维护命令路径哈希表。\n"
+            "  选项：\n"
+            "    -r  清空哈希表\n"
+            "  示例：\n"
+            "    hash            - 显示已缓存的命令路径及命中次数\n"
+            "    hash ls grep    - 查找并缓存指定命令的路径\n"
+            "    hash -r         - 清空哈希表";
+
+        command_help_["kill"] = 
+            "kill [-s 信号 | -信号] <进程ID | %作业> ...\n"
+            "  向进程或作业发送信号，默认发送 SIGTERM。\n"
+            "  作业可写作 %n、%%、%-、%前缀 或 %?子串，整个进程组都会收到信号。\n"
+            "  示例：\n"
+            "    kill %1\n"
+            "    kill -9 1234";
+
+        command_help_["wait"] = 
+            "wait [-n] [进程ID | %作业 ...]\n"
+            "  等待后台作业结束，返回最后等待的进程或作业的退出状态。\n"
+            "  不带参数时等待所有运行中的作业，Ctrl+C 可以打断等待。\n"
+            "  选项：\n"
+            "    -n  任意一个作业结束即返回\n"
+            "  示例：\n"
+            "    wait\n"
+            "    wait -n\n"
+            "    wait %1 1234";
+
+        command_help_["par"] = 
+            "par [-j N] [-g] 命令 [参数...] [::: 项目...]\n"
+            "  对每个项目并行执行一次命令，同时最多运行 N 个（默认为 CPU 数）。\n"
+            "  命令中的 {} 替换为项目，没有 {} 时项目追加在末尾；\n"
+            "  没有 ::: 时从标准输入逐行读取项目。子进程运行期间可用 jobs 查看。\n"
+            "  返回失败的子进程个数（最多 101）。\n"
+            "  选项：\n"
+            "    -j N  最多同时运行 N 个子进程\n"
+            "    -g    每个子进程的输出结束后整体输出，不与其他子进程交错\n"
+            "  示例：\n"
+            "    par -j 4 gzip ::: *.log\n"
+            "    par -g sh -c 'echo {}; sleep 1' ::: a b c\n"
+            "    ls *.txt | par wc -l";
+
+        command_help_["return"] = 
+            "return [状态码]\n"
+            "  从当前函数返回，状态码默认为最后执行的命令的退出状态。\n"
+            "  只能在函数中使用。\n"
+            "  示例：\n"
+            "    return\n"
+            "    return 1";
     }
     
     int HelpCommand::execute(const std::vector<std::string>& args)
@@ -140,7 +191,7 @@ namespace dash
             
             if (it != command_help_.end())
             {
-                std::cout << it->second << std::endl;
+                std::cout << it->second << '\n';
             }
             else
             {
@@ -151,8 +202,8 @@ namespace dash
         else
         {
             // 显示所有可用命令的列表
-            std::cout << "Dash-CPP Shell 帮助系统" << std::endl;
-            std::cout << "可用命令：" << std::endl;
+            std::cout << "Dash-CPP Shell 帮助系统" << '\n';
+            std::cout << "可用命令：" << '\n';
             
             // 计算最长命令名称的长度，用于对齐
             size_t max_length = 0;
@@ -185,7 +236,7 @@ namespace dash
                           << cmd.first << short_desc << std::endl;
             }
             
-            std::cout << "\n使用 'help 命令名' 获取特定命令的详细帮助信息。" << std::endl;
+            std::cout << "\n使用 'help 命令名' 获取特定命令的详细帮助信息。" << '\n';
         }
         
         return 0;
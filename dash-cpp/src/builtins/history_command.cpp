@@ -90,13 +90,13 @@ namespace dash
 
     void HistoryCommand::displayHelp()
     {
-        std::cout << "用法: history [选项] [参数]" << std::endl;
-        std::cout << "选项:" << std::endl;
-        std::cout << "  [n]             显示最近n条历史记录" << std::endl;
-        std::cout << "  -c, --clear     清除历史记录" << std::endl;
-        std::cout << "  -h, --help      显示此帮助信息" << std::endl;
-        std::cout << "  -s, --save      将历史记录保存到指定文件" << std::endl;
-        std::cout << "  -l, --load      从指定文件加载历史记录" << std::endl;
+        std::cout << "用法: history [选项] [参数]" << '\n';
+        std::cout << "选项:" << '\n';
+        std::cout << "  [n]             显示最近n条历史记录" << '\n';
+        std::cout << "  -c, --clear     清除历史记录" << '\n';
+        std::cout << "  -h, --help      显示此帮助信息" << '\n';
+        std::cout << "  -s, --save      将历史记录保存到指定文件" << '\n';
+        std::cout << "  -l, --load      从指定文件加载历史记录" << '\n';
     }
 
     void HistoryCommand::displayHistory(size_t count)
@@ -107,18 +107,12 @@ namespace dash
             return;
         }
 
-        const std::vector<HistoryEntry>& entries = history->getAllCommands();
-        
-        // 计算要显示的记录数量
-        size_t start = 0;
-        if (count > 0 && count < entries.size()) {
-            start = entries.size() - count;
-        }
+        // count 为 0 时显示全部
+        HistoryView entries = count > 0 ? history->getRecentCommands(count) : history->getAllCommands();
         
         // 显示历史记录
-        for (size_t i = start; i < entries.size(); ++i) {
-            const auto& entry = entries[i];
-            std::cout << entry.index << "  " << entry.command << std::endl;
+        for (const auto& entry : entries) {
+            std::cout << entry.index << "  " << entry.command << '\n';
         }
     }
 
@@ -127,7 +121,7 @@ namespace dash
         History* history = shell_->getHistory();
         if (history) {
             history->clear();
-            std::cout << "历史记录已清除" << std::endl;
+            std::cout << "历史记录已清除" << '\n';
         }
     }
 
@@ -140,7 +134,7 @@ namespace dash
         }
         
         if (history->saveToFile(filename)) {
-            std::cout << "历史记录已保存到 " << filename << std::endl;
+            std::cout << "历史记录已保存到 " << filename << '\n';
         } else {
             std::cerr << "无法保存历史记录到 " << filename << std::endl;
         }
@@ -155,7 +149,7 @@ namespace dash
         }
         
         if (history->loadFromFile(filename)) {
-            std::cout << "已从 " << filename << " 加载历史记录" << std::endl;
+            std::cout << "已从 " << filename << " 加载历史记录" << '\n';
         } else {
             std::cerr << "无法从 " << filename << " 加载历史记录" << std::endl;
         }
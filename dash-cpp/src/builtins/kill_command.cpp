@@ -50,12 +50,25 @@ namespace dash
             upper_sig_str = upper_sig_str.substr(3);
         }
 
-        for (int i = 1; i < NSIG; ++i)
+        // strsignal() returns descriptions ("Terminated"), so match against names
+        static const struct
         {
-            const char* sig_name = strsignal(i);
-            if (sig_name && upper_sig_str == sig_name)
+            const char *name;
+            int signo;
+        } signal_names[] = {
+            {"HUP", SIGHUP}, {"INT", SIGINT}, {"QUIT", SIGQUIT}, {"ILL", SIGILL},
+            {"TRAP", SIGTRAP}, {"ABRT", SIGABRT}, {"BUS", SIGBUS}, {"FPE", SIGFPE},
+            {"KILL", SIGKILL}, {"USR1", SIGUSR1}, {"SEGV", SIGSEGV}, {"USR2", SIGUSR2},
+            {"PIPE", SIGPIPE}, {"ALRM", SIGALRM}, {"TERM", SIGTERM}, {"CHLD", SIGCHLD},
+            {"CONT", SIGCONT}, {"STOP", SIGSTOP}, {"TSTP", SIGTSTP}, {"TTIN", SIGTTIN},
+            {"TTOU", SIGTTOU}, {"URG", SIGURG}, {"XCPU", SIGXCPU}, {"XFSZ", SIGXFSZ},
+            {"VTALRM", SIGVTALRM}, {"PROF", SIGPROF}, {"WINCH", SIGWINCH}, {"SYS", SIGSYS}};
+
+        for (const auto &entry : signal_names)
+        {
+            if (upper_sig_str == entry.name)
             {
-                return i;
+                return entry.signo;
             }
         }
 
@@ -117,40 +130,15 @@ namespace dash
 
             if (target[0] == '%')
             {
-                if (!shell_->getJobControl()->isEnabled())
-                {
-                    std::cerr << "kill: job control not enabled" << std::endl;
-                    ret_status = 1;
-                    continue;
-                }
-                try
-                {
-                    int job_id = std::stoi(target.substr(1));
-                    const auto& jobs = shell_->getJobControl()->getJobs();
-                    auto it = jobs.find(job_id);
-                    if (it != jobs.end())
-                    {
-                        pid_to_kill = it->second->getPgid(); // Kill process group
-                    }
-                    else
-                    {
-                        std::cerr << "kill: no such job: " << target << std::endl;
-                        ret_status = 1;
-                        continue;
-                    }
-                }
-                catch (const std::invalid_argument &e)
-                {
-                    std::cerr << "kill: invalid job ID: " << target << std::endl;
-                    ret_status = 1;
-                    continue;
-                }
-                catch (const std::out_of_range &e)
+                // 作业的进程组整体接收信号
+                Job *job = shell_->getJobControl()->resolveJobSpec(target);
+                if (!job)
                 {
-                    std::cerr << "kill: job ID out of range: " << target << std::endl;
+                    std::cerr << "kill: no such job: " << target << std::endl;
                     ret_status = 1;
                     continue;
                 }
+                pid_to_kill = job->getPgid() > 0 ? -job->getPgid() : job->getProcesses().front()->getPid();
             }
             else
             {
@@ -0,0 +1,288 @@
+/**
+ * @file par_command.cpp
+ * @brief Par命令类实现
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include "builtins/par_command.h"
+#include "core/shell.h"
+#include "core/executor.h"
+#include "core/node.h"
+#include "job/job_control.h"
+#include "utils/error.h"
+
+namespace dash
+{
+
+    ParCommand::ParCommand(Shell *shell)
+        : BuiltinCommand(shell)
+    {
+    }
+
+    std::vector<std::string> ParCommand::buildArgs(const std::vector<std::string> &command, const std::string &item)
+    {
+        std::vector<std::string> args;
+        args.reserve(command.size() + 1);
+        bool replaced = false;
+        for (const std::string &word : command)
+        {
+            std::string arg;
+            size_t start = 0;
+            size_t pos;
+            while ((pos = word.find("{}", start)) != std::string::npos)
+            {
+                arg.append(word, start, pos - start);
+                arg += item;
+                start = pos + 2;
+                replaced = true;
+            }
+            arg.append(word, start, std::string::npos);
+            args.push_back(std::move(arg));
+        }
+        if (!replaced)
+        {
+            args.push_back(item);
+        }
+        return args;
+    }
+
+    void ParCommand::flushOutput(Slot &slot)
+    {
+        if (slot.output_fd == -1)
+        {
+            return;
+        }
+
+        // 子进程已结束，一次性输出它的全部内容
+        char buffer[4096];
+        ssize_t n;
+        lseek(slot.output_fd, 0, SEEK_SET);
+        while ((n = read(slot.output_fd, buffer, sizeof(buffer))) > 0)
+        {
+            std::cout.write(buffer, n);
+        }
+        std::cout.flush();
+        close(slot.output_fd);
+        slot.output_fd = -1;
+    }
+
+    int ParCommand::collect(std::vector<Slot> &running, int &failed)
+    {
+        std::vector<int> job_ids;
+        job_ids.reserve(running.size());
+        for (const Slot &slot : running)
+        {
+            job_ids.push_back(slot.job_id);
+        }
+
+        int finished = -1;
+        int status = shell_->getJobControl()->waitForAnyJob(job_ids, finished);
+        if (status == JobControl::WAIT_INTERRUPTED)
+        {
+            return 0;
+        }
+        if (finished == -1)
+        {
+            // 剩下的子进程都已停止
+            return -1;
+        }
+
+        auto it = std::find_if(running.begin(), running.end(),
+                               [finished](const Slot &slot) { return slot.job_id == finished; });
+        flushOutput(*it);
+        running.erase(it);
+        if (status != 0)
+        {
+            ++failed;
+        }
+        return 1;
+    }
+
+    void ParCommand::interrupt(const std::vector<Slot> &running)
+    {
+        // 子进程在各自的进程组中，收不到终端的 SIGINT，由这里转发
+        JobControl *job_control = shell_->getJobControl();
+        for (const Slot &slot : running)
+        {
+            Job *job = job_control->findJob(slot.job_id);
+            if (job)
+            {
+                kill(-job->getPgid(), SIGINT);
+            }
+        }
+    }
+
+    int ParCommand::execute(const std::vector<std::string> &args)
+    {
+        long max_jobs = sysconf(_SC_NPROCESSORS_ONLN);
+        bool group = false;
+
+        size_t i = 1;
+        for (; i < args.size() && args[i].size() > 1 && args[i][0] == '-'; ++i)
+        {
+            const std::string &opt = args[i];
+            if (opt == "--")
+            {
+                ++i;
+                break;
+            }
+            if (opt == "-g")
+            {
+                group = true;
+                continue;
+            }
+            if (opt.compare(0, 2, "-j") == 0)
+            {
+                std::string value = opt.size() > 2 ? opt.substr(2) : (i + 1 < args.size() ? args[++i] : "");
+                if (value.empty() || value.size() > 6 ||
+                    !std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isdigit(c); }) ||
+                    std::stol(value) == 0)
+                {
+                    std::cerr << "par: -j: 需要正整数" << '\n';
+                    return 2;
+                }
+                max_jobs = std::stol(value);
+                continue;
+            }
+            std::cerr << "par: " << opt << ": 无效选项" << '\n';
+            std::cerr << "usage: par [-j N] [-g] 命令 [参数...] [::: 项目...]" << '\n';
+            return 2;
+        }
+        if (max_jobs < 1)
+        {
+            max_jobs = 1;
+        }
+
+        // ::: 之前是命令模板，之后是输入项；没有 ::: 时从标准输入逐行读取
+        auto separator = std::find(args.begin() + i, args.end(), ":::");
+        std::vector<std::string> command(args.begin() + i, separator);
+        if (command.empty())
+        {
+            std::cerr << "usage: par [-j N] [-g] 命令 [参数...] [::: 项目...]" << '\n';
+            return 2;
+        }
+
+        std::vector<std::string> items;
+        if (separator != args.end())
+        {
+            items.assign(separator + 1, args.end());
+        }
+        else
+        {
+            std::string line;
+            while (std::getline(std::cin, line))
+            {
+                items.push_back(line);
+            }
+            std::cin.clear();
+            clearerr(stdin);
+        }
+
+        JobControl *job_control = shell_->getJobControl();
+        Executor *executor = shell_->getExecutor();
+        const AstVector<Redirection> no_redirections;
+
+        // 子进程不与 shell 争用标准输入
+        int null_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+
+        std::vector<Slot> running;
+        running.reserve(static_cast<size_t>(std::min<long>(max_jobs, static_cast<long>(items.size()))));
+        int failed = 0;
+        bool interrupted = false;
+
+        for (const std::string &item : items)
+        {
+            // 槽位已满时等一个子进程结束再补上
+            while (static_cast<long>(running.size()) >= max_jobs && !interrupted)
+            {
+                interrupted = collect(running, failed) == 0;
+            }
+            if (interrupted)
+            {
+                break;
+            }
+
+            std::vector<std::string> child_args = buildArgs(command, item);
+            int output_fd = group ? memfd_create("par", MFD_CLOEXEC) : -1;
+
+            pid_t pid;
+            try
+            {
+                pid = executor->startExternal(child_args, no_redirections, null_fd, output_fd);
+            }
+            catch (const ShellException &e)
+            {
+                std::cerr << "par: " << e.what() << '\n';
+                if (output_fd != -1)
+                {
+                    close(output_fd);
+                }
+                ++failed;
+                break;
+            }
+
+            std::string cmd_text;
+            for (size_t j = 0; j < child_args.size(); ++j)
+            {
+                cmd_text += (j > 0 ? " " : "") + child_args[j];
+            }
+            int job_id = job_control->addJob(cmd_text, pid);
+            job_control->addProcess(job_id, pid, cmd_text);
+            running.push_back(Slot{job_id, output_fd});
+        }
+
+        if (interrupted)
+        {
+            interrupt(running);
+        }
+
+        // 等待剩余的子进程：第一次 Ctrl+C 转发给子进程后继续等待，
+        // 再次中断时不再等待，剩下的子进程留在作业表中
+        while (!running.empty())
+        {
+            int result = collect(running, failed);
+            if (result < 0 || (result == 0 && interrupted))
+            {
+                break;
+            }
+            if (result == 0)
+            {
+                interrupted = true;
+                interrupt(running);
+            }
+        }
+
+        for (Slot &slot : running)
+        {
+            flushOutput(slot);
+        }
+        if (null_fd != -1)
+        {
+            close(null_fd);
+        }
+
+        if (interrupted)
+        {
+            return 128 + SIGINT;
+        }
+        return std::min(failed, 101);
+    }
+
+    std::string ParCommand::getName() const
+    {
+        return "par";
+    }
+
+    std::string ParCommand::getHelp() const
+    {
+        return "par [-j N] [-g] 命令 [参数...] [::: 项目...] - 并行执行命令";
+    }
+
+} // namespace dash
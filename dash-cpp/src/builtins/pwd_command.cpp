@@ -60,7 +60,7 @@ namespace dash
             return 1;
         }
 
-        std::cout << cwd << std::endl;
+        std::cout << cwd << '\n';
         return 0;
     }
 
@@ -0,0 +1,59 @@
+/**
+ * @file return_command.cpp
+ * @brief Return命令类实现
+ */
+
+#include <iostream>
+#include "builtins/return_command.h"
+#include "core/shell.h"
+#include "core/executor.h"
+
+namespace dash
+{
+
+    ReturnCommand::ReturnCommand(Shell *shell)
+        : BuiltinCommand(shell)
+    {
+    }
+
+    int ReturnCommand::execute(const std::vector<std::string> &args)
+    {
+        Executor *executor = shell_->getExecutor();
+
+        if (!executor->inFunction())
+        {
+            std::cerr << "return: 只能在函数中使用" << '\n';
+            return 1;
+        }
+
+        // 不带参数时使用上一个命令的退出状态
+        int status = executor->getLastStatus();
+        if (args.size() > 1)
+        {
+            try
+            {
+                status = std::stoi(args[1]) & 0xFF;
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "return: " << args[1] << ": 数字参数无效" << '\n';
+                status = 2;
+            }
+        }
+
+        // 由执行器在当前命令结束后退出函数体
+        executor->requestReturn();
+        return status;
+    }
+
+    std::string ReturnCommand::getName() const
+    {
+        return "return";
+    }
+
+    std::string ReturnCommand::getHelp() const
+    {
+        return "return [n] - 从函数返回，状态码为n（默认为最后执行的命令的退出状态）";
+    }
+
+} // namespace dash
@@ -4,14 +4,13 @@
  */
 
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <sstream>
+#include <memory>
 #include "builtins/source_command.h"
 #include "core/shell.h"
-#include "core/parser.h"
-#include "core/lexer.h"
+#include "core/node.h"
 #include "core/executor.h"
+#include "core/script_cache.h"
 #include "utils/error.h"
 
 namespace dash
@@ -33,69 +32,30 @@ namespace dash
 
         // 获取脚本文件路径
         std::string script_path = args[1];
-        
-        // 打开脚本文件
-        std::ifstream file(script_path);
-        if (!file)
-        {
-            std::cerr << "source: " << script_path << ": 没有那个文件或目录" << std::endl;
-            return 1;
-        }
 
-        // 创建解析器
-        Parser parser(shell_);
-        
-        int status = 0;
-        std::string line;
-        int line_number = 0;
-        
+        // 逐条解析并执行顶层命令；同一会话中文件未变化时复用已解析的命令
         try
         {
-            // 逐行读取和执行脚本
-            while (std::getline(file, line))
-            {
-                line_number++;
-                
-                // 跳过空行和注释行
-                if (line.empty() || line[0] == '#')
-                {
-                    continue;
-                }
-                
-                // 去除行尾的回车符
-                if (!line.empty() && line[line.length() - 1] == '\r')
-                {
-                    line.erase(line.length() - 1);
-                }
-                
-                try
-                {
-                    // 解析当前行
-                    std::unique_ptr<Node> node = parser.parse(line);
-                    
-                    if (node)
-                    {
-                        // 执行解析后的命令树
-                        status = shell_->getExecutor()->execute(node.get());
-                    }
-                }
-                catch (const ShellException &e)
-                {
-                    std::cerr << "source: " << script_path << ":" << line_number 
-                              << ": " << e.what() << std::endl;
-                    // 继续执行下一行，而不是立即退出
-                }
-            }
+            std::shared_ptr<Script> script = shell_->getScriptCache()->load(script_path);
+            return script->execute();
         }
-        catch (const std::exception &e)
+        catch (const ShellException &e)
         {
-            std::cerr << "source: " << script_path << ": " << e.what() << std::endl;
-            file.close();
+            // IO 错误的信息中已包含路径
+            if (e.getType() == ExceptionType::IO)
+            {
+                std::cerr << "source: " << e.what() << std::endl;
+            }
+            else if (e.getType() == ExceptionType::SYNTAX)
+            {
+                std::cerr << "source: " << script_path << ": " << e.what() << std::endl;
+            }
+            else
+            {
+                throw;
+            }
             return 1;
         }
-        
-        file.close();
-        return status;
     }
 
     std::string SourceCommand::getName() const
@@ -153,7 +153,7 @@ namespace dash
 
         // 恢复终端设置
         tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-        std::cout << std::endl;
+        std::cout << '\n';
 
         return password;
     }
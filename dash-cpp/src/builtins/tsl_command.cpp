@@ -25,16 +25,16 @@ namespace dash {
 
     int TslCommand::execute(const std::vector<std::string> &args){
         if (args.size() < 2) {
-            std::cout << "tsl: 缺少参数" << std::endl;
+            std::cout << "tsl: 缺少参数" << '\n';
             return 1;
         }else if(args.size() == 2){
             if (args[1] == "-a") {
                 Transaction::outputTransactionInfo();
             } else if (args[1] == "-c") {
-                std::cout << "tsl: 缺少事务名称" << std::endl;
+                std::cout << "tsl: 缺少事务名称" << '\n';
                 return 1;
             } else if (args[1] == "-d") {
-                std::cout << "tsl: 缺少事务名称" << std::endl;
+                std::cout << "tsl: 缺少事务名称" << '\n';
                 return 1;
             } else if (args[1] == "-e") {
                 Transaction::transactionComplete();
@@ -43,7 +43,7 @@ namespace dash {
             }
         }else if (args.size() == 3) {
             if (args[1] == "-a") {
-                std::cout << "tsl: 无效的参数" << std::endl;
+                std::cout << "tsl: 无效的参数" << '\n';
                 return 1;
             }else if (args[1] == "-c") {
                 Transaction::transactionRecord(args[2]);
@@ -54,7 +54,7 @@ namespace dash {
             }else if (args[1] == "-r") {
                 Transaction::transactionStart(args[2]);
             }else{
-                std::cout << "tsl: 无效的参数" << std::endl;
+                std::cout << "tsl: 无效的参数" << '\n';
                 return 1;
             }
         }
@@ -56,7 +56,7 @@ namespace dash
             if (alias_mgr != nullptr && alias_mgr->hasAlias(cmd_name))
             {
                 std::string alias_value = alias_mgr->getAlias(cmd_name);
-                std::cout << cmd_name << " 是别名，展开为 '" << alias_value << "'" << std::endl;
+                std::cout << cmd_name << " 是别名，展开为 '" << alias_value << "'" << '\n';
                 found = true;
                 if (!all_occurrences)
                 {
@@ -68,7 +68,7 @@ namespace dash
             bool is_builtin = shell_->getExecutor()->hasBuiltinCommand(cmd_name);
             if (is_builtin)
             {
-                std::cout << cmd_name << " 是 shell 内置命令" << std::endl;
+                std::cout << cmd_name << " 是 shell 内置命令" << '\n';
                 found = true;
                 if (!all_occurrences)
                 {
@@ -80,7 +80,7 @@ namespace dash
             std::string cmd_path = findCommandPath(cmd_name);
             if (!cmd_path.empty())
             {
-                std::cout << cmd_name << " 是 " << cmd_path << std::endl;
+                std::cout << cmd_name << " 是 " << cmd_path << '\n';
                 found = true;
             }
             
@@ -106,51 +106,8 @@ namespace dash
 
     std::string TypeCommand::findCommandPath(const std::string &command)
     {
-        // 如果命令包含路径分隔符，则直接检查
-        if (command.find('/') != std::string::npos)
-        {
-            if (access(command.c_str(), X_OK) == 0)
-            {
-                return command;
-            }
-            return "";
-        }
-
-        // 获取PATH环境变量
-        const char *path_env = getenv("PATH");
-        if (!path_env)
-        {
-            return "";
-        }
-
-        std::string path_var(path_env);
-        std::string delimiter = ":";
-        size_t pos = 0;
-        std::string token;
-
-        // 遍历PATH中的每个目录
-        while ((pos = path_var.find(delimiter)) != std::string::npos)
-        {
-            token = path_var.substr(0, pos);
-            std::string full_path = token + "/" + command;
-
-            // 检查文件是否存在且可执行
-            if (access(full_path.c_str(), X_OK) == 0)
-            {
-                return full_path;
-            }
-
-            path_var.erase(0, pos + delimiter.length());
-        }
-
-        // 检查最后一个目录
-        std::string full_path = path_var + "/" + command;
-        if (access(full_path.c_str(), X_OK) == 0)
-        {
-            return full_path;
-        }
-
-        return "";
+        // 通过命令路径哈希表查找，结果会被缓存
+        return shell_->getExecutor()->findCommand(command);
     }
 
 } // namespace dash 
\ No newline at end of file
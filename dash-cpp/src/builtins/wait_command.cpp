@@ -4,7 +4,9 @@
  */
 
 #include <iostream>
-#include <stdexcept>
+#include <algorithm>
+#include <cctype>
+#include <signal.h>
 #include "builtins/wait_command.h"
 #include "core/shell.h"
 #include "job/job_control.h"
@@ -13,58 +15,115 @@
 namespace dash
 {
 
+    namespace
+    {
+        // Parse a PID operand; returns -1 if it is not a positive number
+        pid_t parsePid(const std::string &target)
+        {
+            if (target.empty() || target.size() > 9 ||
+                !std::all_of(target.begin(), target.end(), [](unsigned char c) { return std::isdigit(c); }))
+            {
+                return -1;
+            }
+            return static_cast<pid_t>(std::stoi(target));
+        }
+    }
+
     int WaitCommand::execute(const std::vector<std::string> &args)
     {
-        if (!shell_->getJobControl()->isEnabled())
+        JobControl *job_control = shell_->getJobControl();
+
+        bool any = false;
+        size_t start_idx = 1;
+        if (start_idx < args.size() && args[start_idx] == "-n")
+        {
+            any = true;
+            ++start_idx;
+        }
+        if (start_idx < args.size() && args[start_idx] == "--")
         {
-            std::cerr << "wait: job control not enabled" << std::endl;
-            return 1;
+            ++start_idx;
         }
 
         int exit_status = 0;
 
-        if (args.size() == 1)
+        if (any)
         {
-            // Wait for all jobs
-            for (const auto& pair : shell_->getJobControl()->getJobs())
+            // Collect the jobs named by the operands; none means any job
+            std::vector<int> job_ids;
+            for (size_t i = start_idx; i < args.size(); ++i)
             {
-                shell_->getJobControl()->waitForJob(pair.first);
+                const std::string &target = args[i];
+                Job *job = target[0] == '%' ? job_control->resolveJobSpec(target)
+                                            : job_control->findJobByPid(parsePid(target));
+                if (job)
+                {
+                    job_ids.push_back(job->getId());
+                }
+                else
+                {
+                    std::cerr << "wait: " << target << ": no such job" << std::endl;
+                }
+            }
+            if (start_idx < args.size() && job_ids.empty())
+            {
+                return 127;
             }
+
+            int finished = -1;
+            exit_status = job_control->waitForAnyJob(job_ids, finished);
+        }
+        else if (start_idx == args.size())
+        {
+            exit_status = job_control->waitForAllJobs();
         }
         else
         {
-            for (size_t i = 1; i < args.size(); ++i)
+            for (size_t i = start_idx; i < args.size(); ++i)
             {
-                const std::string& target = args[i];
+                const std::string &target = args[i];
                 if (target[0] == '%')
                 {
-                    try
+                    Job *job = job_control->resolveJobSpec(target);
+                    if (!job)
                     {
-                        int job_id = std::stoi(target.substr(1));
-                        exit_status = shell_->getJobControl()->waitForJob(job_id);
+                        std::cerr << "wait: " << target << ": no such job" << std::endl;
+                        exit_status = 127;
+                        continue;
                     }
-                    catch (const std::invalid_argument &e)
+                    exit_status = job_control->waitForJob(job->getId());
+                }
+                else
+                {
+                    pid_t pid = parsePid(target);
+                    if (pid < 0)
                     {
-                        std::cerr << "wait: invalid job ID: " << target << std::endl;
-                        exit_status = 1;
+                        std::cerr << "wait: " << target << ": not a pid or valid job spec" << std::endl;
+                        exit_status = 2;
+                        continue;
                     }
-                    catch (const std::out_of_range &e)
+                    if (!job_control->findJobByPid(pid))
                     {
-                        std::cerr << "wait: job ID out of range: " << target << std::endl;
-                        exit_status = 1;
+                        std::cerr << "wait: pid " << pid << " is not a child of this shell" << std::endl;
+                        exit_status = 127;
+                        continue;
                     }
+                    exit_status = job_control->waitForProcess(pid);
                 }
-                else
+
+                if (exit_status == JobControl::WAIT_INTERRUPTED)
                 {
-                    // Assuming it's a PID, but wait for specific PIDs is not directly supported by JobControl
-                    // For now, we'll just print an error or implement a basic waitpid for it
-                    std::cerr << "wait: waiting for specific PID not fully supported yet: " << target << std::endl;
-                    exit_status = 1;
+                    break;
                 }
             }
         }
 
+        // Interrupted by Ctrl+C: stop waiting, like a command killed by SIGINT
+        if (exit_status == JobControl::WAIT_INTERRUPTED)
+        {
+            return 128 + SIGINT;
+        }
         return exit_status;
     }
 
-} // namespace dash
\ No newline at end of file
+} // namespace dash
@@ -0,0 +1,43 @@
+/**
+ * @file arena.cpp
+ * @brief 语法树内存池实现
+ */
+
+#include "core/arena.h"
+
+namespace dash
+{
+
+    namespace
+    {
+        // 当前生效的内存池
+        thread_local Arena *current_arena = nullptr;
+
+        // 第一块缓冲区的大小，足够容纳一条普通命令行的语法树
+        constexpr std::size_t INITIAL_ARENA_SIZE = 4096;
+    }
+
+    Arena::Arena()
+        : resource_(INITIAL_ARENA_SIZE, std::pmr::new_delete_resource())
+    {
+    }
+
+    Arena *Arena::current()
+    {
+        return current_arena;
+    }
+
+    ArenaScope::ArenaScope(Arena *arena)
+        : previous_(current_arena),
+          previous_resource_(std::pmr::set_default_resource(arena->resource()))
+    {
+        current_arena = arena;
+    }
+
+    ArenaScope::~ArenaScope()
+    {
+        current_arena = previous_;
+        std::pmr::set_default_resource(previous_resource_);
+    }
+
+} // namespace dash
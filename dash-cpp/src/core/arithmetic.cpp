@@ -7,117 +7,597 @@
 #include "../../include/core/shell.h"
 #include "../../include/variable/variable_manager.h"
 #include "../../include/utils/error.h"
-#include <stdexcept>
 #include <cctype>
-#include <stack>
-#include <sstream>
 
 namespace dash {
 
-// 定义算术表达式中的词法单元类型
-enum class ArithTokenType {
-    NUMBER,   // 数字
-    PLUS,     // 加
-    MINUS,    // 减
-    MULTIPLY, // 乘
-    DIVIDE,   // 除
-    MODULO,   // 模
-    LPAREN,   // 左括号
-    RPAREN,   // 右括号
-    VARIABLE, // 变量
-    END       // 结束
-};
+namespace {
 
-// 算术表达式词法单元
-struct ArithToken {
-    ArithTokenType type;
-    std::string value;
-    
-    ArithToken(ArithTokenType t, const std::string& v = "") : type(t), value(v) {}
-};
+/**
+ * @brief 抛出算术表达式错误
+ */
+[[noreturn]] void arithError(ExceptionType type, const std::string& detail) {
+    throw ShellException(type, "算术表达式错误: " + detail);
+}
 
-Arithmetic::Arithmetic(Shell& shell) : shell_(shell) {
-    // 初始化
+bool isNameStart(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
 }
 
-Arithmetic::~Arithmetic() {
-    // 清理资源
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
 }
 
-long Arithmetic::evaluate(const std::string& expression) {
-    if (expression.empty()) {
-        return 0;
+/**
+ * @brief 解析整数常量（十进制、0 开头的八进制、0x 开头的十六进制）
+ *
+ * @param text 文本
+ * @param pos 起始位置，返回时指向数字之后
+ * @param value 结果
+ * @return bool 是否成功
+ */
+bool parseNumber(std::string_view text, size_t& pos, long& value) {
+    unsigned long base = 10;
+    if (text[pos] == '0' && pos + 1 < text.size() && (text[pos + 1] == 'x' || text[pos + 1] == 'X')) {
+        base = 16;
+        pos += 2;
+    } else if (text[pos] == '0') {
+        base = 8;
     }
 
-    try {
-        auto tokens = tokenize(expression);
-        return parse(tokens);
-    } catch (const std::exception& e) {
-        // 转换为Shell异常
-        throw ShellException(ExceptionType::SYNTAX, "算术表达式错误: " + std::string(e.what()));
+    size_t start = pos;
+    unsigned long result = 0;
+    while (pos < text.size() && std::isalnum(static_cast<unsigned char>(text[pos]))) {
+        char c = static_cast<char>(std::tolower(static_cast<unsigned char>(text[pos])));
+        unsigned long digit = std::isdigit(static_cast<unsigned char>(c)) ? static_cast<unsigned long>(c - '0')
+                                                                          : static_cast<unsigned long>(c - 'a' + 10);
+        if (digit >= base) {
+            return false;
+        }
+        result = result * base + digit;
+        ++pos;
     }
+
+    value = static_cast<long>(result);
+    return pos > start || base == 8;
 }
 
-bool Arithmetic::isValid(const std::string& expression) {
-    try {
-        auto tokens = tokenize(expression);
-        parse(tokens);
-        return true;
-    } catch (...) {
-        return false;
-    }
-}
-
-std::vector<Token> Arithmetic::tokenize(const std::string& expression) {
-    // 这是一个简化的实现，仅用于示例
-    // 实际代码需要更健壮的词法分析
-    std::vector<Token> tokens;
-    
-    // 示例: 简单处理表达式
-    for (size_t i = 0; i < expression.length(); ++i) {
-        char c = expression[i];
-        
-        // 跳过空白字符
-        if (std::isspace(c)) {
-            continue;
-        }
-        
-        // 处理数字
-        if (std::isdigit(c)) {
-            std::string number;
-            while (i < expression.length() && (std::isdigit(expression[i]) || expression[i] == '.')) {
-                number += expression[i++];
-            }
-            --i; // 回退一位，因为循环会再自增
-            tokens.push_back(Token(TokenType::WORD, number,0,0));
+/**
+ * @brief 计算二元运算（不含短路运算）
+ *
+ * 加减乘和左移按无符号运算，溢出时回绕而不是未定义行为。
+ */
+long applyBinary(ArithOp op, long x, long y) {
+    unsigned long ux = static_cast<unsigned long>(x);
+    unsigned long uy = static_cast<unsigned long>(y);
+    switch (op) {
+    case ArithOp::MUL: return static_cast<long>(ux * uy);
+    case ArithOp::DIV:
+        if (y == 0) {
+            arithError(ExceptionType::RUNTIME, "除以零");
         }
-        // 处理操作符
-        else if (c == '+' || c == '-' || c == '*' || c == '/' || c == '%' || c == '(' || c == ')') {
-            std::string op(1, c);
-            tokens.push_back(Token(TokenType::OPERATOR, op, 0, 0));
+        return y == -1 ? static_cast<long>(0UL - ux) : x / y;
+    case ArithOp::MOD:
+        if (y == 0) {
+            arithError(ExceptionType::RUNTIME, "除以零");
         }
-        // 处理变量等其他情况...
+        return y == -1 ? 0 : x % y;
+    case ArithOp::ADD: return static_cast<long>(ux + uy);
+    case ArithOp::SUB: return static_cast<long>(ux - uy);
+    case ArithOp::SHL: return static_cast<long>(ux << (uy & 63));
+    case ArithOp::SHR: return x >> (uy & 63);
+    case ArithOp::LT: return x < y;
+    case ArithOp::LE: return x <= y;
+    case ArithOp::GT: return x > y;
+    case ArithOp::GE: return x >= y;
+    case ArithOp::EQ: return x == y;
+    case ArithOp::NE: return x != y;
+    case ArithOp::BIT_AND: return x & y;
+    case ArithOp::BIT_XOR: return x ^ y;
+    case ArithOp::BIT_OR: return x | y;
+    case ArithOp::AND: return x != 0 && y != 0;
+    case ArithOp::OR: return x != 0 || y != 0;
+    case ArithOp::COMMA: return y;
+    default: break;
     }
-    
-    return tokens;
+    arithError(ExceptionType::INTERNAL, "未知运算");
 }
 
-long Arithmetic::parse(const std::vector<Token>& tokens) {
-    // 这是一个简化的实现，仅用于示例
-    // 实际代码需要更复杂的表达式解析
-    
-    // 示例: 非常简单的解析器，仅支持直接返回第一个数字
-    for (const auto& token : tokens) {
-        if (token.getType() == TokenType::WORD) {
+/**
+ * @brief 二元运算符表，优先级越大结合越紧
+ */
+struct BinaryOperator {
+    std::string_view text;
+    ArithOp op;
+    int precedence;
+};
+
+const BinaryOperator binary_operators[] = {
+    {"||", ArithOp::OR, 1},
+    {"&&", ArithOp::AND, 2},
+    {"|", ArithOp::BIT_OR, 3},
+    {"^", ArithOp::BIT_XOR, 4},
+    {"&", ArithOp::BIT_AND, 5},
+    {"==", ArithOp::EQ, 6}, {"!=", ArithOp::NE, 6},
+    {"<", ArithOp::LT, 7}, {"<=", ArithOp::LE, 7}, {">", ArithOp::GT, 7}, {">=", ArithOp::GE, 7},
+    {"<<", ArithOp::SHL, 8}, {">>", ArithOp::SHR, 8},
+    {"+", ArithOp::ADD, 9}, {"-", ArithOp::SUB, 9},
+    {"*", ArithOp::MUL, 10}, {"/", ArithOp::DIV, 10}, {"%", ArithOp::MOD, 10},
+};
+
+/**
+ * @brief 赋值运算符表，NUMBER 表示普通赋值
+ */
+const std::pair<std::string_view, ArithOp> assign_operators[] = {
+    {"=", ArithOp::NUMBER},
+    {"*=", ArithOp::MUL}, {"/=", ArithOp::DIV}, {"%=", ArithOp::MOD},
+    {"+=", ArithOp::ADD}, {"-=", ArithOp::SUB},
+    {"<<=", ArithOp::SHL}, {">>=", ArithOp::SHR},
+    {"&=", ArithOp::BIT_AND}, {"^=", ArithOp::BIT_XOR}, {"|=", ArithOp::BIT_OR},
+};
+
+// 按长度从长到短排列，扫描时取最长匹配
+const std::string_view operator_texts[] = {
+    "<<=", ">>=",
+    "||", "&&", "==", "!=", "<=", ">=", "<<", ">>", "++", "--",
+    "*=", "/=", "%=", "+=", "-=", "&=", "^=", "|=",
+    "+", "-", "*", "/", "%", "<", ">", "=", "!", "~", "&", "^", "|", "?", ":", "(", ")", ",",
+};
+
+} // namespace
+
+/**
+ * @brief 算术表达式解析器，递归下降构建 ArithmeticProgram 的语法树
+ */
+class ArithmeticParser {
+public:
+    ArithmeticParser(std::string_view text, ArithmeticProgram& program)
+        : text_(text), pos_(0), program_(program) {}
+
+    /**
+     * @brief 解析整个表达式，返回根节点下标
+     */
+    uint32_t parse() {
+        next();
+        if (token_.kind == Kind::END) {
+            return number(0);
+        }
+        uint32_t root = parseComma();
+        if (token_.kind != Kind::END) {
+            arithError(ExceptionType::SYNTAX, "意外的符号 '" + std::string(token_.text) + "'");
+        }
+        return root;
+    }
+
+private:
+    enum class Kind { END, NUMBER, NAME, OP };
+
+    struct Tok {
+        Kind kind;
+        std::string_view text;
+        long value;
+    };
+
+    std::string_view text_;
+    size_t pos_;
+    Tok token_{Kind::END, {}, 0};
+    ArithmeticProgram& program_;
+
+    bool isOp(std::string_view op) const {
+        return token_.kind == Kind::OP && token_.text == op;
+    }
+
+    void expectOp(std::string_view op) {
+        if (!isOp(op)) {
+            arithError(ExceptionType::SYNTAX, "缺少 '" + std::string(op) + "'");
+        }
+        next();
+    }
+
+    /**
+     * @brief 读取下一个词法单元（直接切片表达式文本）
+     */
+    void next() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+        if (pos_ >= text_.size()) {
+            token_ = Tok{Kind::END, {}, 0};
+            return;
+        }
+
+        size_t start = pos_;
+        char c = text_[pos_];
+
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            long value = 0;
+            if (!parseNumber(text_, pos_, value)) {
+                while (pos_ < text_.size() && isNameChar(text_[pos_])) {
+                    ++pos_;
+                }
+                arithError(ExceptionType::SYNTAX, "非法数字 '" + std::string(text_.substr(start, pos_ - start)) + "'");
+            }
+            token_ = Tok{Kind::NUMBER, text_.substr(start, pos_ - start), value};
+            return;
+        }
+
+        // $name、${name} 和 $? 等特殊参数按变量名处理
+        if (c == '$' && pos_ + 1 < text_.size()) {
+            char n = text_[pos_ + 1];
+            if (n == '{') {
+                size_t close = text_.find('}', pos_ + 2);
+                if (close == std::string_view::npos) {
+                    arithError(ExceptionType::SYNTAX, "缺少 '}'");
+                }
+                token_ = Tok{Kind::NAME, text_.substr(pos_ + 2, close - pos_ - 2), 0};
+                pos_ = close + 1;
+                return;
+            }
+            if (isNameStart(n)) {
+                ++pos_;
+                start = pos_;
+            } else if (n == '?' || n == '#' || n == '$' || std::isdigit(static_cast<unsigned char>(n))) {
+                pos_ += 2;
+                token_ = Tok{Kind::NAME, text_.substr(start + 1, 1), 0};
+                return;
+            }
+        }
+
+        if (isNameStart(text_[pos_])) {
+            while (pos_ < text_.size() && isNameChar(text_[pos_])) {
+                ++pos_;
+            }
+            token_ = Tok{Kind::NAME, text_.substr(start, pos_ - start), 0};
+            return;
+        }
+
+        for (std::string_view op : operator_texts) {
+            if (text_.compare(pos_, op.size(), op) == 0) {
+                pos_ += op.size();
+                token_ = Tok{Kind::OP, op, 0};
+                return;
+            }
+        }
+
+        arithError(ExceptionType::SYNTAX, "意外的字符 '" + std::string(1, c) + "'");
+    }
+
+    uint32_t add(ArithOp op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0, long value = 0) {
+        program_.nodes_.push_back(ArithmeticProgram::Node{op, ArithOp::NUMBER, a, b, c, value});
+        return static_cast<uint32_t>(program_.nodes_.size() - 1);
+    }
+
+    const ArithmeticProgram::Node& node(uint32_t index) const {
+        return program_.nodes_[index];
+    }
+
+    bool isNumber(uint32_t index) const {
+        return node(index).op == ArithOp::NUMBER;
+    }
+
+    uint32_t number(long value) {
+        return add(ArithOp::NUMBER, 0, 0, 0, value);
+    }
+
+    uint32_t variable(std::string_view name) {
+        auto& vars = program_.vars_;
+        for (uint32_t i = 0; i < vars.size(); ++i) {
+            if (std::string_view(vars[i].name) == name) {
+                return add(ArithOp::VARIABLE, i);
+            }
+        }
+        vars.push_back(ArithmeticProgram::Var{AstString(name), INVALID_VAR_HANDLE});
+        return add(ArithOp::VARIABLE, static_cast<uint32_t>(vars.size() - 1));
+    }
+
+    /**
+     * @brief 构建一元运算节点，操作数为常量时直接折叠
+     */
+    uint32_t unary(ArithOp op, uint32_t a) {
+        if (isNumber(a)) {
+            long v = node(a).value;
+            switch (op) {
+            case ArithOp::NEGATE: return number(static_cast<long>(0UL - static_cast<unsigned long>(v)));
+            case ArithOp::NOT: return number(!v);
+            case ArithOp::BIT_NOT: return number(~v);
+            default: break;
+            }
+        }
+        return add(op, a);
+    }
+
+    /**
+     * @brief 构建二元运算节点，能在编译期确定结果时直接折叠
+     */
+    uint32_t binary(ArithOp op, uint32_t a, uint32_t b) {
+        if (op == ArithOp::AND || op == ArithOp::OR) {
+            // 左侧为常量时短路结果已确定，或者只剩右侧需要求值
+            if (isNumber(a)) {
+                bool left = node(a).value != 0;
+                if (op == ArithOp::AND ? !left : left) {
+                    return number(left);
+                }
+                if (isNumber(b)) {
+                    return number(node(b).value != 0);
+                }
+            }
+            return add(op, a, b);
+        }
+
+        if (op == ArithOp::COMMA && isNumber(a)) {
+            return b;
+        }
+
+        if (isNumber(a) && isNumber(b)) {
             try {
-                return std::stol(token.getValue());
-            } catch (...) {
-                // 不是数字，忽略
+                return number(applyBinary(op, node(a).value, node(b).value));
+            } catch (const ShellException&) {
+                // 除以零等错误留到求值时报告
+            }
+        }
+        return add(op, a, b);
+    }
+
+    uint32_t parseComma() {
+        uint32_t left = parseAssign();
+        while (isOp(",")) {
+            next();
+            left = binary(ArithOp::COMMA, left, parseAssign());
+        }
+        return left;
+    }
+
+    uint32_t parseAssign() {
+        if (token_.kind == Kind::NAME) {
+            // 向前看一个符号判断是否是赋值
+            size_t saved_pos = pos_;
+            Tok saved = token_;
+            next();
+            for (const auto& entry : assign_operators) {
+                if (isOp(entry.first)) {
+                    next();
+                    uint32_t target = variable(saved.text);
+                    uint32_t value = parseAssign();
+                    uint32_t index = add(ArithOp::ASSIGN, node(target).a, value);
+                    program_.nodes_[index].assign_op = entry.second;
+                    return index;
+                }
             }
+            pos_ = saved_pos;
+            token_ = saved;
         }
+        return parseCond();
     }
-    
-    return 0;  // 默认返回0
+
+    uint32_t parseCond() {
+        uint32_t cond = parseBinary(1);
+        if (!isOp("?")) {
+            return cond;
+        }
+        next();
+        uint32_t then_part = parseComma();
+        expectOp(":");
+        uint32_t else_part = parseAssign();
+
+        if (isNumber(cond)) {
+            return node(cond).value != 0 ? then_part : else_part;
+        }
+        return add(ArithOp::COND, cond, then_part, else_part);
+    }
+
+    uint32_t parseBinary(int min_precedence) {
+        uint32_t left = parseUnary();
+        while (token_.kind == Kind::OP) {
+            const BinaryOperator* found = nullptr;
+            for (const auto& entry : binary_operators) {
+                if (token_.text == entry.text) {
+                    found = &entry;
+                    break;
+                }
+            }
+            if (found == nullptr || found->precedence < min_precedence) {
+                break;
+            }
+            next();
+            uint32_t right = parseBinary(found->precedence + 1);
+            left = binary(found->op, left, right);
+        }
+        return left;
+    }
+
+    uint32_t parseUnary() {
+        if (isOp("+")) {
+            next();
+            return parseUnary();
+        }
+        if (isOp("-")) {
+            next();
+            return unary(ArithOp::NEGATE, parseUnary());
+        }
+        if (isOp("!")) {
+            next();
+            return unary(ArithOp::NOT, parseUnary());
+        }
+        if (isOp("~")) {
+            next();
+            return unary(ArithOp::BIT_NOT, parseUnary());
+        }
+        if (isOp("++") || isOp("--")) {
+            ArithOp op = isOp("++") ? ArithOp::PRE_INC : ArithOp::PRE_DEC;
+            next();
+            if (token_.kind != Kind::NAME) {
+                arithError(ExceptionType::SYNTAX, "自增自减的操作数必须是变量");
+            }
+            uint32_t target = variable(token_.text);
+            next();
+            return add(op, node(target).a);
+        }
+        return parsePostfix();
+    }
+
+    uint32_t parsePostfix() {
+        if (token_.kind == Kind::NAME) {
+            std::string_view name = token_.text;
+            next();
+            uint32_t target = variable(name);
+            if (isOp("++") || isOp("--")) {
+                ArithOp op = isOp("++") ? ArithOp::POST_INC : ArithOp::POST_DEC;
+                next();
+                return add(op, node(target).a);
+            }
+            return target;
+        }
+        return parsePrimary();
+    }
+
+    uint32_t parsePrimary() {
+        if (token_.kind == Kind::NUMBER) {
+            long value = token_.value;
+            next();
+            return number(value);
+        }
+        if (isOp("(")) {
+            next();
+            uint32_t inner = parseComma();
+            expectOp(")");
+            return inner;
+        }
+        if (token_.kind == Kind::END) {
+            arithError(ExceptionType::SYNTAX, "表达式不完整");
+        }
+        arithError(ExceptionType::SYNTAX, "意外的符号 '" + std::string(token_.text) + "'");
+    }
+};
+
+ArithmeticProgram::ArithmeticProgram(std::string_view expression) : root_(0) {
+    try {
+        ArithmeticParser parser(expression, *this);
+        root_ = parser.parse();
+    } catch (const ShellException& e) {
+        error_ = e.what();
+        nodes_.clear();
+        vars_.clear();
+    }
+}
+
+bool ArithmeticProgram::isConstant() const {
+    return error_.empty() && nodes_[root_].op == ArithOp::NUMBER;
+}
+
+long ArithmeticProgram::evaluate(VariableManager& variables) const {
+    if (!error_.empty()) {
+        throw ShellException(ExceptionType::SYNTAX, std::string(error_));
+    }
+    return eval(root_, variables);
+}
+
+long ArithmeticProgram::readVar(uint32_t var, VariableManager& variables) const {
+    const Var& entry = vars_[var];
+    if (entry.handle == INVALID_VAR_HANDLE) {
+        entry.handle = variables.resolve(entry.name);
+    }
+    const std::string& text = variables.get(entry.handle);
+
+    // 未设置或为空的变量按 0 处理，允许前后空白和符号
+    size_t pos = 0;
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+        ++pos;
+    }
+    if (pos == text.size()) {
+        return 0;
+    }
+
+    bool negative = false;
+    if (text[pos] == '-' || text[pos] == '+') {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+
+    long value = 0;
+    if (pos >= text.size() || !std::isdigit(static_cast<unsigned char>(text[pos])) ||
+        !parseNumber(text, pos, value)) {
+        arithError(ExceptionType::RUNTIME, "非法数字 '" + text + "'");
+    }
+    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+        ++pos;
+    }
+    if (pos != text.size()) {
+        arithError(ExceptionType::RUNTIME, "非法数字 '" + text + "'");
+    }
+    return negative ? static_cast<long>(0UL - static_cast<unsigned long>(value)) : value;
+}
+
+void ArithmeticProgram::writeVar(uint32_t var, long value, VariableManager& variables) const {
+    variables.set(std::string(vars_[var].name), std::to_string(value));
+}
+
+long ArithmeticProgram::eval(uint32_t index, VariableManager& variables) const {
+    const Node& n = nodes_[index];
+    switch (n.op) {
+    case ArithOp::NUMBER:
+        return n.value;
+    case ArithOp::VARIABLE:
+        return readVar(n.a, variables);
+    case ArithOp::NEGATE:
+        return static_cast<long>(0UL - static_cast<unsigned long>(eval(n.a, variables)));
+    case ArithOp::NOT:
+        return !eval(n.a, variables);
+    case ArithOp::BIT_NOT:
+        return ~eval(n.a, variables);
+    case ArithOp::PRE_INC:
+    case ArithOp::PRE_DEC:
+    case ArithOp::POST_INC:
+    case ArithOp::POST_DEC: {
+        long old_value = readVar(n.a, variables);
+        bool increment = n.op == ArithOp::PRE_INC || n.op == ArithOp::POST_INC;
+        long new_value = applyBinary(increment ? ArithOp::ADD : ArithOp::SUB, old_value, 1);
+        writeVar(n.a, new_value, variables);
+        return (n.op == ArithOp::PRE_INC || n.op == ArithOp::PRE_DEC) ? new_value : old_value;
+    }
+    case ArithOp::AND:
+        return eval(n.a, variables) != 0 && eval(n.b, variables) != 0;
+    case ArithOp::OR:
+        return eval(n.a, variables) != 0 || eval(n.b, variables) != 0;
+    case ArithOp::COND:
+        return eval(n.a, variables) != 0 ? eval(n.b, variables) : eval(n.c, variables);
+    case ArithOp::ASSIGN: {
+        long value = eval(n.b, variables);
+        if (n.assign_op != ArithOp::NUMBER) {
+            value = applyBinary(n.assign_op, readVar(n.a, variables), value);
+        }
+        writeVar(n.a, value, variables);
+        return value;
+    }
+    case ArithOp::COMMA:
+        eval(n.a, variables);
+        return eval(n.b, variables);
+    default:
+        return applyBinary(n.op, eval(n.a, variables), eval(n.b, variables));
+    }
+}
+
+Arithmetic::Arithmetic(Shell& shell) : shell_(shell) {
+    // 初始化
+}
+
+Arithmetic::~Arithmetic() {
+    // 清理资源
+}
+
+const ArithmeticProgram& Arithmetic::compile(const std::string& expression) {
+    auto it = cache_.find(expression);
+    if (it == cache_.end()) {
+        it = cache_.emplace(expression, std::make_unique<ArithmeticProgram>(expression)).first;
+    }
+    return *it->second;
+}
+
+long Arithmetic::evaluate(const std::string& expression) {
+    return compile(expression).evaluate(*shell_.getVariableManager());
+}
+
+bool Arithmetic::isValid(const std::string& expression) {
+    return compile(expression).isValid();
 }
 
-} // namespace dash 
\ No newline at end of file
+} // namespace dash
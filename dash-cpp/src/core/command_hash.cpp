@@ -0,0 +1,161 @@
+/**
+ * @file command_hash.cpp
+ * @brief 命令路径哈希表实现
+ */
+
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "core/command_hash.h"
+
+namespace dash
+{
+
+    namespace
+    {
+        /**
+         * @brief 检查路径是否是可执行的普通文件
+         */
+        bool isExecutableFile(const std::string &path)
+        {
+            struct stat st;
+            return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode) && access(path.c_str(), X_OK) == 0;
+        }
+
+        /**
+         * @brief 按 ':' 拆分 PATH，空项表示当前目录
+         */
+        std::vector<std::string> splitPath(const std::string &path_var)
+        {
+            std::vector<std::string> dirs;
+            size_t start = 0;
+            while (true)
+            {
+                size_t pos = path_var.find(':', start);
+                std::string dir = path_var.substr(start, pos == std::string::npos ? std::string::npos : pos - start);
+                dirs.push_back(dir.empty() ? "." : dir);
+                if (pos == std::string::npos)
+                {
+                    break;
+                }
+                start = pos + 1;
+            }
+            return dirs;
+        }
+    }
+
+    std::string CommandHash::search(const std::string &name, const std::string &path_var)
+    {
+        if (name.find('/') != std::string::npos)
+        {
+            return isExecutableFile(name) ? name : "";
+        }
+
+        for (const auto &dir : splitPath(path_var))
+        {
+            std::string full_path = dir + "/" + name;
+            if (isExecutableFile(full_path))
+            {
+                return full_path;
+            }
+        }
+
+        return "";
+    }
+
+    std::string CommandHash::find(const std::string &name, const std::string &path_var)
+    {
+        if (name.empty())
+        {
+            return "";
+        }
+
+        // 带路径的命令不进入哈希表
+        if (name.find('/') != std::string::npos)
+        {
+            return search(name, path_var);
+        }
+
+        auto it = table_.find(name);
+        if (it != table_.end())
+        {
+            it->second.hits++;
+            return it->second.path;
+        }
+
+        std::string path = search(name, path_var);
+
+        // 相对目录中的结果随 cwd 变化，不缓存
+        if (!path.empty() && path[0] == '/')
+        {
+            table_[name] = Entry{path, 1};
+        }
+
+        return path;
+    }
+
+    bool CommandHash::remove(const std::string &name)
+    {
+        return table_.erase(name) > 0;
+    }
+
+    void CommandHash::clear()
+    {
+        table_.clear();
+        dirs_.clear();
+    }
+
+    std::vector<std::string> CommandHash::complete(const std::string &prefix, const std::string &path_var)
+    {
+        std::vector<std::string> matches;
+
+        for (const auto &dir : splitPath(path_var))
+        {
+            struct stat st;
+            if (stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode))
+            {
+                continue;
+            }
+
+            // 目录未修改时复用上次扫描的结果；相对目录随 cwd 变化，每次重新扫描
+            DirCache scratch;
+            DirCache &cache = dir[0] == '/' ? dirs_[dir] : scratch;
+            if (cache.dir.empty() || cache.mtime != st.st_mtime)
+            {
+                cache.dir = dir;
+                cache.mtime = st.st_mtime;
+                cache.names.clear();
+
+                DIR *dp = opendir(dir.c_str());
+                if (dp != nullptr)
+                {
+                    struct dirent *entry;
+                    while ((entry = readdir(dp)) != nullptr)
+                    {
+                        std::string entry_name = entry->d_name;
+                        if (entry_name == "." || entry_name == "..")
+                        {
+                            continue;
+                        }
+                        if (isExecutableFile(dir + "/" + entry_name))
+                        {
+                            cache.names.push_back(entry_name);
+                        }
+                    }
+                    closedir(dp);
+                }
+            }
+
+            for (const auto &entry_name : cache.names)
+            {
+                if (entry_name.compare(0, prefix.length(), prefix) == 0)
+                {
+                    matches.push_back(entry_name);
+                }
+            }
+        }
+
+        return matches;
+    }
+
+} // namespace dash
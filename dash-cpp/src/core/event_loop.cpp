@@ -0,0 +1,344 @@
+/**
+ * @file event_loop.cpp
+ * @brief 交互模式的事件循环实现
+ */
+
+#include <cerrno>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include "core/event_loop.h"
+
+namespace dash
+{
+
+    namespace
+    {
+        // epoll 事件数据的高 32 位区分来源，进程事件的低 32 位是进程 ID
+        constexpr uint64_t INPUT_TAG = 1ull << 32;
+        constexpr uint64_t SIGNAL_TAG = 2ull << 32;
+        constexpr uint64_t PROCESS_TAG = 3ull << 32;
+        constexpr uint64_t TAG_MASK = ~0xFFFFFFFFull;
+
+        constexpr unsigned EVENT_INTERRUPT = 1u;
+        constexpr unsigned EVENT_CHILD = 2u;
+        constexpr unsigned EVENT_ERROR = ~0u;
+
+        constexpr int MAX_EVENTS = 16;
+
+        // fork 出的子进程恢复的信号掩码
+        sigset_t g_child_mask;
+        bool g_restore_child_mask = false;
+
+        // 当前进程是否是 fork 出的子进程：epoll 实例与父进程共享，不能再使用
+        bool g_forked_child = false;
+
+        void restoreChildMask()
+        {
+            g_forked_child = true;
+            if (g_restore_child_mask)
+            {
+                g_restore_child_mask = false;
+                sigprocmask(SIG_SETMASK, &g_child_mask, nullptr);
+            }
+        }
+
+        int pidfdOpen(pid_t pid)
+        {
+#ifdef SYS_pidfd_open
+            return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+            (void)pid;
+            errno = ENOSYS;
+            return -1;
+#endif
+        }
+    }
+
+    EventLoop::EventLoop()
+        : epoll_fd_(-1), signal_fd_(-1), input_fd_(-1)
+    {
+        sigemptyset(&saved_mask_);
+    }
+
+    EventLoop::~EventLoop()
+    {
+        close();
+    }
+
+    bool EventLoop::open()
+    {
+        if (isOpen())
+        {
+            return true;
+        }
+
+        static bool atfork_registered = false;
+        if (!atfork_registered)
+        {
+            pthread_atfork(nullptr, nullptr, restoreChildMask);
+            atfork_registered = true;
+        }
+
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGCHLD);
+        sigaddset(&mask, SIGINT);
+        if (sigprocmask(SIG_BLOCK, &mask, &saved_mask_) < 0)
+        {
+            return false;
+        }
+
+        signal_fd_ = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = SIGNAL_TAG;
+        if (signal_fd_ < 0 || epoll_fd_ < 0 ||
+            epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, signal_fd_, &event) < 0)
+        {
+            close();
+            return false;
+        }
+
+        g_child_mask = saved_mask_;
+        g_restore_child_mask = true;
+        return true;
+    }
+
+    bool EventLoop::isOpen() const
+    {
+        return epoll_fd_ >= 0 && !g_forked_child;
+    }
+
+    void EventLoop::close()
+    {
+        for (const auto &entry : pidfds_)
+        {
+            ::close(entry.second);
+        }
+        pidfds_.clear();
+        exited_.clear();
+
+        if (epoll_fd_ >= 0)
+        {
+            ::close(epoll_fd_);
+            epoll_fd_ = -1;
+        }
+        if (signal_fd_ >= 0)
+        {
+            ::close(signal_fd_);
+            signal_fd_ = -1;
+            // 打开时屏蔽的信号可能已经挂起，恢复掩码后按原处理函数递送
+            sigprocmask(SIG_SETMASK, &saved_mask_, nullptr);
+        }
+        input_fd_ = -1;
+        g_restore_child_mask = false;
+    }
+
+    unsigned EventLoop::poll(int timeout, bool &readable)
+    {
+        struct epoll_event events[MAX_EVENTS];
+        int count;
+        do
+        {
+            count = epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout);
+        } while (count < 0 && errno == EINTR);
+
+        if (count < 0)
+        {
+            return EVENT_ERROR;
+        }
+
+        unsigned result = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            uint64_t data = events[i].data.u64;
+            switch (data & TAG_MASK)
+            {
+            case INPUT_TAG:
+                readable = true;
+                break;
+            case SIGNAL_TAG:
+            {
+                // 同一信号挂起多次只会读到一次，因此每批只分发一次
+                struct signalfd_siginfo info[8];
+                ssize_t n;
+                while ((n = read(signal_fd_, info, sizeof(info))) > 0)
+                {
+                    for (size_t j = 0; j < static_cast<size_t>(n) / sizeof(info[0]); ++j)
+                    {
+                        result |= info[j].ssi_signo == SIGINT ? EVENT_INTERRUPT : EVENT_CHILD;
+                    }
+                }
+                break;
+            }
+            case PROCESS_TAG:
+            {
+                // 进程退出后 pidfd 一直可读，触发一次即移除
+                pid_t pid = static_cast<pid_t>(data & 0xFFFFFFFFu);
+                unwatchProcess(pid);
+                exited_.push_back(pid);
+                result |= EVENT_CHILD;
+                break;
+            }
+            }
+        }
+
+        return result;
+    }
+
+    void EventLoop::deliver(unsigned events, const SignalCallback &onSignal)
+    {
+        if (!onSignal)
+        {
+            return;
+        }
+        if (events & EVENT_INTERRUPT)
+        {
+            onSignal(SIGINT);
+        }
+        if (events & EVENT_CHILD)
+        {
+            onSignal(SIGCHLD);
+        }
+    }
+
+    void EventLoop::dispatch(int signo)
+    {
+        if (callback_)
+        {
+            callback_(signo);
+        }
+    }
+
+    bool EventLoop::waitReadable(int fd, const SignalCallback &onSignal)
+    {
+        if (fd != input_fd_)
+        {
+            struct epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.u64 = INPUT_TAG;
+            if (input_fd_ >= 0)
+            {
+                epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, input_fd_, nullptr);
+            }
+            if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0)
+            {
+                input_fd_ = -1;
+                return false;
+            }
+            input_fd_ = fd;
+        }
+
+        while (true)
+        {
+            bool readable = false;
+            unsigned events = poll(-1, readable);
+            if (events == EVENT_ERROR)
+            {
+                return false;
+            }
+            deliver(events, onSignal);
+            if (readable)
+            {
+                return true;
+            }
+        }
+    }
+
+    int EventLoop::waitSignal()
+    {
+        // 先把输入描述符移出集合，否则提前键入的内容会让 epoll 一直返回；
+        // 下次 waitReadable 时会重新加入
+        if (input_fd_ >= 0)
+        {
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, input_fd_, nullptr);
+            input_fd_ = -1;
+        }
+
+        while (true)
+        {
+            bool readable = false;
+            unsigned events = poll(-1, readable);
+            if (events == EVENT_ERROR)
+            {
+                return -1;
+            }
+            if (events & EVENT_INTERRUPT)
+            {
+                return SIGINT;
+            }
+            if (events & EVENT_CHILD)
+            {
+                return SIGCHLD;
+            }
+        }
+    }
+
+    void EventLoop::dispatchPending()
+    {
+        if (!isOpen())
+        {
+            return;
+        }
+
+        bool readable = false;
+        unsigned events = poll(0, readable);
+        if (events != EVENT_ERROR)
+        {
+            deliver(events, callback_);
+        }
+    }
+
+    void EventLoop::watchProcess(pid_t pid)
+    {
+        if (!isOpen() || pid <= 0)
+        {
+            return;
+        }
+
+        unwatchProcess(pid);
+
+        int fd = pidfdOpen(pid);
+        if (fd < 0)
+        {
+            return;
+        }
+
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.u64 = PROCESS_TAG | static_cast<uint32_t>(pid);
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            ::close(fd);
+            return;
+        }
+        pidfds_[pid] = fd;
+    }
+
+    void EventLoop::unwatchProcess(pid_t pid)
+    {
+        auto it = pidfds_.find(pid);
+        if (it == pidfds_.end() || !isOpen())
+        {
+            return;
+        }
+
+        // 子进程可能继承了同一描述符，关闭前显式从 epoll 移除
+        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second, nullptr);
+        ::close(it->second);
+        pidfds_.erase(it);
+    }
+
+    std::vector<pid_t> EventLoop::takeExitedProcesses()
+    {
+        std::vector<pid_t> exited;
+        exited.swap(exited_);
+        return exited;
+    }
+
+} // namespace dash
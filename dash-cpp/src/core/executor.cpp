@@ -8,12 +8,17 @@
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <spawn.h>
+#include <signal.h>
 #include <cstring>
 #include <algorithm>
 #include <cerrno>
+#include <sstream>
+#include <unordered_set>
 #include "core/executor.h"
 #include "core/shell.h"
 #include "core/node.h"
+#include "core/output.h"
 #include "job/job_control.h"
 #include "utils/error.h"
 #include "variable/variable_manager.h"
@@ -37,12 +42,19 @@
 #include "builtins/alias_command.h"
 #include "builtins/unalias_command.h"
 #include "builtins/type_command.h"
+#include "builtins/hash_command.h"
+#include "builtins/kill_command.h"
+#include "builtins/wait_command.h"
+#include "builtins/par_command.h"
+#include "builtins/return_command.h"
+
+extern char **environ;
 
 namespace dash
 {
 
     Executor::Executor(Shell *shell)
-        : shell_(shell), last_status_(0)
+        : shell_(shell), last_status_(0), function_depth_(0), return_requested_(false)
     {
         registerBuiltins();
     }
@@ -51,6 +63,12 @@ namespace dash
     {
     }
 
+    void Executor::setLastStatus(int status)
+    {
+        last_status_ = status;
+        shell_->getVariableManager()->setLastStatus(status);
+    }
+
     int Executor::execute(const Node *node)
     {
         if (!node)
@@ -96,75 +114,110 @@ namespace dash
                 status = executeSubshell(static_cast<const SubshellNode *>(node));
                 break;
 
+            case NodeType::FUNCTION:
+                status = defineFunction(static_cast<const FunctionNode *>(node));
+                break;
+
             default:
                 throw ShellException(ExceptionType::INTERNAL, "Unknown node type");
             }
 
-            last_status_ = status;
+            setLastStatus(status);
             return status;
         }
         catch (const ShellException &e)
         {
             DebugLog::logCommand(e.getTypeString() + ": " + e.what());
-            last_status_ = 1;
+            setLastStatus(1);
             return 1;
         }
         catch (const std::exception &e)
         {
             DebugLog::logCommand("Error: " + std::string(e.what()));
-            last_status_ = 1;
+            setLastStatus(1);
             return 1;
         }
     }
 
-    int Executor::executeCommand(const CommandNode *command)
+    std::vector<std::string> Executor::expandArgs(const CommandNode *command)
     {
-        // 获取命令参数
-        std::vector<std::string> args = command->getArgs();
-        if (args.empty())
+        // 对所有参数求值解析时编译好的展开程序，再做路径名展开
+        VariableManager *variables = shell_->getVariableManager();
+        const auto &programs = command->getArgPrograms();
+        const auto &globs = command->getArgGlobs();
+        std::vector<std::string> args;
+        args.reserve(programs.size());
+        for (size_t i = 0; i < programs.size(); ++i)
         {
-            // 如果只有变量赋值，则设置变量
-            for (const auto &assignment : command->getAssignments())
-            {
-                size_t pos = assignment.find('=');
-                if (pos != std::string::npos)
-                {
-                    std::string name = assignment.substr(0, pos);
-                    std::string value = assignment.substr(pos + 1);
-                    // 对赋值的值进行变量展开
-                    value = shell_->getVariableManager()->expand(value);
-                    shell_->getVariableManager()->set(name, value);
-                }
-            }
-            return 0;
+            globs[i].expand(variables->evaluate(programs[i]), args);
         }
+        return args;
+    }
 
-        // 获取命令名
-        // 对所有参数进行变量展开
-        for (auto &arg : args)
+    std::vector<std::string> Executor::expandAssignments(const CommandNode *command)
+    {
+        const auto &assignments = command->getAssignments();
+        const auto &programs = command->getAssignmentPrograms();
+
+        std::vector<std::string> entries;
+        entries.reserve(assignments.size());
+        for (size_t i = 0; i < assignments.size(); ++i)
         {
-            arg = shell_->getVariableManager()->expand(arg);
+            size_t pos = assignments[i].find('=');
+            if (pos != std::string::npos)
+            {
+                std::string entry(assignments[i], 0, pos + 1);
+                entry += shell_->getVariableManager()->evaluate(programs[i]);
+                entries.push_back(std::move(entry));
+            }
         }
-        
-        std::string cmd_name = args[0];
+        return entries;
+    }
 
-        // 处理变量赋值
-        for (const auto &assignment : command->getAssignments())
+    void Executor::applyAssignments(const CommandNode *command, int flags)
+    {
+        const auto &assignments = command->getAssignments();
+        const auto &programs = command->getAssignmentPrograms();
+        for (size_t i = 0; i < assignments.size(); ++i)
         {
-            size_t pos = assignment.find('=');
+            size_t pos = assignments[i].find('=');
             if (pos != std::string::npos)
             {
-                std::string name = assignment.substr(0, pos);
-                std::string value = assignment.substr(pos + 1);
+                std::string name(assignments[i], 0, pos);
                 // 对赋值的值进行变量展开
-                value = shell_->getVariableManager()->expand(value);
-                shell_->getVariableManager()->set(name, value, Variable::VAR_NONE); // 临时变量
+                std::string value = shell_->getVariableManager()->evaluate(programs[i]);
+                shell_->getVariableManager()->set(name, value, flags);
             }
         }
+    }
+
+    int Executor::executeCommand(const CommandNode *command)
+    {
+        if (command->getArgs().empty())
+        {
+            // 如果只有变量赋值，则设置变量
+            applyAssignments(command, Variable::VAR_NONE);
+            return 0;
+        }
+
+        // 获取命令名
+        std::vector<std::string> args = expandArgs(command);
+        
+        std::string cmd_name = args[0];
+
+        // 函数优先于内置命令
+        if (isFunction(cmd_name))
+        {
+            return callFunction(command, args);
+        }
 
         // 检查是否是内置命令
-        if (isBuiltin(cmd_name))
+        uint8_t slot = builtinSlot(command, cmd_name);
+        if (slot != NO_BUILTIN)
         {
+            // 处理变量赋值
+            applyAssignments(command, Variable::VAR_NONE);
+
             // 设置重定向
             std::unordered_map<int, int> saved_fds;
             bool redirect_success = applyRedirections(command->getRedirections(), saved_fds);
@@ -175,10 +228,11 @@ namespace dash
             }
 
             // 执行内置命令
-            int status = executeBuiltin(cmd_name, args);
+            int status = executeBuiltin(slot, args);
 
             // 恢复重定向
             restoreRedirections(saved_fds);
+            OutputBuffer::commandBoundary();
 
             return status;
         }
@@ -192,179 +246,322 @@ namespace dash
             args.pop_back(); // 移除 &
         }
         
-        // 执行外部命令
-        return executeExternalCommand(cmd_name, args, command->getRedirections(), background);
+        // 前缀赋值只叠加到子进程的环境中，不修改 shell 变量（后台作业也一样）
+        std::vector<std::string> env_overlay = expandAssignments(command);
+        return executeExternalCommand(cmd_name, args, command->getRedirections(), background, env_overlay);
     }
 
-    int Executor::executePipe(const PipeNode *pipe_node)
+    int Executor::defineFunction(const FunctionNode *function)
     {
-        DebugLog::logExecutor("执行管道命令, 后台标志: " + std::string(pipe_node->isBackground() ? "是" : "否"));
-        
-        // 如果是后台运行，创建作业
-        if (pipe_node->isBackground())
+        // 函数表共享定义节点的函数体和内存池，重新定义时旧函数体随之释放
+        functions_[std::string(function->getName())] = Function{function->getArena(), function->getBody()};
+        return 0;
+    }
+
+    bool Executor::isFunction(const std::string &command) const
+    {
+        return !functions_.empty() && functions_.find(command) != functions_.end();
+    }
+
+    int Executor::callFunction(const CommandNode *command, const std::vector<std::string> &args)
+    {
+        // 持有一份引用，函数体执行期间即使重新定义自身也保持有效
+        Function function = functions_.at(args[0]);
+
+        applyAssignments(command, Variable::VAR_NONE);
+
+        std::unordered_map<int, int> saved_fds;
+        if (!applyRedirections(command->getRedirections(), saved_fds))
         {
-            // 创建作业
-            // 这里需要实现作业控制
-            // 暂时简单实现，后续完善
-            pid_t pid = fork();
+            return 1;
+        }
 
-            if (pid == -1)
+        // 交换位置参数，不复制调用者的参数
+        VariableManager *variables = shell_->getVariableManager();
+        std::vector<std::string> params(args.begin() + 1, args.end());
+        variables->swapPositional(params);
+
+        ++function_depth_;
+        int status = execute(function.body.get());
+        --function_depth_;
+        return_requested_ = false;
+
+        variables->swapPositional(params);
+        restoreRedirections(saved_fds);
+        return status;
+    }
+
+    bool Executor::isUnwinding() const
+    {
+        return return_requested_ || shell_->isExitRequested();
+    }
+
+    void Executor::collectPipeline(const Node *node, std::vector<const Node *> &stages)
+    {
+        // 沿 PipeNode 链展开为扁平的阶段列表（左侧在前）
+        if (node->getType() == NodeType::PIPE)
+        {
+            const auto *pipe_node = static_cast<const PipeNode *>(node);
+            collectPipeline(pipe_node->getLeft(), stages);
+            if (pipe_node->getRight())
             {
-                throw ShellException(ExceptionType::SYSTEM, "Failed to fork process");
+                collectPipeline(pipe_node->getRight(), stages);
             }
-            else if (pid == 0)
+        }
+        else
+        {
+            stages.push_back(node);
+        }
+    }
+
+    int Executor::executePipe(const PipeNode *pipe_node)
+    {
+        // 将整条管道展开为 N 个叶子阶段
+        std::vector<const Node *> stages;
+        collectPipeline(pipe_node, stages);
+
+        if (stages.size() == 1)
+        {
+            // 只有左侧命令
+            return execute(stages[0]);
+        }
+
+        // 后台标志可能位于管道节点上，也可能被解析器放在最后一个命令上
+        bool background = pipe_node->isBackground();
+        if (stages.back()->getType() == NodeType::COMMAND &&
+            static_cast<const CommandNode *>(stages.back())->isBackground())
+        {
+            background = true;
+        }
+
+        DebugLog::logExecutor("执行管道命令, 阶段数: " + std::to_string(stages.size()) +
+                              ", 后台标志: " + std::string(background ? "是" : "否"));
+
+        // 一次性创建全部 N-1 个管道
+        size_t npipes = stages.size() - 1;
+        std::vector<int> pipefds(npipes * 2, -1);
+        for (size_t i = 0; i < npipes; ++i)
+        {
+            if (::pipe(&pipefds[i * 2]) == -1)
             {
-                // 子进程
-                // 执行管道
-                if (pipe_node->getRight())
+                for (int fd : pipefds)
                 {
-                    // 创建管道
-                    int pipefd[2];
-                    if (::pipe(pipefd) == -1)
+                    if (fd != -1)
                     {
-                        std::cerr << "Failed to create pipe" << std::endl;
-                        exit(1);
+                        close(fd);
                     }
+                }
+                throw ShellException(ExceptionType::SYSTEM, "Failed to create pipe");
+            }
+        }
 
-                    // 创建左侧命令的子进程
-                    pid_t left_pid = fork();
+        // fork 前刷新缓冲区，避免子进程重复输出
+        std::cout.flush();
+        std::cerr.flush();
 
-                    if (left_pid == -1)
+        // 恰好 fork N 个叶子进程
+        std::vector<pid_t> pids;
+        pids.reserve(stages.size());
+        pid_t pgid = 0;
+
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            int in_fd = i > 0 ? pipefds[(i - 1) * 2] : -1;
+            int out_fd = i < npipes ? pipefds[i * 2 + 1] : -1;
+
+            // 简单外部命令走 posix_spawn 快速路径，前缀赋值叠加到环境中
+            const CommandNode *spawn_cmd = nullptr;
+            std::vector<std::string> spawn_args;
+            std::vector<std::string> spawn_overlay;
+            std::vector<char *> spawn_envp;
+            if (stages[i]->getType() == NodeType::COMMAND)
+            {
+                const auto *command = static_cast<const CommandNode *>(stages[i]);
+                if (!command->getArgs().empty())
+                {
+                    spawn_args = expandArgs(command);
+                    if (!spawn_args.empty() && builtinSlot(command, spawn_args[0]) == NO_BUILTIN &&
+                        !isFunction(spawn_args[0]))
                     {
-                        std::cerr << "Failed to fork process" << std::endl;
-                        exit(1);
+                        spawn_cmd = command;
+                        spawn_overlay = expandAssignments(command);
                     }
-                    else if (left_pid == 0)
+                }
+            }
+
+            char *const *envp = spawn_cmd ? shell_->getVariableManager()->getEnvp(spawn_overlay, spawn_envp) : nullptr;
+            if (spawn_cmd)
+            {
+                pid_t spawned = spawnExternal(spawn_args, spawn_cmd->getRedirections(), envp, in_fd, out_fd, pipefds,
+                                              background ? pgid : -1);
+                if (spawned != -1)
+                {
+                    if (pgid == 0)
                     {
-                        // 左侧命令的子进程
-                        // 关闭读取端
-                        close(pipefd[0]);
+                        pgid = spawned;
+                    }
+                    pids.push_back(spawned);
+                    continue;
+                }
+            }
 
-                        // 将标准输出重定向到管道写入端
-                        dup2(pipefd[1], STDOUT_FILENO);
-                        close(pipefd[1]);
+            pid_t pid = fork();
 
-                        // 执行左侧命令
-                        exit(execute(pipe_node->getLeft()));
-                    }
+            if (pid == -1)
+            {
+                std::cerr << "dash: fork: " << strerror(errno) << std::endl;
+                break;
+            }
+            else if (pid == 0)
+            {
+                // 子进程
+                if (background)
+                {
+                    setpgid(0, pgid);
+                }
 
-                    // 创建右侧命令的子进程
-                    pid_t right_pid = fork();
+                // 连接本阶段的输入输出
+                if (in_fd != -1)
+                {
+                    dup2(in_fd, STDIN_FILENO);
+                }
+                if (out_fd != -1)
+                {
+                    dup2(out_fd, STDOUT_FILENO);
+                }
 
-                    if (right_pid == -1)
+                // 关闭所有管道描述符
+                for (int fd : pipefds)
+                {
+                    close(fd);
+                }
+
+                if (spawn_cmd)
+                {
+                    // spawn 失败后的回退，参数已在父进程中展开
+                    std::unordered_map<int, int> saved_fds;
+                    if (!applyRedirections(spawn_cmd->getRedirections(), saved_fds))
                     {
-                        std::cerr << "Failed to fork process" << std::endl;
                         exit(1);
                     }
-                    else if (right_pid == 0)
-                    {
-                        // 右侧命令的子进程
-                        // 关闭写入端
-                        close(pipefd[1]);
-
-                        // 将标准输入重定向到管道读取端
-                        dup2(pipefd[0], STDIN_FILENO);
-                        close(pipefd[0]);
+                    exec_in_child(spawn_args[0], spawn_args, envp);
+                }
 
-                        // 执行右侧命令
-                        exit(execute(pipe_node->getRight()));
-                    }
+                execPipelineStage(stages[i]);
+            }
 
-                    // 父进程关闭管道的两端
-                    close(pipefd[0]);
-                    close(pipefd[1]);
+            // 父进程
+            if (background)
+            {
+                // 子进程中也会设置，这里可能失败
+                setpgid(pid, pgid == 0 ? pid : pgid);
+            }
+            if (pgid == 0)
+            {
+                pgid = pid;
+            }
+            pids.push_back(pid);
+        }
 
-                    // 等待左侧命令完成
-                    int status;
-                    waitpid(left_pid, &status, 0);
+        // 父进程关闭所有管道
+        for (int fd : pipefds)
+        {
+            close(fd);
+        }
 
-                    // 等待右侧命令完成
-                    waitpid(right_pid, &status, 0);
+        if (pids.empty())
+        {
+            throw ShellException(ExceptionType::SYSTEM, "Failed to fork process");
+        }
 
-                    exit(WEXITSTATUS(status));
+        if (background)
+        {
+            // 整条管道作为一个作业登记
+            std::string cmd_text;
+            for (size_t i = 0; i < stages.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    cmd_text += " | ";
                 }
-                else
+                if (stages[i]->getType() == NodeType::COMMAND)
                 {
-                    // 只有左侧命令
-                    exit(execute(pipe_node->getLeft()));
+                    const auto &stage_args = static_cast<const CommandNode *>(stages[i])->getArgs();
+                    for (size_t j = 0; j < stage_args.size(); ++j)
+                    {
+                        cmd_text += (j > 0 ? " " : "") + stage_args[j];
+                    }
                 }
             }
 
-            // 父进程
-            std::cout << "[" << pid << "] " << "Background job started" << std::endl;
+            registerBackgroundJob(cmd_text, pgid, pids);
             return 0;
         }
 
-        // 前台运行
-        if (pipe_node->getRight())
+        // 前台运行：作为一个整体等待全部阶段，返回最后一个阶段的状态
+        int status = 0;
+        for (size_t i = 0; i < pids.size(); ++i)
         {
-            // 创建管道
-            int pipefd[2];
-            if (::pipe(pipefd) == -1)
+            int child_status = 0;
+            while (waitpid(pids[i], &child_status, 0) == -1 && errno == EINTR)
             {
-                throw ShellException(ExceptionType::SYSTEM, "Failed to create pipe");
             }
 
-            // 创建左侧命令的子进程
-            pid_t left_pid = fork();
-
-            if (left_pid == -1)
+            if (i == pids.size() - 1)
             {
-                throw ShellException(ExceptionType::SYSTEM, "Failed to fork process");
+                if (WIFEXITED(child_status))
+                {
+                    status = WEXITSTATUS(child_status);
+                }
+                else if (WIFSIGNALED(child_status))
+                {
+                    status = 128 + WTERMSIG(child_status);
+                }
             }
-            else if (left_pid == 0)
-            {
-                // 左侧命令的子进程
-                // 关闭读取端
-                close(pipefd[0]);
-
-                // 将标准输出重定向到管道写入端
-                dup2(pipefd[1], STDOUT_FILENO);
-                close(pipefd[1]);
+        }
 
-                // 执行左侧命令
-                exit(execute(pipe_node->getLeft()));
-            }
+        // 如果 fork 中途失败，管道不完整
+        if (pids.size() != stages.size())
+        {
+            return 1;
+        }
 
-            // 创建右侧命令的子进程
-            pid_t right_pid = fork();
+        return status;
+    }
 
-            if (right_pid == -1)
-            {
-                throw ShellException(ExceptionType::SYSTEM, "Failed to fork process");
-            }
-            else if (right_pid == 0)
+    void Executor::execPipelineStage(const Node *node)
+    {
+        // 简单外部命令直接在叶子进程中 exec，不再额外 fork
+        if (node->getType() == NodeType::COMMAND)
+        {
+            const auto *command = static_cast<const CommandNode *>(node);
+            if (!command->getArgs().empty())
             {
-                // 右侧命令的子进程
-                // 关闭写入端
-                close(pipefd[1]);
+                std::vector<std::string> args = expandArgs(command);
+                if (!args.empty() && builtinSlot(command, args[0]) == NO_BUILTIN && !isFunction(args[0]))
+                {
+                    applyAssignments(command, Variable::VAR_EXPORT);
 
-                // 将标准输入重定向到管道读取端
-                dup2(pipefd[0], STDIN_FILENO);
-                close(pipefd[0]);
+                    std::unordered_map<int, int> saved_fds;
+                    if (!applyRedirections(command->getRedirections(), saved_fds))
+                    {
+                        exit(1);
+                    }
 
-                // 执行右侧命令
-                exit(execute(pipe_node->getRight()));
+                    exec_in_child(args[0], args);
+                }
             }
-
-            // 父进程关闭管道的两端
-            close(pipefd[0]);
-            close(pipefd[1]);
-
-            // 等待左侧命令完成
-            int status;
-            waitpid(left_pid, &status, 0);
-
-            // 等待右侧命令完成
-            waitpid(right_pid, &status, 0);
-
-            return WEXITSTATUS(status);
         }
-        else
+
+        // 内置命令和复合命令在本进程内执行；execute 会吞掉 exit 抛出的异常，
+        // 请求退出时以 exit 设置的状态结束
+        int status = execute(node);
+        if (shell_->isExitRequested())
         {
-            // 只有左侧命令
-            return execute(pipe_node->getLeft());
+            status = shell_->getExitStatus();
         }
+        std::cout.flush();
+        exit(status);
     }
 
     int Executor::executeList(const ListNode *list)
@@ -376,23 +573,29 @@ namespace dash
 
         for (size_t i = 0; i < commands.size(); ++i)
         {
-            // 执行当前命令
-            status = execute(commands[i].get());
-
-            // 根据操作符决定是否继续执行
-            if (i < operators.size())
+            // 根据当前命令之前的操作符决定是否执行（operators[i] 位于命令 i 之前）
+            if (i > 0 && i < operators.size())
             {
                 if (operators[i] == "&&" && status != 0)
                 {
-                    // && 操作符，如果前一个命令失败，则跳过后续命令
-                    break;
+                    // && 操作符，如果前一个命令失败，则跳过当前命令
+                    continue;
                 }
                 else if (operators[i] == "||" && status == 0)
                 {
-                    // || 操作符，如果前一个命令成功，则跳过后续命令
-                    break;
+                    // || 操作符，如果前一个命令成功，则跳过当前命令
+                    continue;
                 }
             }
+
+            // 执行当前命令
+            status = execute(commands[i].get());
+
+            // exit 或 return 已被请求，不再执行后续命令
+            if (isUnwinding())
+            {
+                break;
+            }
         }
 
         return status;
@@ -402,6 +605,10 @@ namespace dash
     {
         // 执行条件
         int condition_status = execute(if_node->getCondition());
+        if (isUnwinding())
+        {
+            return condition_status;
+        }
 
         // 如果条件为真（状态码为0），执行 then 部分
         if (condition_status == 0)
@@ -422,8 +629,16 @@ namespace dash
         int status = 0;
 
         // 获取循环变量和单词列表
-        const std::string &var = for_node->getVar();
-        const auto &words = for_node->getWords();
+        const std::string var(for_node->getVar());
+        const auto &programs = for_node->getWordPrograms();
+        const auto &globs = for_node->getWordGlobs();
+
+        // 展开单词列表
+        std::vector<std::string> words;
+        for (size_t i = 0; i < programs.size(); ++i)
+        {
+            globs[i].expand(shell_->getVariableManager()->evaluate(programs[i]), words);
+        }
 
         // 遍历单词列表
         for (const auto &word : words)
@@ -434,6 +649,11 @@ namespace dash
             // 执行循环体
             status = execute(for_node->getBody());
 
+            if (isUnwinding())
+            {
+                break;
+            }
+
             // 如果循环体中有 break 或 continue 命令，需要处理
             // 暂时简单实现，后续完善
         }
@@ -449,6 +669,11 @@ namespace dash
         {
             // 执行条件
             int condition_status = execute(while_node->getCondition());
+            if (isUnwinding())
+            {
+                status = condition_status;
+                break;
+            }
 
             // 根据条件和循环类型决定是否执行循环体
             bool execute_body = false;
@@ -472,6 +697,11 @@ namespace dash
             // 执行循环体
             status = execute(while_node->getBody());
 
+            if (isUnwinding())
+            {
+                break;
+            }
+
             // 如果循环体中有 break 或 continue 命令，需要处理
             // 暂时简单实现，后续完善
         }
@@ -483,11 +713,8 @@ namespace dash
     {
         int status = 0;
 
-        // 获取匹配词
-        std::string word = case_node->getWord();
-
-        // 替换变量
-        // 暂时简单实现，后续完善
+        // 获取匹配词并替换变量
+        std::string word = shell_->getVariableManager()->evaluate(case_node->getWordProgram());
 
         // 遍历 case 项
         for (const auto &item : case_node->getItems())
@@ -495,12 +722,31 @@ namespace dash
             // 检查是否匹配
             bool matched = false;
 
-            for (const auto &pattern : item->patterns)
+            // | 分隔的各个模式依次尝试，任一匹配即可
+            for (const auto &pattern : item.matchers)
             {
-                // 简单实现，后续完善为正则匹配
-                if (pattern == word || pattern == "*")
+                if (pattern.parts.empty())
+                {
+                    matched = pattern.matcher.matches(word);
+                }
+                else
+                {
+                    // 含展开的模式：展开后拼成模式文本，双引号内的结果按字面匹配
+                    std::string text;
+                    for (const auto &part : pattern.parts)
+                    {
+                        if (part.program.isLiteral())
+                        {
+                            text += part.text;
+                            continue;
+                        }
+                        std::string value = shell_->getVariableManager()->evaluate(part.program);
+                        text += part.quoted ? PatternMatcher::escape(value) : value;
+                    }
+                    matched = PatternMatcher(text).matches(word);
+                }
+                if (matched)
                 {
-                    matched = true;
                     break;
                 }
             }
@@ -508,7 +754,7 @@ namespace dash
             if (matched)
             {
                 // 执行匹配项的命令
-                status = execute(item->commands.get());
+                status = execute(item.commands.get());
                 break;
             }
         }
@@ -518,6 +764,9 @@ namespace dash
 
     int Executor::executeSubshell(const SubshellNode *subshell)
     {
+        // fork 前刷新缓冲区，避免子进程重复输出
+        std::cout.flush();
+
         // 创建子进程
         pid_t pid = fork();
 
@@ -538,8 +787,12 @@ namespace dash
                 exit(1);
             }
 
-            // 执行命令
+            // 执行命令；子 shell 中的 exit 只结束子进程，退出状态取 exit 设置的值
             int status = execute(subshell->getCommands());
+            if (shell_->isExitRequested())
+            {
+                status = shell_->getExitStatus();
+            }
 
             // 恢复重定向
             restoreRedirections(saved_fds);
@@ -548,21 +801,32 @@ namespace dash
         }
 
         // 父进程等待子进程完成
-        int status;
-        waitpid(pid, &status, 0);
+        int status = 0;
+        while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+        {
+        }
 
+        if (WIFSIGNALED(status))
+        {
+            return 128 + WTERMSIG(status);
+        }
         return WEXITSTATUS(status);
     }
 
-    bool Executor::applyRedirections(const std::vector<Redirection> &redirections, std::unordered_map<int, int> &saved_fds)
+    bool Executor::applyRedirections(const AstVector<Redirection> &redirections, std::unordered_map<int, int> &saved_fds)
     {
+        // 已缓冲的输出属于重定向之前的目标
+        if (!redirections.empty())
+        {
+            std::cout.flush();
+        }
+
         for (const auto &redir : redirections)
         {
             int fd = redir.fd;
-            std::string filename = redir.filename;
-            
+
             // 对文件名进行变量展开
-            filename = shell_->getVariableManager()->expand(filename);
+            std::string filename = shell_->getVariableManager()->evaluate(redir.program);
 
             // 保存原始文件描述符
             int saved_fd = dup(fd);
@@ -672,6 +936,12 @@ namespace dash
 
     void Executor::restoreRedirections(std::unordered_map<int, int> &saved_fds)
     {
+        // 重定向期间的输出要写到重定向的目标
+        if (!saved_fds.empty())
+        {
+            std::cout.flush();
+        }
+
         for (const auto &pair : saved_fds)
         {
             dup2(pair.second, pair.first);
@@ -681,7 +951,70 @@ namespace dash
         saved_fds.clear();
     }
 
-    void Executor::exec_in_child(const std::string &command, const std::vector<std::string> &args) {
+    bool Executor::isPureBuiltin(const std::string &command) const
+    {
+        // 只输出信息、不改变 shell 状态的内置命令
+        static const std::unordered_set<std::string> pure_builtins = {
+            "echo", "pwd", "type", "help"};
+        return pure_builtins.count(command) > 0 && isBuiltin(command) && !isFunction(command);
+    }
+
+    bool Executor::runCaptured(const Node *node, std::string &output, int &status)
+    {
+        // 解析器总是返回列表节点，只接受其中的单条命令
+        if (node->getType() == NodeType::LIST)
+        {
+            const auto *list = static_cast<const ListNode *>(node);
+            if (list->getCommands().size() != 1)
+            {
+                return false;
+            }
+            node = list->getCommands()[0].get();
+        }
+
+        if (node->getType() != NodeType::COMMAND)
+        {
+            return false;
+        }
+
+        const auto *command = static_cast<const CommandNode *>(node);
+        if (command->getArgs().empty() || !command->getAssignments().empty() ||
+            !command->getRedirections().empty() || command->isBackground())
+        {
+            return false;
+        }
+
+        // 命令名必须是字面量，避免为判断命令名而多做一次展开
+        const std::string name(command->getArgs()[0]);
+        if (name.find_first_of("$`") != std::string::npos || !isPureBuiltin(name))
+        {
+            return false;
+        }
+
+        // 将 std::cout 临时指向内存缓冲区
+        std::ostringstream buffer;
+        std::streambuf *saved = std::cout.rdbuf(buffer.rdbuf());
+        try
+        {
+            status = execute(command);
+        }
+        catch (...)
+        {
+            std::cout.rdbuf(saved);
+            throw;
+        }
+        std::cout.rdbuf(saved);
+
+        output = buffer.str();
+        return true;
+    }
+
+    std::string Executor::findCommand(const std::string &command)
+    {
+        return command_hash_.find(command, shell_->getVariableManager()->get("PATH"));
+    }
+
+    void Executor::exec_in_child(const std::string &command, const std::vector<std::string> &args, char *const *envp) {
         std::vector<char *> c_args;
         c_args.reserve(args.size() + 1);
         for (const auto &arg : args) {
@@ -689,6 +1022,14 @@ namespace dash
         }
         c_args.push_back(nullptr);
 
+        // 子进程即将 exec，直接换上 shell 导出变量的环境（execvp 也据此搜索 PATH）
+        environ = const_cast<char **>(envp ? envp : shell_->getVariableManager()->getEnvp());
+
+        // 优先使用哈希表中的路径，失败时回退到 execvp（处理无 #! 的脚本等情况）
+        std::string path = findCommand(command);
+        if (!path.empty()) {
+            execv(path.c_str(), c_args.data());
+        }
         execvp(command.c_str(), c_args.data());
         // 如果 execvp 返回，则表示执行失败
         std::cerr << "Failed to execute command: " << command << std::endl;
@@ -696,194 +1037,368 @@ namespace dash
     }
 
     int Executor::executeExternalCommand(const std::string &command, const std::vector<std::string> &args,
-                                         const std::vector<Redirection> &redirections, bool background)
+                                         const AstVector<Redirection> &redirections, bool background,
+                                         const std::vector<std::string> &env_overlay)
     {
-        // 获取Shell实例和后台任务适配器
-        Shell* shell = getShell();
-        if (background && shell) {
-            // 使用后台任务适配器来执行后台任务
-            // 使用后台任务适配器来执行后台任务
-            std::vector<std::string> bg_args = args; // 创建副本
-            return shell->executeBackground(command, bg_args);
+        if (background)
+        {
+            return spawnBackground(args, redirections, env_overlay);
         }
 
-        // 创建子进程
-        pid_t pid = fork();
+        // 快速路径：posix_spawn 不复制 shell 的页表
+        std::vector<char *> envp_buffer;
+        char *const *envp = shell_->getVariableManager()->getEnvp(env_overlay, envp_buffer);
+        pid_t pid = spawnExternal(args, redirections, envp);
 
         if (pid == -1)
         {
-            throw ShellException(ExceptionType::SYSTEM, "Failed to fork process");
-        }
-        else if (pid == 0)
-        {
-            // 子进程
-            // 设置重定向
-            std::unordered_map<int, int> saved_fds;
-            bool redirect_success = applyRedirections(redirections, saved_fds);
+            // 慢速路径：fork + exec，由它输出与原来一致的错误信息
+            std::cout.flush();
+            pid = fork();
 
-            if (!redirect_success)
+            if (pid == -1)
             {
-                exit(1);
+                throw ShellException(ExceptionType::SYSTEM, "Failed to fork process");
             }
+            else if (pid == 0)
+            {
+                // 子进程
+                // 设置重定向
+                std::unordered_map<int, int> saved_fds;
+                bool redirect_success = applyRedirections(redirections, saved_fds);
 
-            exec_in_child(command, args);
+                if (!redirect_success)
+                {
+                    exit(1);
+                }
+
+                exec_in_child(command, args, envp);
+            }
         }
 
         // 父进程
-        int status;
-        waitpid(pid, &status, 0);
+        int status = 0;
+        while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+        {
+        }
 
+        if (WIFSIGNALED(status))
+        {
+            return 128 + WTERMSIG(status);
+        }
         return WEXITSTATUS(status);
     }
 
-    bool Executor::isBuiltin(const std::string &command) const
+    int Executor::spawnBackground(const std::vector<std::string> &args, const AstVector<Redirection> &redirections,
+                                  const std::vector<std::string> &env_overlay)
     {
-        return builtins_.find(command) != builtins_.end();
-    }
+        int null_fd = -1;
+        if (!shell_->getJobControl()->isEnabled())
+        {
+            null_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        }
 
-    int Executor::executeBuiltin(const std::string &command, const std::vector<std::string> &args)
-    {
-        auto it = builtins_.find(command);
-        if (it != builtins_.end())
+        pid_t pid;
+        try
+        {
+            pid = startExternal(args, redirections, null_fd, -1, env_overlay);
+        }
+        catch (...)
         {
-            return it->second(args);
+            if (null_fd != -1)
+            {
+                close(null_fd);
+            }
+            throw;
         }
 
-        return 1;
-    }
+        if (null_fd != -1)
+        {
+            close(null_fd);
+        }
 
-    bool Executor::hasBuiltinCommand(const std::string &command) const
-    {
-        return isBuiltin(command);
+        std::string cmd_text;
+        for (size_t i = 0; i < args.size(); ++i)
+        {
+            cmd_text += (i > 0 ? " " : "") + args[i];
+        }
+        registerBackgroundJob(cmd_text, pid, {pid});
+        return 0;
     }
 
-    void Executor::registerBuiltins()
+    pid_t Executor::startExternal(const std::vector<std::string> &args, const AstVector<Redirection> &redirections,
+                                  int in_fd, int out_fd, const std::vector<std::string> &env_overlay)
     {
-        // 创建内置命令对象
-        auto cd_cmd = std::make_shared<CdCommand>(shell_);
-        auto echo_cmd = std::make_shared<EchoCommand>(shell_);
-        auto exit_cmd = std::make_shared<ExitCommand>(shell_);
-        auto pwd_cmd = std::make_shared<PwdCommand>(shell_);
-        auto jobs_cmd = std::make_shared<JobsCommand>(shell_);
-        auto fg_cmd = std::make_shared<FgCommand>(shell_);
-        auto bg_cmd = std::make_shared<BgCommand>(shell_);
-        auto history_cmd = std::make_shared<HistoryCommand>(shell_);
-        auto help_cmd = std::make_shared<HelpCommand>(shell_);
-        auto debug_cmd = std::make_shared<DebugCommand>(shell_);
-        auto source_cmd = std::make_shared<SourceCommand>(shell_);
-        auto sprf_cmd = std::make_shared<SprfCommand>(shell_);
-        auto tsl_cmd = std::make_shared<TslCommand>(shell_);
-        auto otr_cmd = std::make_shared<OtrCommand>(shell_);
-        auto su_cmd = std::make_shared<SuCommand>(shell_);
-        auto alias_cmd = std::make_shared<AliasCommand>(shell_);
-        auto unalias_cmd = std::make_shared<UnaliasCommand>(shell_);
-        auto type_cmd = std::make_shared<TypeCommand>(shell_);
+        std::vector<char *> envp_buffer;
+        char *const *envp = shell_->getVariableManager()->getEnvp(env_overlay, envp_buffer);
 
+        // fork 前刷新缓冲区，避免子进程重复输出
+        std::cout.flush();
+        std::cerr.flush();
 
-        // 保存内置命令对象
-        builtin_commands_.push_back(cd_cmd);
-        builtin_commands_.push_back(echo_cmd);
-        builtin_commands_.push_back(exit_cmd);
-        builtin_commands_.push_back(pwd_cmd);
-        builtin_commands_.push_back(jobs_cmd);
-        builtin_commands_.push_back(fg_cmd);
-        builtin_commands_.push_back(bg_cmd);
-        builtin_commands_.push_back(history_cmd);
-        builtin_commands_.push_back(help_cmd);
-        builtin_commands_.push_back(debug_cmd);
-        builtin_commands_.push_back(source_cmd);
-        builtin_commands_.push_back(sprf_cmd);
-        builtin_commands_.push_back(tsl_cmd);
-        builtin_commands_.push_back(otr_cmd);
-        builtin_commands_.push_back(su_cmd);
-        builtin_commands_.push_back(alias_cmd);
-        builtin_commands_.push_back(unalias_cmd);
-        builtin_commands_.push_back(type_cmd);
-
-        // 注册内置命令
-        builtins_[cd_cmd->getName()] = [cd_cmd](const std::vector<std::string> &args) -> int
+        pid_t pid = spawnExternal(args, redirections, envp, in_fd, out_fd, {}, 0);
+        if (pid != -1)
         {
-            return cd_cmd->execute(args);
-        };
+            return pid;
+        }
 
-        builtins_[echo_cmd->getName()] = [echo_cmd](const std::vector<std::string> &args) -> int
+        // 慢速路径：fork + exec，由它输出与原来一致的错误信息
+        pid = fork();
+        if (pid == -1)
         {
-            return echo_cmd->execute(args);
-        };
-
-        builtins_[exit_cmd->getName()] = [exit_cmd](const std::vector<std::string> &args) -> int
+            throw ShellException(ExceptionType::SYSTEM, "Failed to fork process");
+        }
+        else if (pid == 0)
         {
-            return exit_cmd->execute(args);
-        };
+            setpgid(0, 0);
+            if (in_fd != -1)
+            {
+                dup2(in_fd, STDIN_FILENO);
+            }
+            if (out_fd != -1)
+            {
+                dup2(out_fd, STDOUT_FILENO);
+            }
 
-        builtins_[pwd_cmd->getName()] = [pwd_cmd](const std::vector<std::string> &args) -> int
-        {
-            return pwd_cmd->execute(args);
-        };
+            std::unordered_map<int, int> saved_fds;
+            if (!applyRedirections(redirections, saved_fds))
+            {
+                exit(1);
+            }
+            exec_in_child(args[0], args, envp);
+        }
 
-        builtins_[jobs_cmd->getName()] = [jobs_cmd](const std::vector<std::string> &args) -> int
+        // 子进程中也会设置，这里可能失败
+        setpgid(pid, pid);
+        return pid;
+    }
+
+    void Executor::registerBackgroundJob(const std::string &command, pid_t pgid, const std::vector<pid_t> &pids)
+    {
+        JobControl *job_control = shell_->getJobControl();
+        int job_id = job_control->addJob(command, pgid);
+        for (pid_t pid : pids)
         {
-            return jobs_cmd->execute(args);
-        };
+            job_control->addProcess(job_id, pid, command);
+        }
+        job_control->setCurrentJobId(job_id);
 
-        builtins_[fg_cmd->getName()] = [fg_cmd](const std::vector<std::string> &args) -> int
+        std::cout << "[" << job_id << "] " << pids.back() << std::endl;
+    }
+
+    pid_t Executor::spawnExternal(const std::vector<std::string> &args, const AstVector<Redirection> &redirections,
+                                  char *const *envp, int in_fd, int out_fd, const std::vector<int> &close_fds, pid_t pgid)
+    {
+        if (args.empty())
         {
-            return fg_cmd->execute(args);
-        };
+            return -1;
+        }
 
-        builtins_[bg_cmd->getName()] = [bg_cmd](const std::vector<std::string> &args) -> int
+        // 先在父进程中展开所有重定向文件名
+        std::vector<std::string> filenames;
+        filenames.reserve(redirections.size());
+        for (const auto &redir : redirections)
         {
-            return bg_cmd->execute(args);
-        };
+            filenames.push_back(shell_->getVariableManager()->evaluate(redir.program));
+        }
 
-        builtins_[history_cmd->getName()] = [history_cmd](const std::vector<std::string> &args) -> int
+        posix_spawn_file_actions_t actions;
+        posix_spawnattr_t attr;
+        if (posix_spawn_file_actions_init(&actions) != 0)
         {
-            return history_cmd->execute(args);
-        };
-        builtins_[sprf_cmd->getName()] = [sprf_cmd](const std::vector<std::string> &args) -> int
+            return -1;
+        }
+        if (posix_spawnattr_init(&attr) != 0)
         {
-            return sprf_cmd->execute(args);
-        };
+            posix_spawn_file_actions_destroy(&actions);
+            return -1;
+        }
 
-        builtins_[help_cmd->getName()] = [help_cmd](const std::vector<std::string> &args) -> int
-        {
-            return help_cmd->execute(args);
-        };
+        bool ok = true;
 
-        builtins_[debug_cmd->getName()] = [debug_cmd](const std::vector<std::string> &args) -> int
+        // 管道端口，顺序与 fork 路径相同：先连接管道，再应用重定向
+        if (in_fd != -1)
         {
-            return debug_cmd->execute(args);
-        };
-
-        builtins_[source_cmd->getName()] = [source_cmd](const std::vector<std::string> &args) -> int
+            ok = ok && posix_spawn_file_actions_adddup2(&actions, in_fd, STDIN_FILENO) == 0;
+        }
+        if (out_fd != -1)
         {
-            return source_cmd->execute(args);
-        };
-         builtins_[tsl_cmd->getName()] = [tsl_cmd](const std::vector<std::string> &args) -> int
+            ok = ok && posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO) == 0;
+        }
+        for (int fd : close_fds)
         {
-            return tsl_cmd->execute(args);
-        };
-         builtins_[otr_cmd->getName()] = [otr_cmd](const std::vector<std::string> &args) -> int
+            ok = ok && posix_spawn_file_actions_addclose(&actions, fd) == 0;
+        }
+
+        // 将 applyRedirections 支持的重定向翻译为文件动作
+        for (size_t i = 0; ok && i < redirections.size(); ++i)
         {
-            return otr_cmd->execute(args);
-        };
-         builtins_[su_cmd->getName()] = [su_cmd](const std::vector<std::string> &args) -> int
+            const Redirection &redir = redirections[i];
+            const std::string &filename = filenames[i];
+
+            switch (redir.type)
+            {
+            case RedirType::REDIR_INPUT:
+                ok = posix_spawn_file_actions_addopen(&actions, redir.fd, filename.c_str(), O_RDONLY, 0) == 0;
+                break;
+
+            case RedirType::REDIR_OUTPUT:
+                ok = posix_spawn_file_actions_addopen(&actions, redir.fd, filename.c_str(),
+                                                      O_WRONLY | O_CREAT | O_TRUNC, 0666) == 0;
+                break;
+
+            case RedirType::REDIR_APPEND:
+                ok = posix_spawn_file_actions_addopen(&actions, redir.fd, filename.c_str(),
+                                                      O_WRONLY | O_CREAT | O_APPEND, 0666) == 0;
+                break;
+
+            case RedirType::REDIR_INPUT_DUP:
+            case RedirType::REDIR_OUTPUT_DUP:
+                if (filename == "-")
+                {
+                    ok = posix_spawn_file_actions_addclose(&actions, redir.fd) == 0;
+                }
+                else
+                {
+                    char *end = nullptr;
+                    long target_fd = strtol(filename.c_str(), &end, 10);
+                    ok = !filename.empty() && *end == '\0' &&
+                         posix_spawn_file_actions_adddup2(&actions, static_cast<int>(target_fd), redir.fd) == 0;
+                }
+                break;
+
+            case RedirType::REDIR_HEREDOC:
+                // Here 文档暂未实现，与 applyRedirections 保持一致
+                break;
+            }
+        }
+
+        // 子进程使用空信号掩码，并恢复作业控制相关信号的默认处理
+        sigset_t mask;
+        sigemptyset(&mask);
+        posix_spawnattr_setsigmask(&attr, &mask);
+
+        sigset_t defaults;
+        sigemptyset(&defaults);
+        sigaddset(&defaults, SIGINT);
+        sigaddset(&defaults, SIGQUIT);
+        sigaddset(&defaults, SIGTSTP);
+        sigaddset(&defaults, SIGTTIN);
+        sigaddset(&defaults, SIGTTOU);
+        sigaddset(&defaults, SIGPIPE);
+        posix_spawnattr_setsigdefault(&attr, &defaults);
+
+        short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+        if (pgid != -1)
         {
-            return su_cmd->execute(args);
-        };
-         builtins_[alias_cmd->getName()] = [alias_cmd](const std::vector<std::string> &args) -> int
+            posix_spawnattr_setpgroup(&attr, pgid);
+            flags |= POSIX_SPAWN_SETPGROUP;
+        }
+        posix_spawnattr_setflags(&attr, flags);
+
+        pid_t pid = -1;
+        std::string path = ok ? findCommand(args[0]) : "";
+        if (!path.empty())
         {
-            return alias_cmd->execute(args);
-        };
-        builtins_[unalias_cmd->getName()] = [unalias_cmd](const std::vector<std::string> &args) -> int
+            std::vector<char *> c_args;
+            c_args.reserve(args.size() + 1);
+            for (const auto &arg : args)
+            {
+                c_args.push_back(const_cast<char *>(arg.c_str()));
+            }
+            c_args.push_back(nullptr);
+
+            // 刷新缓冲区，避免输出顺序错乱
+            std::cout.flush();
+
+            int err = posix_spawn(&pid, path.c_str(), &actions, &attr, c_args.data(), envp);
+            if (err == ENOENT && access(path.c_str(), X_OK) != 0 && command_hash_.remove(args[0]))
+            {
+                // 缓存的路径已不存在，重新查找一次
+                path = findCommand(args[0]);
+                err = path.empty() ? ENOENT : posix_spawn(&pid, path.c_str(), &actions, &attr, c_args.data(), envp);
+            }
+            if (err != 0)
+            {
+                DebugLog::logExecutor("posix_spawn 失败: " + args[0] + ": " + strerror(err));
+                pid = -1;
+            }
+        }
+
+        posix_spawnattr_destroy(&attr);
+        posix_spawn_file_actions_destroy(&actions);
+
+        return pid;
+    }
+
+    bool Executor::isBuiltin(const std::string &command) const
+    {
+        return lookupBuiltin(command) != NO_BUILTIN;
+    }
+
+    uint8_t Executor::builtinSlot(const CommandNode *command, const std::string &name)
+    {
+        uint8_t slot = command->getBuiltinSlot();
+        return slot == UNRESOLVED_BUILTIN ? lookupBuiltin(name) : slot;
+    }
+
+    int Executor::executeBuiltin(uint8_t slot, const std::vector<std::string> &args)
+    {
+        return builtins_[slot]->execute(args);
+    }
+
+    bool Executor::hasBuiltinCommand(const std::string &command) const
+    {
+        return isBuiltin(command);
+    }
+
+    template <typename T>
+    void Executor::installBuiltin()
+    {
+        auto command = std::make_unique<T>(shell_);
+        uint8_t slot = lookupBuiltin(command->getName());
+        if (slot == NO_BUILTIN)
         {
-            return unalias_cmd->execute(args);
-        };
+            throw ShellException(ExceptionType::INTERNAL, "Builtin missing from dispatch table: " + command->getName());
+        }
+        builtins_[slot] = std::move(command);
+    }
 
-        builtins_[type_cmd->getName()] = [type_cmd](const std::vector<std::string> &args) -> int
+    void Executor::registerBuiltins()
+    {
+        // 注册内置命令，每个对象放入 BUILTIN_NAMES 中同名的槽位
+        installBuiltin<CdCommand>();
+        installBuiltin<EchoCommand>();
+        installBuiltin<ExitCommand>();
+        installBuiltin<PwdCommand>();
+        installBuiltin<JobsCommand>();
+        installBuiltin<FgCommand>();
+        installBuiltin<BgCommand>();
+        installBuiltin<HistoryCommand>();
+        installBuiltin<SprfCommand>();
+        installBuiltin<HelpCommand>();
+        installBuiltin<DebugCommand>();
+        installBuiltin<SourceCommand>();
+        installBuiltin<TslCommand>();
+        installBuiltin<OtrCommand>();
+        installBuiltin<SuCommand>();
+        installBuiltin<AliasCommand>();
+        installBuiltin<UnaliasCommand>();
+        installBuiltin<TypeCommand>();
+        installBuiltin<HashCommand>();
+        installBuiltin<KillCommand>();
+        installBuiltin<WaitCommand>();
+        installBuiltin<ParCommand>();
+        installBuiltin<ReturnCommand>();
+
+        for (size_t slot = 0; slot < BUILTIN_COUNT; ++slot)
         {
-            return type_cmd->execute(args);
-        };
+            if (!builtins_[slot])
+            {
+                throw ShellException(ExceptionType::INTERNAL,
+                                     "Builtin not registered: " + std::string(BUILTIN_NAMES[slot]));
+            }
+        }
 
         // TODO: 添加更多内置命令
     }
@@ -7,7 +7,8 @@
 #include "../../include/core/shell.h"
 #include "../../include/variable/variable_manager.h"
 #include "../../include/core/arithmetic.h"
-#include <glob.h>
+#include "../../include/core/glob.h"
+#include "../../include/core/pattern.h"
 #include <pwd.h>
 #include <unistd.h>
 #include <sys/types.h>
@@ -75,15 +76,7 @@ std::vector<std::string> Expand::expandPathname(const std::string& pattern) {
         return result;
     }
     
-    glob_t globbuf;
-    int flags = GLOB_NOCHECK;
-    
-    if (glob(pattern.c_str(), flags, nullptr, &globbuf) == 0) {
-        for (size_t i = 0; i < globbuf.gl_pathc; ++i) {
-            result.push_back(globbuf.gl_pathv[i]);
-        }
-        globfree(&globbuf);
-    }
+    GlobPattern(pattern, false).expand(pattern, result);
     
     return result;
 }
@@ -233,26 +226,8 @@ std::string Expand::expandCommand(const std::string& command) {
 
 std::string Expand::expandArithmetic(const std::string& expression) {
     // 使用算术处理类计算表达式
-    long result = 0;
-    try {
-        // 在实际实现中，应该调用Arithmetic类来计算表达式
-        // Arithmetic类尚未完全实现，这里使用临时占位代码
-        result = 0;  // 临时占位
-        
-        // 简单处理表达式以消除未使用参数警告
-        if (!expression.empty()) {
-            // 尝试将表达式转换为数字，如果可能的话
-            try {
-                result = std::stol(expression);
-            } catch (...) {
-                // 忽略转换错误
-            }
-        }
-    } catch (const std::exception& e) {
-        throw std::runtime_error("算术表达式错误: " + std::string(e.what()));
-    }
-    
-    return std::to_string(result);
+    Arithmetic arithmetic(shell_);
+    return std::to_string(arithmetic.evaluate(expression));
 }
 
 std::string Expand::handleQuotes(const std::string& str) {
@@ -290,22 +265,7 @@ std::string Expand::handleQuotes(const std::string& str) {
 }
 
 bool Expand::matchPattern(const std::string& pattern, const std::string& str) {
-    // 简单的通配符匹配实现
-    // 实际实现应该使用更健壮的方法，如正则表达式或fnmatch
-    
-    // 这里添加一个简单的实现以消除未使用参数警告
-    if (pattern.empty() && str.empty()) {
-        return true;
-    } else if (pattern == "*") {
-        return true;  // 星号匹配任何内容
-    } else if (pattern == "?" && str.length() == 1) {
-        return true;  // 问号匹配单个字符
-    } else if (pattern == str) {
-        return true;  // 精确匹配
-    }
-    
-    // 此处仅作为占位符，实际应该实现完整的通配符匹配逻辑
-    return false;
+    return PatternMatcher(pattern).matches(str);
 }
 
 std::vector<std::string> Expand::splitWords(const std::string& str) {
@@ -0,0 +1,276 @@
+/**
+ * @file glob.cpp
+ * @brief 路径名展开（通配符匹配）实现
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "core/glob.h"
+
+namespace dash
+{
+
+    namespace
+    {
+        constexpr size_t DIRENT_BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * @brief 目录描述符的 RAII 包装
+         */
+        class DirFd
+        {
+        public:
+            explicit DirFd(int fd) : fd_(fd) {}
+            ~DirFd()
+            {
+                if (fd_ >= 0)
+                {
+                    close(fd_);
+                }
+            }
+            DirFd(const DirFd &) = delete;
+            DirFd &operator=(const DirFd &) = delete;
+            int get() const { return fd_; }
+
+        private:
+            int fd_;
+        };
+
+        /**
+         * @brief 按名字打开子目录
+         */
+        int openDirectory(int dirfd, const char *name)
+        {
+            return openat(dirfd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        }
+
+        /**
+         * @brief 判断目录项是否是目录（d_type 不可靠时回退到 fstatat）
+         */
+        bool isDirectory(int dirfd, const char *name, unsigned char type)
+        {
+            if (type == DT_DIR)
+            {
+                return true;
+            }
+            if (type != DT_UNKNOWN && type != DT_LNK)
+            {
+                return false;
+            }
+            struct stat st;
+            return fstatat(dirfd, name, &st, 0) == 0 && S_ISDIR(st.st_mode);
+        }
+    }
+
+    GlobPattern::GlobPattern()
+        : mode_(Mode::NONE), absolute_(false), dir_only_(false)
+    {
+    }
+
+    GlobPattern::GlobPattern(std::string_view word, bool quoted)
+        : mode_(Mode::NONE), absolute_(false), dir_only_(false)
+    {
+        // 引号的位置在词法分析后已丢失，整个单词按带引号处理
+        if (quoted)
+        {
+            return;
+        }
+
+        if (word.find_first_of("$`") != std::string_view::npos)
+        {
+            mode_ = Mode::DYNAMIC;
+        }
+        else if (PatternMatcher::hasMeta(word))
+        {
+            mode_ = Mode::STATIC;
+            compile(word);
+        }
+    }
+
+    void GlobPattern::compile(std::string_view pattern)
+    {
+        absolute_ = !pattern.empty() && pattern.front() == '/';
+        dir_only_ = pattern.size() > 1 && pattern.back() == '/';
+
+        size_t start = 0;
+        while (start <= pattern.size())
+        {
+            size_t slash = pattern.find('/', start);
+            size_t end = slash == std::string_view::npos ? pattern.size() : slash;
+
+            // 连续的 '/' 以及首尾的 '/' 不产生分量
+            if (end > start)
+            {
+                components_.emplace_back(pattern.substr(start, end - start));
+            }
+
+            if (slash == std::string_view::npos)
+            {
+                break;
+            }
+            start = slash + 1;
+        }
+    }
+
+    void GlobPattern::walk(int dirfd, std::string &path, size_t index, std::vector<std::string> &results) const
+    {
+        const PatternMatcher &component = components_[index];
+        bool last = index + 1 == components_.size();
+        size_t path_length = path.size();
+
+        // 字面分量：直接定位，不读取目录
+        if (component.isLiteral())
+        {
+            const char *name = component.getLiteral().c_str();
+            if (last)
+            {
+                struct stat st;
+                bool exists = dir_only_ ? fstatat(dirfd, name, &st, 0) == 0 && S_ISDIR(st.st_mode)
+                                        : fstatat(dirfd, name, &st, AT_SYMLINK_NOFOLLOW) == 0;
+                if (exists)
+                {
+                    results.push_back(path + name + (dir_only_ ? "/" : ""));
+                }
+                return;
+            }
+
+            DirFd child(openDirectory(dirfd, name));
+            if (child.get() >= 0)
+            {
+                path.append(name).push_back('/');
+                walk(child.get(), path, index + 1, results);
+                path.resize(path_length);
+            }
+            return;
+        }
+
+        // 通配分量：读取整个目录，逐项匹配
+        DirFd scan(dirfd == AT_FDCWD ? open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC) : openDirectory(dirfd, "."));
+        if (scan.get() < 0)
+        {
+            return;
+        }
+
+        std::vector<std::pair<std::string, unsigned char>> matches;
+        std::vector<char> buffer(DIRENT_BUFFER_SIZE);
+        while (true)
+        {
+            ssize_t nread = getdents64(scan.get(), buffer.data(), buffer.size());
+            if (nread <= 0)
+            {
+                break;
+            }
+            for (ssize_t offset = 0; offset < nread;)
+            {
+                auto *entry = reinterpret_cast<struct dirent64 *>(buffer.data() + offset);
+                offset += entry->d_reclen;
+                std::string_view name(entry->d_name);
+
+                // 以 '.' 开头的名字只能被显式的 '.' 匹配
+                if (name[0] == '.' && !component.hasLeadingDot())
+                {
+                    continue;
+                }
+                if (component.matches(name))
+                {
+                    matches.emplace_back(std::string(name), entry->d_type);
+                }
+            }
+        }
+
+        for (const auto &match : matches)
+        {
+            const std::string &name = match.first;
+            if (last)
+            {
+                if (!dir_only_)
+                {
+                    results.push_back(path + name);
+                }
+                else if (isDirectory(scan.get(), name.c_str(), match.second))
+                {
+                    results.push_back(path + name + "/");
+                }
+                continue;
+            }
+
+            if (match.second != DT_DIR && match.second != DT_LNK && match.second != DT_UNKNOWN)
+            {
+                continue;
+            }
+            DirFd child(openDirectory(scan.get(), name.c_str()));
+            if (child.get() >= 0)
+            {
+                path.append(name).push_back('/');
+                walk(child.get(), path, index + 1, results);
+                path.resize(path_length);
+            }
+        }
+    }
+
+    bool GlobPattern::run(std::vector<std::string> &out) const
+    {
+        if (components_.empty())
+        {
+            return false;
+        }
+
+        std::vector<std::string> results;
+        std::string path = absolute_ ? "/" : "";
+        if (absolute_)
+        {
+            DirFd root(open("/", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+            if (root.get() >= 0)
+            {
+                walk(root.get(), path, 0, results);
+            }
+        }
+        else
+        {
+            walk(AT_FDCWD, path, 0, results);
+        }
+
+        if (results.empty())
+        {
+            return false;
+        }
+
+        std::sort(results.begin(), results.end());
+        out.insert(out.end(), std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
+        return true;
+    }
+
+    void GlobPattern::expand(const std::string &value, std::vector<std::string> &out) const
+    {
+        switch (mode_)
+        {
+        case Mode::STATIC:
+            if (run(out))
+            {
+                return;
+            }
+            break;
+        case Mode::DYNAMIC:
+            if (PatternMatcher::hasMeta(value))
+            {
+                GlobPattern pattern;
+                pattern.compile(value);
+                if (pattern.run(out))
+                {
+                    return;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+
+        // 没有匹配，保留原单词
+        out.push_back(value);
+    }
+
+} // namespace dash
@@ -21,11 +21,14 @@
 #include <dirent.h> // 用于目录操作
 #include <sys/stat.h> // 用于文件状态检查
 #include <chrono>  // 用于时间测量
+#include <csignal> // 用于 SIGINT
 #include "../../include/core/input.h"
 #include "../../include/core/shell.h"
 #include "../../include/utils/error.h"
 #include "../../include/builtins/debug_command.h"
 #include "../../include/variable/variable_manager.h"  // 添加这行以包含VariableManager的定义
+#include "../../include/core/executor.h"
+#include "../../include/core/event_loop.h"
 #include "debug.h"
 
 // 如果启用了readline库
@@ -41,6 +44,19 @@ namespace dash
     // 全局StdinInputSource指针，用于回调
     static StdinInputSource* g_stdin_source = nullptr;
 
+    // 回调方式读取时，行处理函数交回的结果
+    static char* g_callback_line = nullptr;
+    static bool g_callback_done = false;
+
+    // readline 读到完整一行（或 EOF）时调用
+    static void callbackLineHandler(char* line)
+    {
+        g_callback_line = line;
+        g_callback_done = true;
+        // 立即移除处理函数，避免 readline 再次显示提示符
+        rl_callback_handler_remove();
+    }
+
     // 自定义Tab键处理函数
     int custom_complete(int count, int key)
     {
@@ -520,7 +536,8 @@ namespace dash
     // StdinInputSource 实现
 
     StdinInputSource::StdinInputSource(bool interactive, const std::string &prompt, bool use_readline)
-        : eof_(false), interactive_(interactive), prompt_(prompt), use_readline_(use_readline), completion_func_(nullptr)
+        : eof_(false), interactive_(interactive), prompt_(prompt), use_readline_(use_readline),
+          event_loop_(nullptr), reading_(false), completion_func_(nullptr)
     {
         // 强制启用交互模式和readline
         interactive_ = true;
@@ -587,28 +604,8 @@ namespace dash
         rl_filename_quoting_desired = 1;
         rl_completion_append_character = '\0';  // 不自动添加空格
         
-        // 读取历史记录
-        // 尝试从环境变量获取历史记录文件路径
-        const char* history_file_env = getenv("DASH_HISTORY_FILE");
-        std::string history_file;
-        
-        if (history_file_env) {
-            history_file = history_file_env;
-        } else {
-            // 尝试从系统log目录获取
-            const char* shell_dir_env = getenv("DASH_SHELL_DIR");
-            if (shell_dir_env) {
-                history_file = std::string(shell_dir_env) + "/log/dash_history";
-            } else {
-                // 使用默认路径
-                std::string home_dir = getenv("HOME") ? getenv("HOME") : ".";
-                history_file = home_dir + "/.dash_history";
-            }
-        }
-        
-        // 直接读取历史文件，现在文件格式应该与readline兼容
-        read_history(history_file.c_str());
-        
+        // 历史记录文件由 History 加载，并逐条同步到 readline，这里不再重复读取
+
         // 设置历史记录大小
         stifle_history(1000);
         
@@ -627,29 +624,8 @@ namespace dash
     void StdinInputSource::cleanupReadline()
     {
 #ifdef READLINE_ENABLED
-        // 保存历史记录到与initializeReadline相同的文件
-        std::string history_file;
-        
-        // 与initializeReadline保持一致的文件路径选择逻辑
-        const char* history_file_env = getenv("DASH_HISTORY_FILE");
-        if (history_file_env) {
-            history_file = history_file_env;
-        } else {
-            // 尝试从系统log目录获取
-            const char* shell_dir_env = getenv("DASH_SHELL_DIR");
-            if (shell_dir_env) {
-                history_file = std::string(shell_dir_env) + "/log/dash_history";
-            } else {
-                // 使用默认路径
-        std::string home_dir = getenv("HOME") ? getenv("HOME") : ".";
-                history_file = home_dir + "/.dash_history";
-            }
-        }
-        
-        // 保存历史记录到文件
-        dash::DebugLog::logCommand("保存readline历史记录到: " + history_file);
-        write_history(history_file.c_str());
-        
+        // 历史记录在每条命令加入时已由 History 追加到文件，退出时不再整体重写
+
         // 清除全局指针
         if (g_stdin_source == this)
         {
@@ -661,8 +637,9 @@ namespace dash
     std::string StdinInputSource::readLineWithReadline()
     {
 #ifdef READLINE_ENABLED
-        // 使用readline读取一行
-        char* line = readline(prompt_.c_str());
+        // 使用readline读取一行，有事件循环时由事件循环驱动
+        char* line = event_loop_ && event_loop_->isOpen() ? readLineWithEventLoop()
+                                                          : readline(prompt_.c_str());
         
         if (line)
         {
@@ -704,6 +681,70 @@ namespace dash
 #endif
     }
 
+    char *StdinInputSource::readLineWithEventLoop()
+    {
+#ifdef READLINE_ENABLED
+        g_callback_line = nullptr;
+        g_callback_done = false;
+        rl_callback_handler_install(prompt_.c_str(), callbackLineHandler);
+        reading_ = true;
+
+        auto on_signal = [this](int signo) {
+            if (signo == SIGINT)
+            {
+                // Ctrl+C 丢弃当前输入行，在新的一行重新显示提示符
+                rl_echo_signal_char(SIGINT);
+                rl_free_line_state();
+                rl_callback_sigcleanup();
+                rl_replace_line("", 0);
+                rl_crlf();
+                rl_on_new_line();
+                rl_redisplay();
+            }
+            else
+            {
+                event_loop_->dispatch(signo);
+            }
+        };
+
+        while (!g_callback_done)
+        {
+            if (!event_loop_->waitReadable(STDIN_FILENO, on_signal))
+            {
+                // epoll 出错时退回阻塞读取
+                rl_callback_handler_remove();
+                reading_ = false;
+                return readline(prompt_.c_str());
+            }
+            rl_callback_read_char();
+        }
+
+        reading_ = false;
+        return g_callback_line;
+#else
+        return nullptr;
+#endif
+    }
+
+    void StdinInputSource::showNotification(const std::string &text)
+    {
+#ifdef READLINE_ENABLED
+        if (reading_)
+        {
+            // 先擦掉正在编辑的行，通知输出后再重画提示符和已输入的内容
+            rl_clear_visible_line();
+            fflush(rl_outstream);
+            std::cout << text;
+            std::cout.flush();
+            rl_on_new_line();
+            rl_forced_update_display();
+            return;
+        }
+#endif
+        std::cout << text;
+        std::cout.flush();
+    }
+
     std::string StdinInputSource::readLine()
     {
         if (eof_)
@@ -975,6 +1016,8 @@ namespace dash
             auto *stdin_source = dynamic_cast<StdinInputSource *>(input_stack_.top().get());
             if (stdin_source)
             {
+                stdin_source->setEventLoop(shell_->getEventLoop());
+
                 // 修复：使用单个"$"作为提示符，避免双重提示符问题
                 std::string prompt = shell_->getVariableManager()->get("FPS1");
                 if (prompt.empty()) {
@@ -1081,6 +1124,22 @@ namespace dash
         return input_stack_.top()->getName();
     }
 
+    void InputHandler::showNotification(const std::string &text)
+    {
+        if (!input_stack_.empty())
+        {
+            auto *stdin_source = dynamic_cast<StdinInputSource *>(input_stack_.top().get());
+            if (stdin_source)
+            {
+                stdin_source->showNotification(text);
+                return;
+            }
+        }
+
+        std::cout << text;
+        std::cout.flush();
+    }
+
     void InputHandler::setPrompt(const std::string &prompt)
     {
         if (!input_stack_.empty() && input_stack_.top()->getName() == "stdin")
@@ -1223,38 +1282,11 @@ namespace dash
                 }
             }
             
-            // 匹配PATH中的可执行文件
-            const char* path_env = getenv("PATH");
-            if (path_env) {
-                std::string path = path_env;
-                std::istringstream path_stream(path);
-                std::string dir_path;
-                
-                while (std::getline(path_stream, dir_path, ':')) {
-                    DIR* dir;
-                    struct dirent* entry;
-                    
-                    if ((dir = opendir(dir_path.c_str())) != NULL) {
-                        while ((entry = readdir(dir)) != NULL) {
-                            std::string name = entry->d_name;
-                            
-                            // 检查是否匹配前缀
-                            if (name.compare(0, current_word.length(), current_word) == 0) {
-                                // 构造完整路径
-                                std::string full_path = dir_path + "/" + name;
-                                
-                                // 检查是否是可执行文件
-                                struct stat st;
-                                if (stat(full_path.c_str(), &st) == 0 && 
-                                    (st.st_mode & S_IXUSR) && !S_ISDIR(st.st_mode)) {
-                                    matches.push_back(name);
-                                }
-                            }
-                        }
-                        closedir(dir);
-                    }
-                }
-            }
+            // 匹配PATH中的可执行文件（目录列表由命令哈希表缓存）
+            std::string path = shell_->getVariableManager()->get("PATH");
+            std::vector<std::string> commands =
+                shell_->getExecutor()->getCommandHash().complete(current_word, path);
+            matches.insert(matches.end(), commands.begin(), commands.end());
             
             return matches;
         }
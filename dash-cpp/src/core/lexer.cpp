@@ -6,6 +6,8 @@
 #include <iostream>
 #include <sstream>
 #include <cctype>
+#include <cstring>
+#include <algorithm>
 #include "core/lexer.h"
 #include "core/shell.h"
 #include "utils/error.h"
@@ -15,8 +17,15 @@ namespace dash
 
     // Token 实现
 
-    Token::Token(TokenType type, const std::string &value, int line_number, int column)
-        : type_(type), value_(value), line_number_(line_number), column_(column)
+    Token::Token()
+        : type_(TokenType::END_OF_INPUT), quote_removed_(false), line_number_(0), column_(0)
+    {
+    }
+
+    Token::Token(TokenType type, std::string_view value, int line_number, int column, bool quote_removed,
+                 std::string_view raw)
+        : type_(type), value_(value), raw_(raw.empty() ? value : raw), quote_removed_(quote_removed),
+          line_number_(line_number), column_(column)
     {
     }
 
@@ -53,8 +62,15 @@ namespace dash
 
     // Lexer 实现
 
+    namespace
+    {
+        // 去引号文本暂存区每块的大小
+        constexpr size_t COOKED_CHUNK_SIZE = 4096;
+    }
+
     Lexer::Lexer(Shell *shell)
-        : shell_(shell), position_(0), line_number_(1), column_(1), eof_seen_(false)
+        : shell_(shell), position_(0), line_number_(1), column_(1), eof_seen_(false),
+          ring_head_(0), ring_count_(0), cooked_used_(0), cooked_capacity_(0)
     {
     }
 
@@ -66,9 +82,39 @@ namespace dash
         column_ = 1;
         eof_seen_ = false;
 
-        // 清空词法单元队列
-        std::queue<std::unique_ptr<Token>> empty;
-        token_queue_.swap(empty);
+        // 清空前瞻缓冲区；之前的词法单元随输入一起失效
+        ring_head_ = 0;
+        ring_count_ = 0;
+
+        // 保留第一块暂存区供下一次输入复用
+        if (cooked_chunks_.size() > 1)
+        {
+            cooked_chunks_.resize(1);
+            cooked_capacity_ = COOKED_CHUNK_SIZE;
+        }
+        cooked_used_ = 0;
+    }
+
+    std::string_view Lexer::storeCooked(const std::string &text)
+    {
+        // 空单词（如 ""）不占用存储，也不要求已有块
+        if (text.empty())
+        {
+            return std::string_view();
+        }
+
+        if (cooked_capacity_ - cooked_used_ < text.size())
+        {
+            size_t size = std::max(COOKED_CHUNK_SIZE, text.size());
+            cooked_chunks_.emplace_back(new char[size]);
+            cooked_used_ = 0;
+            cooked_capacity_ = size;
+        }
+
+        char *dest = cooked_chunks_.back().get() + cooked_used_;
+        std::memcpy(dest, text.data(), text.size());
+        cooked_used_ += text.size();
+        return std::string_view(dest, text.size());
     }
 
     char Lexer::currentChar() const
@@ -116,45 +162,62 @@ namespace dash
 
     bool Lexer::isWordChar(char c) const
     {
-        // 单词字符包括字母、数字、下划线和一些特殊字符
-        return std::isalnum(c) || c == '_' || c == '/' || c == '.' || c == '-' || c == '+' || c == '@' || c == '$' || c == '*' || c == '?' || c == '(' || c == ')' || c == '`' || c == '=';
+        // 除空白、操作符和输入结束以外的字符都属于单词（[、]、{、}、:、% 等）
+        return c != '\0' && !std::isspace(static_cast<unsigned char>(c)) && !isOperatorChar(c);
     }
 
     bool Lexer::isOperatorChar(char c) const
     {
-        // 操作符字符
-        return c == '|' || c == '&' || c == ';' || c == '<' || c == '>' || c == '(' || c == ')' || c == '{' || c == '}';
+        // 操作符字符（{ 和 } 是保留字而不是操作符，由解析器在命令位置识别）
+        return c == '|' || c == '&' || c == ';' || c == '<' || c == '>' || c == '(' || c == ')';
     }
 
-    std::unique_ptr<Token> Lexer::parseWord()
+    Token Lexer::parseWord()
     {
         int start_column = column_;
-        std::string value;
+        int start_line = line_number_;
+        size_t start = position_;
         bool is_assignment = false;
         bool in_quotes = false;
         char quote_char = '\0';
         bool in_command_subst = false;
         int paren_count = 0;
 
+        // 遇到引号之前，单词就是输入的原样切片，不需要复制；
+        // 遇到引号后才把已扫描的部分复制到 scratch_，之后逐字符追加
+        bool cooked = false;
+        auto take = [&]() {
+            if (cooked)
+            {
+                scratch_ += currentChar();
+            }
+            advance();
+        };
+        auto length = [&]() {
+            return cooked ? scratch_.size() : position_ - start;
+        };
+
         while (true)
         {
             char c = currentChar();
 
-            // 处理命令替换 $(command)
-            if (c == '$' && peekChar() == '(')
+            // 处理命令替换 $(command)，嵌套的 $( 由括号计数处理
+            if (c == '$' && peekChar() == '(' && !in_command_subst)
             {
-                value += c;
-                advance();
-                value += c;
-                advance();
+                take();
+                take();
                 in_command_subst = true;
                 paren_count = 1;
                 continue;
             }
-            
+
             // 处理命令替换中的括号
             if (in_command_subst)
             {
+                if (c == '\0')
+                {
+                    throw ShellException(ExceptionType::SYNTAX, "Unterminated command substitution");
+                }
                 if (c == '(')
                 {
                     paren_count++;
@@ -167,47 +230,31 @@ namespace dash
                         in_command_subst = false;
                     }
                 }
-                
-                value += c;
-                advance();
-                
-                if (paren_count == 0)
-                {
-                    continue;
-                }
-                else if (c == '\0')
-                {
-                    throw ShellException(ExceptionType::SYNTAX, "Unterminated command substitution");
-                }
-                else
-                {
-                    continue;
-                }
+
+                take();
+                continue;
             }
-            
+
             // 处理反引号命令替换 `command`
             if (c == '`')
             {
-                value += c;
-                advance();
-                
+                take();
+
                 // 查找匹配的反引号
                 while (currentChar() != '\0' && currentChar() != '`')
                 {
-                    value += currentChar();
-                    advance();
+                    take();
                 }
-                
+
                 if (currentChar() == '`')
                 {
-                    value += currentChar();
-                    advance();
+                    take();
                 }
                 else
                 {
                     throw ShellException(ExceptionType::SYNTAX, "Unterminated command substitution");
                 }
-                
+
                 continue;
             }
 
@@ -216,6 +263,11 @@ namespace dash
             {
                 if (!in_quotes)
                 {
+                    if (!cooked)
+                    {
+                        scratch_.assign(input_, start, position_ - start);
+                        cooked = true;
+                    }
                     in_quotes = true;
                     quote_char = c;
                     // 不将引号添加到值中
@@ -230,8 +282,7 @@ namespace dash
                 }
                 else
                 {
-                    value += c;
-                    advance();
+                    take();
                 }
                 continue;
             }
@@ -243,41 +294,31 @@ namespace dash
                 {
                     throw ShellException(ExceptionType::SYNTAX, "Unterminated quote");
                 }
-                value += c;
-                advance();
+                take();
                 continue;
             }
 
             // 处理转义字符
             if (c == '\\')
             {
-                value += c;
-                advance();
+                take();
                 if (currentChar() != '\0')
                 {
-                    value += currentChar();
-                    advance();
+                    take();
                 }
                 continue;
             }
 
             // 检查是否是赋值表达式（name=value）
-            //std::cout<<c<<"\t"<<value.empty()<<"\t"<<is_assignment<<std::endl;
-            if (c == '=' && !value.empty() && !is_assignment)
+            if (c == '=' && length() > 0 && !is_assignment)
             {
-                // 特殊处理alias命令
-                bool inAlias = false;
-                std::string inputToCheck = input_.substr(0, position_);
-                if (inputToCheck.find("alias ") == 0) {
-                    inAlias = true;
-                }
-                
-                // 只有不在alias命令中才作为赋值处理
-                if (!inAlias) {
+                // 特殊处理alias命令：只有不在alias命令中才作为赋值处理
+                bool in_alias = std::string_view(input_).substr(0, position_).rfind("alias ", 0) == 0;
+                if (!in_alias)
+                {
                     is_assignment = true;
                 }
-                value += c;
-                advance();
+                take();
                 continue;
             }
 
@@ -287,89 +328,50 @@ namespace dash
                 break;
             }
 
-            value += c;
-            advance();
+            take();
         }
 
+        std::string_view raw = std::string_view(input_).substr(start, position_ - start);
+        std::string_view value = cooked ? storeCooked(scratch_) : raw;
+
         // 创建相应类型的词法单元
         if (is_assignment)
         {
-            return std::make_unique<Token>(TokenType::ASSIGNMENT, value, line_number_, start_column);
+            return Token(TokenType::ASSIGNMENT, value, start_line, start_column, cooked, raw);
         }
-        else
-        {
-            // 检查是否是 IO 编号
-            bool is_io_number = true;
-            for (char c : value)
-            {
-                if (!std::isdigit(c))
-                {
-                    is_io_number = false;
-                    break;
-                }
-            }
 
-            if (is_io_number && !value.empty() && (currentChar() == '>' || currentChar() == '<'))
-            {
-                return std::make_unique<Token>(TokenType::IO_NUMBER, value, line_number_, start_column);
-            }
-            else
-            {
-                return std::make_unique<Token>(TokenType::WORD, value, line_number_, start_column);
-            }
+        // 检查是否是 IO 编号
+        bool is_io_number = !cooked && !value.empty() &&
+                            std::all_of(value.begin(), value.end(), [](char ch) { return std::isdigit(static_cast<unsigned char>(ch)); });
+        if (is_io_number && (currentChar() == '>' || currentChar() == '<'))
+        {
+            return Token(TokenType::IO_NUMBER, value, start_line, start_column);
         }
+
+        return Token(TokenType::WORD, value, start_line, start_column, cooked, raw);
     }
 
-    std::unique_ptr<Token> Lexer::parseOperator()
+    Token Lexer::parseOperator()
     {
         int start_column = column_;
-        std::string value;
+        size_t start = position_;
+        char c = currentChar();
+        char next = peekChar();
 
-        // 处理多字符操作符
-        if (currentChar() == '&' && peekChar() == '&')
-        {
-            value = "&&";
-            advance();
-            advance();
-        }
-        else if (currentChar() == '|' && peekChar() == '|')
-        {
-            value = "||";
-            advance();
-            advance();
-        }
-        else if (currentChar() == '>' && peekChar() == '>')
-        {
-            value = ">>";
-            advance();
-            advance();
-        }
-        else if (currentChar() == '<' && peekChar() == '<')
-        {
-            value = "<<";
-            advance();
-            advance();
-        }
-        else if (currentChar() == '<' && peekChar() == '&')
-        {
-            value = "<&";
-            advance();
-            advance();
-        }
-        else if (currentChar() == '>' && peekChar() == '&')
-        {
-            value = ">&";
-            advance();
-            advance();
-        }
-        else
+        // 处理多字符操作符：&& || ;; >> << <& >&
+        bool two_chars = (c == '&' && next == '&') || (c == '|' && next == '|') ||
+                         (c == ';' && next == ';') || (c == '>' && next == '>') ||
+                         (c == '<' && next == '<') || (c == '<' && next == '&') ||
+                         (c == '>' && next == '&');
+
+        advance();
+        if (two_chars)
         {
-            // 单字符操作符
-            value = currentChar();
             advance();
         }
 
-        return std::make_unique<Token>(TokenType::OPERATOR, value, line_number_, start_column);
+        return Token(TokenType::OPERATOR, std::string_view(input_).substr(start, position_ - start),
+                     line_number_, start_column);
     }
 
     void Lexer::parseComment()
@@ -381,81 +383,89 @@ namespace dash
         }
     }
 
-    std::unique_ptr<Token> Lexer::nextToken()
+    Token Lexer::scanToken()
     {
-        // 如果队列中有词法单元，则返回队列中的第一个
-        if (!token_queue_.empty())
+        while (true)
         {
-            std::unique_ptr<Token> token = std::move(token_queue_.front());
-            token_queue_.pop();
-            return token;
-        }
+            // 如果已经看到 EOF，则返回 END_OF_INPUT 词法单元
+            if (eof_seen_)
+            {
+                return Token(TokenType::END_OF_INPUT, "", line_number_, column_);
+            }
 
-        // 如果已经看到 EOF，则返回 END_OF_INPUT 词法单元
-        if (eof_seen_)
-        {
-            return std::make_unique<Token>(TokenType::END_OF_INPUT, "", line_number_, column_);
-        }
+            // 跳过空白字符
+            skipWhitespace();
 
-        // 跳过空白字符
-        skipWhitespace();
+            char c = currentChar();
 
-        char c = currentChar();
+            // 检查输入结束
+            if (c == '\0')
+            {
+                eof_seen_ = true;
+                return Token(TokenType::END_OF_INPUT, "", line_number_, column_);
+            }
 
-        // 检查输入结束
-        if (c == '\0')
-        {
-            eof_seen_ = true;
-            return std::make_unique<Token>(TokenType::END_OF_INPUT, "", line_number_, column_);
-        }
+            // 处理换行符
+            if (c == '\n')
+            {
+                int start_column = column_;
+                advance();
+                return Token(TokenType::NEWLINE, "\n", line_number_ - 1, start_column);
+            }
 
-        // 处理换行符
-        if (c == '\n')
-        {
-            int start_column = column_;
-            advance();
-            return std::make_unique<Token>(TokenType::NEWLINE, "\n", line_number_ - 1, start_column);
-        }
+            // 处理注释，然后继续读取下一个有效词法单元
+            if (c == '#')
+            {
+                parseComment();
+                continue;
+            }
 
-        // 处理注释
-        if (c == '#')
-        {
-            parseComment();
-            return nextToken(); // 递归调用以获取下一个有效词法单元
+            // 处理操作符
+            if (isOperatorChar(c))
+            {
+                return parseOperator();
+            }
+
+            // 处理单词（包括命令、参数、变量赋值等）
+            return parseWord();
         }
+    }
 
-        // 处理操作符
-        if (isOperatorChar(c))
+    Token Lexer::nextToken()
+    {
+        // 如果前瞻缓冲区中有词法单元，则返回第一个
+        if (ring_count_ > 0)
         {
-            return parseOperator();
+            Token token = token_ring_[ring_head_];
+            ring_head_ = (ring_head_ + 1) % TOKEN_RING_SIZE;
+            ring_count_--;
+            return token;
         }
 
-        // 处理单词（包括命令、参数、变量赋值等）
-        return parseWord();
+        return scanToken();
     }
 
     const Token *Lexer::peekToken()
     {
-        if (token_queue_.empty())
+        if (ring_count_ == 0)
         {
-            token_queue_.push(nextToken());
+            token_ring_[ring_head_] = scanToken();
+            ring_count_ = 1;
         }
 
-        return token_queue_.front().get();
+        return &token_ring_[ring_head_];
     }
 
-    void Lexer::ungetToken(std::unique_ptr<Token> token)
+    void Lexer::ungetToken(const Token &token)
     {
-        std::queue<std::unique_ptr<Token>> new_queue;
-        new_queue.push(std::move(token));
-
-        while (!token_queue_.empty())
+        if (ring_count_ == TOKEN_RING_SIZE)
         {
-            new_queue.push(std::move(token_queue_.front()));
-            token_queue_.pop();
+            throw ShellException(ExceptionType::INTERNAL, "Lexer error: too many tokens pushed back");
         }
 
-        token_queue_.swap(new_queue);
+        ring_head_ = (ring_head_ + TOKEN_RING_SIZE - 1) % TOKEN_RING_SIZE;
+        token_ring_[ring_head_] = token;
+        ring_count_++;
     }
 
-} // namespace dash
\ No newline at end of file
+} // namespace dash
@@ -16,20 +16,61 @@ Node::Node(NodeType type)
 {
 }
 
+namespace
+{
+    // 每个节点前的块头，记录节点所在的内存池（堆上分配时为 nullptr）
+    constexpr std::size_t NODE_HEADER_SIZE = alignof(std::max_align_t);
+}
+
+void *Node::operator new(std::size_t size)
+{
+    Arena *arena = Arena::current();
+    void *block = arena ? arena->allocate(NODE_HEADER_SIZE + size, NODE_HEADER_SIZE)
+                        : ::operator new(NODE_HEADER_SIZE + size);
+    *static_cast<Arena **>(block) = arena;
+    return static_cast<char *>(block) + NODE_HEADER_SIZE;
+}
+
+void Node::operator delete(void *ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    void *block = static_cast<char *>(ptr) - NODE_HEADER_SIZE;
+    if (*static_cast<Arena **>(block) == nullptr) {
+        ::operator delete(block);
+    }
+}
+
 // CommandNode 实现
 CommandNode::CommandNode()
-    : Node(NodeType::COMMAND), background_(false)
+    : Node(NodeType::COMMAND), background_(false), builtin_slot_(NO_BUILTIN)
 {
 }
 
-void CommandNode::addArg(const std::string& arg)
+void CommandNode::addArg(std::string_view arg, bool quoted)
 {
-    args_.push_back(arg);
+    args_.emplace_back(arg);
+    arg_programs_.emplace_back(arg);
+    arg_globs_.emplace_back(arg, quoted);
+
+    // 命令名是字面量时，展开结果就是它本身，内置命令槽位只需查一次
+    if (args_.size() == 1) {
+        const ExpansionProgram &program = arg_programs_.back();
+        builtin_slot_ = program.isLiteral() && arg_globs_.back().getMode() == GlobPattern::Mode::NONE
+                            ? lookupBuiltin(program.getLiteral())
+                            : UNRESOLVED_BUILTIN;
+    }
 }
 
-void CommandNode::addAssignment(const std::string& assignment)
+void CommandNode::addAssignment(std::string_view assignment)
 {
-    assignments_.push_back(assignment);
+    assignments_.emplace_back(assignment);
+
+    // 只编译等号右侧的值
+    size_t pos = assignment.find('=');
+    assignment_programs_.emplace_back(pos == std::string_view::npos ? std::string_view() : assignment.substr(pos + 1));
 }
 
 void CommandNode::addRedirection(const Redirection& redir)
@@ -112,10 +153,30 @@ ListNode::ListNode()
 {
 }
 
-void ListNode::addCommand(std::unique_ptr<Node> command, const std::string& op)
+void ListNode::addCommand(std::unique_ptr<Node> command, std::string_view op)
 {
     commands_.push_back(std::move(command));
-    operators_.push_back(op);
+    operators_.emplace_back(op);
+}
+
+std::unique_ptr<Node> ListNode::adoptArena(std::unique_ptr<Node> root, std::shared_ptr<Arena> arena)
+{
+    if (!root) {
+        return nullptr;
+    }
+
+    // 在堆上创建新的根节点；子节点和容器仍留在内存池中
+    std::unique_ptr<ListNode> heap_root;
+    if (root->getType() == NodeType::LIST) {
+        heap_root.reset(new ListNode(std::move(static_cast<ListNode &>(*root))));
+    } else {
+        heap_root.reset(new ListNode());
+        heap_root->addCommand(std::move(root));
+    }
+    root.reset();
+
+    heap_root->arena_ = std::move(arena);
+    return heap_root;
 }
 
 void ListNode::print(int indent) const
@@ -155,9 +216,14 @@ void IfNode::print(int indent) const
 }
 
 // ForNode 实现
-ForNode::ForNode(const std::string& var, const std::vector<std::string>& words, std::unique_ptr<Node> body)
-    : Node(NodeType::FOR), var_(var), words_(words), body_(std::move(body))
+ForNode::ForNode(const std::string& var, const std::vector<std::string>& words, std::unique_ptr<Node> body,
+                 const std::vector<bool>& quoted)
+    : Node(NodeType::FOR), var_(var), words_(words.begin(), words.end()), body_(std::move(body))
 {
+    for (size_t i = 0; i < words.size(); ++i) {
+        word_programs_.emplace_back(words[i]);
+        word_globs_.emplace_back(words[i], i < quoted.size() && quoted[i]);
+    }
 }
 
 void ForNode::print(int indent) const
@@ -194,13 +260,95 @@ void WhileNode::print(int indent) const
 
 // CaseNode 实现
 CaseNode::CaseNode(const std::string& word)
-    : Node(NodeType::CASE), word_(word)
+    : Node(NodeType::CASE), word_(word), word_program_(word)
+{
+}
+
+CaseNode::CasePattern::CasePattern(std::string_view raw)
 {
+    // 不需要展开的文本先累积起来，遇到需要展开的段时作为一段输出
+    std::string literal;
+    auto flushLiteral = [&]() {
+        if (!literal.empty()) {
+            parts.push_back(PatternPart{AstString(literal), ExpansionProgram(), false});
+            literal.clear();
+        }
+    };
+    auto addExpansion = [&](std::string_view text, bool quoted) {
+        if (text.find('$') == std::string_view::npos && text.find('`') == std::string_view::npos) {
+            literal += quoted ? PatternMatcher::escape(text) : std::string(text);
+            return;
+        }
+        ExpansionProgram program(text);
+        if (program.isLiteral()) {
+            // 例如单独的 $，没有可展开的内容
+            literal += quoted ? PatternMatcher::escape(text) : std::string(text);
+            return;
+        }
+        flushLiteral();
+        parts.push_back(PatternPart{AstString(), std::move(program), quoted});
+    };
+
+    size_t i = 0;
+    while (i < raw.size()) {
+        char c = raw[i];
+        if (c == '\'' || c == '"') {
+            // 与词法分析器一致：引号内直到同一种引号为止
+            size_t end = raw.find(c, i + 1);
+            if (end == std::string_view::npos) {
+                end = raw.size();
+            }
+            std::string_view text = raw.substr(i + 1, end - i - 1);
+            if (c == '\'') {
+                literal += PatternMatcher::escape(text);
+            } else {
+                addExpansion(text, true);
+            }
+            i = end + 1;
+            continue;
+        }
+
+        // 不带引号的一段，跳过 $(...) 和 `...` 中的引号
+        size_t start = i;
+        int paren_count = 0;
+        while (i < raw.size()) {
+            c = raw[i];
+            if (paren_count == 0 && (c == '\'' || c == '"')) {
+                break;
+            }
+            if (c == '\\' && i + 1 < raw.size()) {
+                i += 2;
+                continue;
+            }
+            if (c == '$' && i + 1 < raw.size() && raw[i + 1] == '(') {
+                ++paren_count;
+                i += 2;
+                continue;
+            }
+            if (paren_count > 0 && c == '(') {
+                ++paren_count;
+            } else if (paren_count > 0 && c == ')') {
+                --paren_count;
+            } else if (paren_count == 0 && c == '`') {
+                size_t end = raw.find('`', i + 1);
+                i = end == std::string_view::npos ? raw.size() : end + 1;
+                continue;
+            }
+            ++i;
+        }
+        addExpansion(raw.substr(start, i - start), false);
+    }
+
+    if (parts.empty()) {
+        matcher = PatternMatcher(literal);
+        return;
+    }
+    flushLiteral();
 }
 
 void CaseNode::addItem(const std::vector<std::string>& patterns, std::unique_ptr<Node> commands)
 {
-    items_.push_back(std::make_unique<CaseItem>(patterns, std::move(commands)));
+    items_.emplace_back(patterns, std::move(commands));
 }
 
 void CaseNode::print(int indent) const
@@ -213,12 +361,12 @@ void CaseNode::print(int indent) const
         std::cout << std::setw(indent + 2) << "" << "Item " << i + 1 << ":" << std::endl;
         
         std::cout << std::setw(indent + 4) << "" << "Patterns:" << std::endl;
-        for (const auto& pattern : items_[i]->patterns) {
+        for (const auto& pattern : items_[i].patterns) {
             std::cout << std::setw(indent + 6) << "" << pattern << std::endl;
         }
         
         std::cout << std::setw(indent + 4) << "" << "Commands:" << std::endl;
-        items_[i]->commands->print(indent + 6);
+        items_[i].commands->print(indent + 6);
     }
 }
 
@@ -272,4 +420,22 @@ void SubshellNode::print(int indent) const
     }
 }
 
+// FunctionNode 实现
+FunctionNode::FunctionNode(std::string_view name, std::unique_ptr<Node> body)
+    : Node(NodeType::FUNCTION), name_(name), body_(std::move(body))
+{
+    // 解析时所在的内存池由 parseCommand 通过 make_shared 创建
+    if (Arena *arena = Arena::current()) {
+        arena_ = arena->weak_from_this().lock();
+    }
+}
+
+void FunctionNode::print(int indent) const
+{
+    std::cout << std::setw(indent) << "" << "FunctionNode: " << name_ << "()" << std::endl;
+
+    std::cout << std::setw(indent + 2) << "" << "Body:" << std::endl;
+    body_->print(indent + 4);
+}
+
 } // namespace dash 
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "../../include/core/shell.h"
 #include <iostream>
 #include <unistd.h>
+#include <cerrno>
+#include <cstdio>
 #include <cstring>
 
 namespace dash {
@@ -125,4 +127,102 @@ void Output::output(const std::string& message, OutputType type, bool newline) {
     }
 }
 
-} // namespace dash 
\ No newline at end of file
+OutputBuffer::OutputBuffer(int fd)
+    : fd_(fd), terminal_(isatty(fd)) {
+    setp(buffer_, buffer_ + BUFFER_SIZE);
+}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+    // std::cout 比本对象活得更久，析构后不能再指向这里
+    if (previous_ != nullptr && std::cout.rdbuf() == this) {
+        std::cout.rdbuf(previous_);
+    }
+}
+
+OutputBuffer& OutputBuffer::standardOutput() {
+    static OutputBuffer buffer(STDOUT_FILENO);
+    return buffer;
+}
+
+void OutputBuffer::install() {
+    OutputBuffer& buffer = standardOutput();
+    if (std::cout.rdbuf() == &buffer) {
+        return;
+    }
+    // 之前经 stdio 写出的数据先落地，保持顺序
+    std::cout.flush();
+    fflush(stdout);
+    buffer.previous_ = std::cout.rdbuf(&buffer);
+}
+
+void OutputBuffer::commandBoundary() {
+    OutputBuffer& buffer = standardOutput();
+    if (buffer.terminal_) {
+        buffer.flush();
+    }
+}
+
+bool OutputBuffer::writeAll(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd_, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool OutputBuffer::flush() {
+    size_t pending = static_cast<size_t>(pptr() - pbase());
+    if (pending == 0) {
+        return true;
+    }
+    bool ok = writeAll(pbase(), pending);
+    // 写入失败（如 EPIPE）时丢弃数据，与 dash 一致，避免错误反复出现
+    setp(buffer_, buffer_ + BUFFER_SIZE);
+    return ok;
+}
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type ch) {
+    if (!flush()) {
+        return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize OutputBuffer::xsputn(const char* s, std::streamsize n) {
+    size_t size = static_cast<size_t>(n);
+    size_t room = static_cast<size_t>(epptr() - pptr());
+    if (size <= room) {
+        std::memcpy(pptr(), s, size);
+        pbump(static_cast<int>(size));
+        return n;
+    }
+
+    // 放不下时先写出已缓冲的数据；整块以上的数据直接写出
+    if (!flush()) {
+        return 0;
+    }
+    if (size >= BUFFER_SIZE) {
+        return writeAll(s, size) ? n : 0;
+    }
+    std::memcpy(pptr(), s, size);
+    pbump(static_cast<int>(size));
+    return n;
+}
+
+int OutputBuffer::sync() {
+    return flush() ? 0 : -1;
+}
+
+} // namespace dash
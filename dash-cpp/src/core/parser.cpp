@@ -16,7 +16,7 @@ namespace dash
 {
 
     // 保留字集合
-    static const std::unordered_set<std::string> reserved_words = {
+    static const std::unordered_set<std::string_view> reserved_words = {
         "if", "then", "else", "elif", "fi", "case", "esac", "for", "while",
         "until", "do", "done", "in", "{", "}", "!", "[[", "]]"};
 
@@ -43,6 +43,73 @@ namespace dash
         return parseCommand(false);
     }
 
+    std::unique_ptr<Node> Parser::parseSubstitution(const std::string &input)
+    {
+        return parseReentrant(alias_manager_->expandAlias(input));
+    }
+
+    std::unique_ptr<Node> Parser::parseScriptCommand(std::unique_ptr<Lexer> &lexer)
+    {
+        // 临时换入脚本的词法分析器，解析结束后换回
+        std::swap(lexer_, lexer);
+
+        std::unique_ptr<Node> result;
+        try
+        {
+            auto arena = std::make_shared<Arena>();
+            std::unique_ptr<Node> node;
+            {
+                ArenaScope scope(arena.get());
+
+                // 只解析到行尾；跨行的复合命令在 parseList 内部继续读取
+                skipNewlines();
+                node = parseList(true);
+
+                Token token = lexer_->nextToken();
+                if (token.getType() != TokenType::NEWLINE && token.getType() != TokenType::END_OF_INPUT)
+                {
+                    throw ShellException(ExceptionType::SYNTAX, "Syntax error: unexpected token '" + std::string(token.getValue()) + "'");
+                }
+            }
+            result = ListNode::adoptArena(std::move(node), std::move(arena));
+        }
+        catch (const ShellException &e)
+        {
+            std::swap(lexer_, lexer);
+            throw;
+        }
+        catch (const std::exception &e)
+        {
+            std::swap(lexer_, lexer);
+            throw ShellException(ExceptionType::SYNTAX, std::string("Parser error: ") + e.what());
+        }
+
+        std::swap(lexer_, lexer);
+        return result;
+    }
+
+    std::unique_ptr<Node> Parser::parseReentrant(const std::string &text)
+    {
+        // 临时换入新的词法分析器，解析结束后恢复外层状态
+        std::unique_ptr<Lexer> saved_lexer = std::move(lexer_);
+        lexer_ = std::make_unique<Lexer>(shell_);
+        lexer_->setInput(text);
+
+        std::unique_ptr<Node> node;
+        try
+        {
+            node = parseCommand(false);
+        }
+        catch (...)
+        {
+            lexer_ = std::move(saved_lexer);
+            throw;
+        }
+
+        lexer_ = std::move(saved_lexer);
+        return node;
+    }
+
     std::unique_ptr<Node> Parser::parseCommand(bool interactive)
     {
         try
@@ -93,18 +160,25 @@ namespace dash
             }
             
 
-            // 解析命令列表
-            skipNewlines();
-            std::unique_ptr<Node> node = parseList();
-
-            // 检查是否有多余的词法单元
-            std::unique_ptr<Token> token = lexer_->nextToken();
-            if (token->getType() != TokenType::END_OF_INPUT)
+            // 本次解析的节点、字符串和容器都从同一个内存池分配，随语法树一次性释放
+            auto arena = std::make_shared<Arena>();
+            std::unique_ptr<Node> node;
             {
-                throw ShellException(ExceptionType::SYNTAX, "Syntax error: unexpected token '" + token->getValue() + "'");
+                ArenaScope scope(arena.get());
+
+                // 解析命令列表
+                skipNewlines();
+                node = parseList();
+
+                // 检查是否有多余的词法单元
+                Token token = lexer_->nextToken();
+                if (token.getType() != TokenType::END_OF_INPUT)
+                {
+                    throw ShellException(ExceptionType::SYNTAX, "Syntax error: unexpected token '" + std::string(token.getValue()) + "'");
+                }
             }
 
-            return node;
+            return ListNode::adoptArena(std::move(node), std::move(arena));
         }
         catch (const ShellException &e)
         {
@@ -118,7 +192,7 @@ namespace dash
         }
     }
 
-    std::unique_ptr<Node> Parser::parseList()
+    std::unique_ptr<Node> Parser::parseList(bool stop_at_newline)
     {
         // 创建列表节点
         auto list = std::make_unique<ListNode>();
@@ -130,6 +204,7 @@ namespace dash
             return nullptr;
         }
 
+        bool background = isBackgroundNode(command.get());
         list->addCommand(std::move(command));
 
         // 解析后续命令
@@ -138,24 +213,42 @@ namespace dash
             // 查看下一个词法单元
             const Token *token = lexer_->peekToken();
 
-            // 如果是分号或换行符，跳过并继续解析
-            if (token->getType() == TokenType::OPERATOR && token->getValue() == ";")
+            // 脚本的顶层命令到行尾结束
+            if (stop_at_newline && token->getType() == TokenType::NEWLINE)
+            {
+                break;
+            }
+
+            // 如果是分号或换行符（或前一个命令以 & 结束），跳过并继续解析
+            bool is_separator = token->getType() == TokenType::NEWLINE ||
+                                (token->getType() == TokenType::OPERATOR && token->getValue() == ";");
+            if (is_separator || background)
             {
-                lexer_->nextToken(); // 消耗分号
+                std::string op = background ? "&" : ";";
+                if (is_separator)
+                {
+                    lexer_->nextToken(); // 消耗分号或换行符
+                }
+                if (stop_at_newline && lexer_->peekToken()->getType() == TokenType::NEWLINE)
+                {
+                    break;
+                }
                 skipNewlines();
 
-                // 解析下一个命令
+                // 解析下一个命令，遇到 then/fi/done 等结束词时停止
                 command = parsePipeline();
-                if (command)
+                if (!command)
                 {
-                    list->addCommand(std::move(command), ";");
+                    break;
                 }
+                background = isBackgroundNode(command.get());
+                list->addCommand(std::move(command), op);
             }
             // 如果是 && 或 ||，继续解析
             else if (token->getType() == TokenType::OPERATOR &&
                      (token->getValue() == "&&" || token->getValue() == "||"))
             {
-                std::string op = token->getValue();
+                std::string op(token->getValue());
                 lexer_->nextToken(); // 消耗操作符
                 skipNewlines();
 
@@ -166,6 +259,7 @@ namespace dash
                     throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected command after '" + op + "'");
                 }
 
+                background = isBackgroundNode(command.get());
                 list->addCommand(std::move(command), op);
             }
             // 如果是其他词法单元，结束解析
@@ -175,16 +269,28 @@ namespace dash
             }
         }
 
-        // 如果列表中只有一个命令，直接返回该命令
-        if (list->getCommands().size() == 1 && list->getOperators().empty())
+        return list;
+    }
+
+    bool Parser::isBackgroundNode(const Node *node)
+    {
+        if (node->getType() == NodeType::COMMAND)
         {
-            // 由于 getCommands() 返回的是 const std::vector<std::unique_ptr<Node>>&，
-            // 我们不能直接移动其中的元素。
-            // 因此，我们创建一个新的节点并返回整个列表节点。
-            return list;
+            return static_cast<const CommandNode *>(node)->isBackground();
         }
+        if (node->getType() == NodeType::PIPE)
+        {
+            return static_cast<const PipeNode *>(node)->isBackground();
+        }
+        return false;
+    }
 
-        return list;
+    bool Parser::isListTerminator(const Token *token)
+    {
+        // 只在命令位置识别的结束保留字
+        static const std::unordered_set<std::string_view> terminators = {
+            "then", "else", "elif", "fi", "do", "done", "esac", "}"};
+        return token->getType() == TokenType::WORD && terminators.count(token->getValue()) > 0;
     }
 
     std::unique_ptr<Node> Parser::parsePipeline()
@@ -256,10 +362,22 @@ namespace dash
             return nullptr;
         }
 
+        // 结束保留字不属于当前命令，交给外层结构处理
+        if (isListTerminator(token))
+        {
+            return nullptr;
+        }
+
+        // 子 shell
+        if (token->getType() == TokenType::OPERATOR && token->getValue() == "(")
+        {
+            return parseSubshell();
+        }
+
         // 检查是否是保留字
         if (token->getType() == TokenType::WORD)
         {
-            std::string word = token->getValue();
+            std::string_view word = token->getValue();
 
             // 处理特殊命令结构
             if (word == "if")
@@ -282,9 +400,21 @@ namespace dash
             {
                 return parseCase();
             }
-            else if (word == "(")
+            else if (word == "{")
             {
-                return parseSubshell();
+                return parseBraceGroup();
+            }
+
+            // 函数定义：名字后紧跟 '('
+            if (!isReservedWord(std::string(word)))
+            {
+                Token name = lexer_->nextToken();
+                const Token *next = lexer_->peekToken();
+                if (next->getType() == TokenType::OPERATOR && next->getValue() == "(")
+                {
+                    return parseFunction(name.getValue());
+                }
+                lexer_->ungetToken(name);
             }
         }
 
@@ -306,22 +436,16 @@ namespace dash
                 break;
             }
 
-            // 处理变量赋值
-            if (token->getType() == TokenType::ASSIGNMENT)
+            // 处理变量赋值（只在命令名之前识别，之后按普通参数处理）
+            if (token->getType() == TokenType::ASSIGNMENT && first_arg)
             {
-                if (!first_arg)
-                {
-                    // 变量赋值只能出现在命令前面
-                    break;
-                }
-
                 command->addAssignment(token->getValue());
                 lexer_->nextToken(); // 消耗赋值词法单元
                 continue;
             }
 
             // 处理普通参数
-            command->addArg(token->getValue());
+            command->addArg(token->getValue(), token->isQuoteRemoved());
             lexer_->nextToken(); // 消耗单词词法单元
             first_arg = false;
 
@@ -357,7 +481,7 @@ namespace dash
         int fd = -1;
         if (token->getType() == TokenType::IO_NUMBER)
         {
-            fd = std::stoi(token->getValue());
+            fd = std::stoi(std::string(token->getValue()));
             lexer_->nextToken(); // 消耗 IO 编号
             token = lexer_->peekToken();
         }
@@ -374,7 +498,7 @@ namespace dash
         }
 
         // 获取重定向类型
-        std::string op = token->getValue();
+        std::string op(token->getValue());
         RedirType type;
 
         if (op == "<")
@@ -421,7 +545,7 @@ namespace dash
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected word after redirection operator");
         }
 
-        std::string filename = token->getValue();
+        std::string_view filename = token->getValue();
         lexer_->nextToken(); // 消耗文件名
 
         // 创建重定向
@@ -444,10 +568,10 @@ namespace dash
         return true;
     }
 
-    std::unique_ptr<Token> Parser::expectToken(TokenType type, const std::string &error_message)
+    Token Parser::expectToken(TokenType type, const std::string &error_message)
     {
-        std::unique_ptr<Token> token = lexer_->nextToken();
-        if (token->getType() != type)
+        Token token = lexer_->nextToken();
+        if (token.getType() != type)
         {
             throw ShellException(ExceptionType::SYNTAX, error_message);
         }
@@ -479,7 +603,7 @@ namespace dash
             return false;
         }
 
-        const std::string &op = token->getValue();
+        std::string_view op = token->getValue();
         return op == "<" || op == ">" || op == ">>" || op == "<&" || op == ">&" || op == "<<";
     }
 
@@ -489,7 +613,11 @@ namespace dash
     {
         // 消耗 if 关键字
         expectToken(TokenType::WORD, "Syntax error: expected 'if'");
+        return parseIfBody();
+    }
 
+    std::unique_ptr<Node> Parser::parseIfBody()
+    {
         // 解析条件
         auto condition = parseList();
         if (!condition)
@@ -499,7 +627,7 @@ namespace dash
 
         // 期望 then 关键字
         auto token = expectToken(TokenType::WORD, "Syntax error: expected 'then' after condition");
-        if (token->getValue() != "then")
+        if (token.getValue() != "then")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'then' after condition");
         }
@@ -511,10 +639,18 @@ namespace dash
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected commands after 'then'");
         }
 
-        // 检查是否有 else 部分
+        // 检查是否有 elif / else 部分
         std::unique_ptr<Node> else_part = nullptr;
         const Token* peek_token = lexer_->peekToken();
 
+        if (peek_token->getType() == TokenType::WORD && peek_token->getValue() == "elif")
+        {
+            lexer_->nextToken(); // 消耗 elif 关键字
+
+            // elif 作为嵌套的 if 节点放在 else 部分，共用同一个 fi
+            return std::make_unique<IfNode>(std::move(condition), std::move(then_part), parseIfBody());
+        }
+
         if (peek_token->getType() == TokenType::WORD && peek_token->getValue() == "else")
         {
             lexer_->nextToken(); // 消耗 else 关键字
@@ -529,7 +665,7 @@ namespace dash
 
         // 期望 fi 关键字
         token = expectToken(TokenType::WORD, "Syntax error: expected 'fi' to end if statement");
-        if (token->getValue() != "fi")
+        if (token.getValue() != "fi")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'fi' to end if statement");
         }
@@ -547,23 +683,26 @@ namespace dash
 
         // 获取循环变量
         auto token = expectToken(TokenType::WORD, "Syntax error: expected variable name after 'for'");
-        std::string var = token->getValue();
+        std::string var(token.getValue());
 
         // 期望 in 关键字
+        skipNewlines();
         token = expectToken(TokenType::WORD, "Syntax error: expected 'in' after variable name");
-        if (token->getValue() != "in")
+        if (token.getValue() != "in")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'in' after variable name");
         }
 
         // 收集单词列表
         std::vector<std::string> words;
+        std::vector<bool> quoted;
         while (true)
         {
             const Token* peek_token = lexer_->peekToken();
-            if (peek_token->getType() == TokenType::WORD && peek_token->getValue() != "do")
+            if (peek_token->getType() == TokenType::WORD || peek_token->getType() == TokenType::ASSIGNMENT)
             {
-                words.push_back(peek_token->getValue());
+                words.emplace_back(peek_token->getValue());
+                quoted.push_back(peek_token->isQuoteRemoved());
                 lexer_->nextToken(); // 消耗单词
             }
             else
@@ -572,9 +711,17 @@ namespace dash
             }
         }
 
+        // 单词列表以分号或换行符结束
+        const Token* sep_token = lexer_->peekToken();
+        if (sep_token->getType() == TokenType::OPERATOR && sep_token->getValue() == ";")
+        {
+            lexer_->nextToken(); // 消耗分号
+        }
+        skipNewlines();
+
         // 期望 do 关键字
         token = expectToken(TokenType::WORD, "Syntax error: expected 'do' after word list");
-        if (token->getValue() != "do")
+        if (token.getValue() != "do")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'do' after word list");
         }
@@ -588,13 +735,13 @@ namespace dash
 
         // 期望 done 关键字
         token = expectToken(TokenType::WORD, "Syntax error: expected 'done' to end for loop");
-        if (token->getValue() != "done")
+        if (token.getValue() != "done")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'done' to end for loop");
         }
 
         // 创建 for 节点
-        return std::make_unique<ForNode>(var, words, std::move(body));
+        return std::make_unique<ForNode>(var, words, std::move(body), quoted);
     }
 
     std::unique_ptr<Node> Parser::parseWhile(bool until)
@@ -611,7 +758,7 @@ namespace dash
 
         // 期望 do 关键字
         auto token = expectToken(TokenType::WORD, "Syntax error: expected 'do' after condition");
-        if (token->getValue() != "do")
+        if (token.getValue() != "do")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'do' after condition");
         }
@@ -625,7 +772,7 @@ namespace dash
 
         // 期望 done 关键字
         token = expectToken(TokenType::WORD, "Syntax error: expected 'done' to end while/until loop");
-        if (token->getValue() != "done")
+        if (token.getValue() != "done")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'done' to end while/until loop");
         }
@@ -643,11 +790,12 @@ namespace dash
 
         // 获取匹配词
         auto token = expectToken(TokenType::WORD, "Syntax error: expected word after 'case'");
-        std::string word = token->getValue();
+        std::string word(token.getValue());
 
         // 期望 in 关键字
+        skipNewlines();
         token = expectToken(TokenType::WORD, "Syntax error: expected 'in' after word");
-        if (token->getValue() != "in")
+        if (token.getValue() != "in")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected 'in' after word");
         }
@@ -668,6 +816,12 @@ namespace dash
                 break;
             }
 
+            // 模式前可以有可选的 (
+            if (peek_token->getType() == TokenType::OPERATOR && peek_token->getValue() == "(")
+            {
+                lexer_->nextToken(); // 消耗 (
+            }
+
             // 收集模式
             std::vector<std::string> patterns;
             while (true)
@@ -678,7 +832,8 @@ namespace dash
                     throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected pattern in case item");
                 }
 
-                patterns.push_back(peek_token->getValue());
+                // 保留原样文本，模式需要知道每个字符是否带引号
+                patterns.emplace_back(peek_token->getRaw());
                 lexer_->nextToken(); // 消耗模式
 
                 // 检查是否有更多模式
@@ -700,20 +855,21 @@ namespace dash
             }
             lexer_->nextToken(); // 消耗 )
 
-            // 解析命令
+            // 解析命令（可以为空）
+            skipNewlines();
             auto commands = parseList();
-            if (!commands)
-            {
-                throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected commands in case item");
-            }
+            skipNewlines();
 
-            // 期望 ;; 操作符
+            // 期望 ;; 操作符，最后一项可以省略
             peek_token = lexer_->peekToken();
-            if (peek_token->getType() != TokenType::OPERATOR || peek_token->getValue() != ";;")
+            if (peek_token->getType() == TokenType::OPERATOR && peek_token->getValue() == ";;")
+            {
+                lexer_->nextToken(); // 消耗 ;;
+            }
+            else if (peek_token->getType() != TokenType::WORD || peek_token->getValue() != "esac")
             {
                 throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected ';;' after case item");
             }
-            lexer_->nextToken(); // 消耗 ;;
 
             // 添加 case 项
             case_node->addItem(patterns, std::move(commands));
@@ -736,7 +892,7 @@ namespace dash
 
         // 期望 ) 操作符
         auto token = expectToken(TokenType::OPERATOR, "Syntax error: expected ')' to end subshell");
-        if (token->getValue() != ")")
+        if (token.getValue() != ")")
         {
             throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected ')' to end subshell");
         }
@@ -753,6 +909,61 @@ namespace dash
         return subshell;
     }
 
+    std::unique_ptr<Node> Parser::parseBraceGroup()
+    {
+        // 消耗 { 保留字
+        expectToken(TokenType::WORD, "Syntax error: expected '{'");
+
+        // 解析命令，遇到 } 时停止
+        auto commands = parseList();
+        if (!commands)
+        {
+            throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected commands in '{ }'");
+        }
+
+        // 期望 } 保留字
+        auto token = expectToken(TokenType::WORD, "Syntax error: expected '}'");
+        if (token.getValue() != "}")
+        {
+            throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected '}'");
+        }
+
+        return commands;
+    }
+
+    std::unique_ptr<Node> Parser::parseFunction(std::string_view name)
+    {
+        // 消耗 ( 和 )
+        expectToken(TokenType::OPERATOR, "Syntax error: expected '('");
+        auto token = expectToken(TokenType::OPERATOR, "Syntax error: expected ')' in function definition");
+        if (token.getValue() != ")")
+        {
+            throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected ')' in function definition");
+        }
+
+        // 函数体必须是复合命令
+        skipNewlines();
+        const Token *peek_token = lexer_->peekToken();
+        bool compound = false;
+        if (peek_token->getType() == TokenType::OPERATOR)
+        {
+            compound = peek_token->getValue() == "(";
+        }
+        else if (peek_token->getType() == TokenType::WORD)
+        {
+            std::string_view word = peek_token->getValue();
+            compound = word == "{" || word == "if" || word == "for" || word == "while" ||
+                       word == "until" || word == "case";
+        }
+        if (!compound)
+        {
+            throw ShellException(ExceptionType::SYNTAX, "Syntax error: expected compound command as function body");
+        }
+
+        auto body = parseSimpleCommand();
+        return std::make_unique<FunctionNode>(name, std::move(body));
+    }
+
     const std::string& Parser::getLastCommand() const
     {
         return last_command_;
@@ -0,0 +1,367 @@
+/**
+ * @file pattern.cpp
+ * @brief shell 模式匹配实现
+ */
+
+#include <cctype>
+#include "core/pattern.h"
+
+namespace dash
+{
+
+    namespace
+    {
+        /**
+         * @brief 把 [:name:] 字符类加入集合
+         */
+        bool addNamedClass(std::string_view name, std::bitset<256> &set)
+        {
+            int (*test)(int) = nullptr;
+            if (name == "alnum") test = isalnum;
+            else if (name == "alpha") test = isalpha;
+            else if (name == "blank") test = isblank;
+            else if (name == "cntrl") test = iscntrl;
+            else if (name == "digit") test = isdigit;
+            else if (name == "graph") test = isgraph;
+            else if (name == "lower") test = islower;
+            else if (name == "print") test = isprint;
+            else if (name == "punct") test = ispunct;
+            else if (name == "space") test = isspace;
+            else if (name == "upper") test = isupper;
+            else if (name == "xdigit") test = isxdigit;
+            else return false;
+
+            for (int c = 0; c < 256; ++c)
+            {
+                if (test(c))
+                {
+                    set.set(c);
+                }
+            }
+            return true;
+        }
+    }
+
+    PatternMatcher::PatternMatcher()
+        : shape_(Shape::LITERAL), min_length_(0), leading_dot_(false)
+    {
+    }
+
+    PatternMatcher::PatternMatcher(std::string_view pattern, bool quoted)
+        : shape_(Shape::LITERAL), min_length_(0), leading_dot_(false)
+    {
+        if (quoted)
+        {
+            text_ = pattern;
+            min_length_ = pattern.size();
+            leading_dot_ = !pattern.empty() && pattern.front() == '.';
+            return;
+        }
+        compile(pattern);
+    }
+
+    std::string PatternMatcher::escape(std::string_view text)
+    {
+        std::string pattern;
+        pattern.reserve(text.size());
+        for (char c : text)
+        {
+            if (c == '*' || c == '?' || c == '[' || c == ']' || c == '\\')
+            {
+                pattern += '\\';
+            }
+            pattern += c;
+        }
+        return pattern;
+    }
+
+    bool PatternMatcher::hasMeta(std::string_view word)
+    {
+        for (size_t i = 0; i < word.size(); ++i)
+        {
+            char c = word[i];
+            if (c == '\\')
+            {
+                ++i;
+            }
+            else if (c == '*' || c == '?' || c == '[')
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void PatternMatcher::compile(std::string_view pattern)
+    {
+        size_t i = 0;
+        while (i < pattern.size())
+        {
+            char c = pattern[i];
+
+            if (c == '\\' && i + 1 < pattern.size())
+            {
+                atoms_.push_back(Atom{Atom::Kind::CHAR, static_cast<unsigned char>(pattern[i + 1]), 0});
+                i += 2;
+                continue;
+            }
+
+            if (c == '*')
+            {
+                // 连续的 '*' 等价于一个
+                if (atoms_.empty() || atoms_.back().kind != Atom::Kind::STAR)
+                {
+                    atoms_.push_back(Atom{Atom::Kind::STAR, 0, 0});
+                }
+                ++i;
+                continue;
+            }
+
+            if (c == '?')
+            {
+                atoms_.push_back(Atom{Atom::Kind::ANY, 0, 0});
+                ++i;
+                continue;
+            }
+
+            if (c == '[')
+            {
+                // 解析方括号表达式，不闭合时 '[' 按普通字符处理
+                std::bitset<256> set;
+                size_t j = i + 1;
+                bool negate = j < pattern.size() && (pattern[j] == '!' || pattern[j] == '^');
+                if (negate)
+                {
+                    ++j;
+                }
+
+                bool closed = false;
+                bool first = true;
+                while (j < pattern.size())
+                {
+                    char ch = pattern[j];
+                    if (ch == ']' && !first)
+                    {
+                        closed = true;
+                        ++j;
+                        break;
+                    }
+                    first = false;
+
+                    if (ch == '[' && j + 1 < pattern.size() && pattern[j + 1] == ':')
+                    {
+                        size_t close = pattern.find(":]", j + 2);
+                        if (close != std::string_view::npos && addNamedClass(pattern.substr(j + 2, close - j - 2), set))
+                        {
+                            j = close + 2;
+                            continue;
+                        }
+                    }
+
+                    if (ch == '\\' && j + 1 < pattern.size())
+                    {
+                        ch = pattern[++j];
+                    }
+                    unsigned char lo = static_cast<unsigned char>(ch);
+                    ++j;
+
+                    if (j + 1 < pattern.size() && pattern[j] == '-' && pattern[j + 1] != ']')
+                    {
+                        char hi_ch = pattern[j + 1];
+                        j += 2;
+                        if (hi_ch == '\\' && j < pattern.size())
+                        {
+                            hi_ch = pattern[j++];
+                        }
+                        unsigned char hi = static_cast<unsigned char>(hi_ch);
+                        for (unsigned int k = lo; k <= hi; ++k)
+                        {
+                            set.set(k);
+                        }
+                    }
+                    else
+                    {
+                        set.set(lo);
+                    }
+                }
+
+                if (closed)
+                {
+                    if (negate)
+                    {
+                        set.flip();
+                    }
+                    classes_.push_back(set);
+                    atoms_.push_back(Atom{Atom::Kind::CLASS, 0, static_cast<uint16_t>(classes_.size() - 1)});
+                    i = j;
+                    continue;
+                }
+            }
+
+            atoms_.push_back(Atom{Atom::Kind::CHAR, static_cast<unsigned char>(c), 0});
+            ++i;
+        }
+
+        leading_dot_ = !atoms_.empty() && atoms_.front().kind == Atom::Kind::CHAR && atoms_.front().ch == '.';
+
+        // 按 '*' 切分片段，并记录片段是否都是普通字符
+        bool plain = true;
+        uint32_t piece_start = 0;
+        for (uint32_t k = 0; k < atoms_.size(); ++k)
+        {
+            if (atoms_[k].kind == Atom::Kind::STAR)
+            {
+                pieces_.push_back(Piece{piece_start, k});
+                piece_start = k + 1;
+                continue;
+            }
+            min_length_++;
+            if (atoms_[k].kind != Atom::Kind::CHAR)
+            {
+                plain = false;
+            }
+        }
+        pieces_.push_back(Piece{piece_start, static_cast<uint32_t>(atoms_.size())});
+
+        shape_ = Shape::GENERAL;
+        if (!plain || pieces_.size() > 3)
+        {
+            return;
+        }
+
+        // 只含普通字符且至多两个 '*' 时，识别可以用字符串比较完成的形状
+        auto pieceLength = [](const Piece &piece) { return piece.end - piece.begin; };
+        const Piece *fixed = nullptr;
+        if (pieces_.size() == 1)
+        {
+            shape_ = Shape::LITERAL;
+            fixed = &pieces_[0];
+        }
+        else if (pieces_.size() == 2)
+        {
+            if (pieceLength(pieces_[0]) == 0 && pieceLength(pieces_[1]) == 0)
+            {
+                shape_ = Shape::ANY;
+            }
+            else if (pieceLength(pieces_[1]) == 0)
+            {
+                shape_ = Shape::PREFIX;
+                fixed = &pieces_[0];
+            }
+            else if (pieceLength(pieces_[0]) == 0)
+            {
+                shape_ = Shape::SUFFIX;
+                fixed = &pieces_[1];
+            }
+        }
+        else if (pieceLength(pieces_[0]) == 0 && pieceLength(pieces_[2]) == 0)
+        {
+            shape_ = Shape::INFIX;
+            fixed = &pieces_[1];
+        }
+
+        if (fixed != nullptr)
+        {
+            for (uint32_t k = fixed->begin; k < fixed->end; ++k)
+            {
+                text_.push_back(static_cast<char>(atoms_[k].ch));
+            }
+        }
+        if (shape_ != Shape::GENERAL)
+        {
+            atoms_.clear();
+            pieces_.clear();
+        }
+    }
+
+    bool PatternMatcher::matchPiece(const Piece &piece, std::string_view str, size_t pos) const
+    {
+        for (uint32_t k = piece.begin; k < piece.end; ++k, ++pos)
+        {
+            const Atom &atom = atoms_[k];
+            unsigned char c = static_cast<unsigned char>(str[pos]);
+            switch (atom.kind)
+            {
+            case Atom::Kind::CHAR:
+                if (c != atom.ch)
+                {
+                    return false;
+                }
+                break;
+            case Atom::Kind::CLASS:
+                if (!classes_[atom.cls].test(c))
+                {
+                    return false;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool PatternMatcher::matches(std::string_view str) const
+    {
+        if (str.size() < min_length_)
+        {
+            return false;
+        }
+
+        std::string_view text(text_.data(), text_.size());
+        switch (shape_)
+        {
+        case Shape::LITERAL:
+            return str == text;
+        case Shape::PREFIX:
+            return str.compare(0, text.size(), text) == 0;
+        case Shape::SUFFIX:
+            return str.compare(str.size() - text.size(), text.size(), text) == 0;
+        case Shape::INFIX:
+            return str.find(text) != std::string_view::npos;
+        case Shape::ANY:
+            return true;
+        default:
+            break;
+        }
+
+        if (pieces_.size() == 1)
+        {
+            return str.size() == min_length_ && matchPiece(pieces_.front(), str, 0);
+        }
+
+        // 首片段锚定在开头
+        const Piece &head = pieces_.front();
+        if (!matchPiece(head, str, 0))
+        {
+            return false;
+        }
+        size_t pos = head.end - head.begin;
+
+        // 尾片段锚定在结尾，中间片段在两者之间取最左出现位置
+        const Piece &tail = pieces_.back();
+        size_t tail_pos = str.size() - (tail.end - tail.begin);
+        for (size_t p = 1; p + 1 < pieces_.size(); ++p)
+        {
+            const Piece &piece = pieces_[p];
+            size_t length = piece.end - piece.begin;
+            bool found = false;
+            for (; pos + length <= tail_pos; ++pos)
+            {
+                if (matchPiece(piece, str, pos))
+                {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+            {
+                return false;
+            }
+            pos += length;
+        }
+
+        return pos <= tail_pos && matchPiece(tail, str, tail_pos);
+    }
+
+} // namespace dash
@@ -0,0 +1,174 @@
+/**
+ * @file script_cache.cpp
+ * @brief 脚本缓存实现
+ */
+
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "core/script_cache.h"
+#include "core/shell.h"
+#include "core/parser.h"
+#include "core/lexer.h"
+#include "core/executor.h"
+#include "core/node.h"
+#include "utils/error.h"
+
+namespace dash
+{
+
+    Script::Script(Shell *shell, const std::string &text)
+        : shell_(shell), lexer_(std::make_unique<Lexer>(shell))
+    {
+        lexer_->setInput(text);
+    }
+
+    Script::~Script()
+    {
+    }
+
+    const Node *Script::command(size_t index)
+    {
+        while (commands_.size() <= index)
+        {
+            if (!error_.empty())
+            {
+                throw ShellException(ExceptionType::SYNTAX, error_);
+            }
+            if (!lexer_)
+            {
+                return nullptr;
+            }
+
+            std::unique_ptr<Node> node;
+            try
+            {
+                node = shell_->getParser()->parseScriptCommand(lexer_);
+            }
+            catch (const ShellException &e)
+            {
+                error_ = e.what();
+                lexer_.reset();
+                throw;
+            }
+
+            if (!node)
+            {
+                // 脚本已全部解析，不再需要词法分析器
+                lexer_.reset();
+                return nullptr;
+            }
+            commands_.push_back(std::move(node));
+        }
+        return commands_[index].get();
+    }
+
+    int Script::execute()
+    {
+        // 已缓存的命令节点在 commands_ 扩容时地址不变，嵌套 source 同一脚本也安全
+        Executor *executor = shell_->getExecutor();
+        int status = 0;
+        for (size_t i = 0;; ++i)
+        {
+            const Node *node = command(i);
+            if (!node)
+            {
+                break;
+            }
+            status = executor->execute(node);
+            if (executor->isUnwinding())
+            {
+                break;
+            }
+        }
+        return status;
+    }
+
+    ScriptCache::ScriptCache(Shell *shell)
+        : shell_(shell)
+    {
+    }
+
+    std::shared_ptr<Script> ScriptCache::load(const std::string &path)
+    {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+        {
+            throw ShellException(ExceptionType::IO, path + ": " + strerror(errno));
+        }
+
+        // 对已打开的描述符取属性，避免检查与读取之间文件被替换
+        struct stat st;
+        if (fstat(fd, &st) == -1)
+        {
+            int saved_errno = errno;
+            close(fd);
+            throw ShellException(ExceptionType::IO, path + ": " + strerror(saved_errno));
+        }
+
+        auto it = entries_.find(path);
+        if (it != entries_.end())
+        {
+            const Entry &entry = it->second;
+            if (entry.mtime == st.st_mtim.tv_sec && entry.mtime_nsec == st.st_mtim.tv_nsec &&
+                entry.size == st.st_size && entry.inode == st.st_ino && entry.device == st.st_dev)
+            {
+                close(fd);
+                return entry.script;
+            }
+        }
+
+        // 一次性读取整个文件
+        std::string text;
+        text.resize(static_cast<size_t>(st.st_size));
+        size_t length = 0;
+        while (true)
+        {
+            if (length == text.size())
+            {
+                // 文件在读取期间变长
+                text.resize(text.size() + 4096);
+            }
+
+            ssize_t n = read(fd, &text[length], text.size() - length);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                int saved_errno = errno;
+                close(fd);
+                throw ShellException(ExceptionType::IO, path + ": " + strerror(saved_errno));
+            }
+            if (n == 0)
+            {
+                break;
+            }
+            length += static_cast<size_t>(n);
+        }
+        close(fd);
+        text.resize(length);
+
+        // 将 Windows 换行符 \r\n 转为 \n
+        size_t out = 0;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] == '\r' && i + 1 < text.size() && text[i + 1] == '\n')
+            {
+                continue;
+            }
+            text[out++] = text[i];
+        }
+        text.resize(out);
+
+        // 命令留到执行时逐条解析
+        auto script = std::make_shared<Script>(shell_, text);
+
+        entries_[path] = Entry{st.st_mtim.tv_sec, st.st_mtim.tv_nsec, st.st_size, st.st_ino, st.st_dev, script};
+        return script;
+    }
+
+} // namespace dash
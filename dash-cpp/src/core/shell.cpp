@@ -10,6 +10,7 @@
 #include <cerrno> // 需要包含 errno
 #include <sys/wait.h>
 #include <vector>
+#include <algorithm>
 #include <climits>  // 添加：用于PATH_MAX
 #include <sys/stat.h>  // 添加：用于mkdir函数
 #include "core/shell.h"
@@ -18,11 +19,14 @@
 #include "core/executor.h"
 #include "variable/variable_manager.h"
 #include "job/job_control.h"
-#include "job/bg_job_adapter.h" // 添加适配器头文件
 #include "utils/error.h"
 #include "utils/history.h"
 #include "../core/debug.h"
 #include "core/alias.h"
+#include "core/script_cache.h"
+#include "core/node.h"
+#include "core/output.h"
+#include "core/event_loop.h"
 
 namespace dash
 {
@@ -57,11 +61,14 @@ namespace dash
         // 创建输入处理器
         input_ = std::make_unique<InputHandler>(this);
         
-        // 创建后台任务控制适配器
-        bg_job_adapter_ = std::make_unique<BGJobAdapter>(this, job_control_.get());
-        
         // 创建别名管理器
         alias_manager_ = std::make_unique<AliasManager>(*this);
+
+        // 创建脚本语法树缓存
+        script_cache_ = std::make_unique<ScriptCache>(this);
+
+        // 创建事件循环，交互模式下才打开
+        event_loop_ = std::make_unique<EventLoop>();
         
         // 将别名管理器设置为静态nowAliasManager
         AliasManager::nowAliasManager = alias_manager_.get();
@@ -69,6 +76,9 @@ namespace dash
         // 设置全局 Shell 实例指针
         g_shell = this;
 
+        // 标准输出经过 Shell 共用的缓冲区
+        OutputBuffer::install();
+
         // 初始化信号处理
         setupSignalHandlers();
     }
@@ -224,10 +234,15 @@ namespace dash
         variable_manager_->set("HISTORY_FILE", log_dir + "/dash_history");
         variable_manager_->set("DEBUG_LOG_FILE", log_dir + "/dash_debug.log");
         
-        // 设置环境变量给readline使用
-        setenv("DASH_HISTORY_FILE", (log_dir + "/dash_history").c_str(), 1);
-        setenv("DASH_SHELL_DIR", shell_dir.c_str(), 1);
-        setenv("DASH_DEBUG_LOG_FILE", (log_dir + "/dash_debug.log").c_str(), 1);
+        // 设置环境变量给readline使用：本进程通过 getenv 读取，子进程通过导出变量继承
+        const std::pair<const char *, std::string> dash_env[] = {
+            {"DASH_HISTORY_FILE", log_dir + "/dash_history"},
+            {"DASH_SHELL_DIR", shell_dir},
+            {"DASH_DEBUG_LOG_FILE", log_dir + "/dash_debug.log"}};
+        for (const auto &entry : dash_env) {
+            setenv(entry.first, entry.second.c_str(), 1);
+            variable_manager_->set(entry.first, entry.second, Variable::VAR_EXPORT);
+        }
     }
 
 
@@ -237,59 +252,42 @@ namespace dash
     {
         std::cout << "A simple dash-shell based by cpp." << std::endl;
 
-        sigset_t block_mask, orig_mask;
-        sigemptyset(&block_mask);
-        sigaddset(&block_mask, SIGCHLD);
-
-        // 尝试加载历史记录
+        // 加载历史记录，之后新命令追加到同一文件
         std::string history_file = variable_manager_->get("HISTORY_FILE");
         if (history_file.empty()) {
             std::string home_dir = getenv("HOME") ? getenv("HOME") : ".";
             history_file = home_dir + "/.dash_history";
         }
+        // HISTSIZE 设置最大历史记录数量
+        std::string histsize = variable_manager_->get("HISTSIZE");
+        if (!histsize.empty() && std::all_of(histsize.begin(), histsize.end(), ::isdigit)) {
+            try {
+                history_->setMaxSize(std::stoul(histsize));
+            } catch (const std::exception&) {
+                // 数值超出范围时保持默认值
+            }
+        }
         try {
-            history_->loadFromFile(history_file);
+            history_->openJournal(history_file);
         } catch (const std::exception& e) {
             std::cerr << "警告: 加载历史记录文件失败: " << e.what() << std::endl;
             std::cerr << "将创建新的历史记录文件" << std::endl;
         }
 
+        // 子进程状态变化和 Ctrl+C 由事件循环读取，等待输入时也能及时处理
+        if (!event_loop_->open()) {
+            std::cerr << "警告: 无法创建事件循环: " << strerror(errno) << std::endl;
+        }
+        event_loop_->setSignalCallback([this](int signo) { handleEvent(signo); });
+
         while (!exit_requested_)
         {
-            // 在循环开始，先安全地处理所有挂起的信号事件
-            sigprocmask(SIG_BLOCK, &block_mask, &orig_mask);
-
-            // 修复：使用 Shell:: 作用域访问静态成员
-            if (Shell::received_sigint) {
-                Shell::received_sigint = 0;
-                std::cout << std::endl; // 响应 Ctrl+C，打印换行
-            }
-            
-            // 修复：使用 Shell:: 作用域访问静态成员
-            if (Shell::received_sigchld) {
-                Shell::received_sigchld = 0;
-                if (job_control_ && job_control_->isEnabled()) {
-                    job_control_->updateStatus(0); // 更新所有作业状态
-                    
-                    // 打印已完成作业的通知
-                    bool has_notification = false;
-                    for (const auto& pair : job_control_->getJobs()) {
-                        const auto& job = pair.second;
-                        if (job->getStatus() == JobStatus::DONE && !job->isNotified()) {
-                             if (!has_notification) {
-                                std::cout << std::endl; // 在打印提示符前换行
-                                has_notification = true;
-                            }
-                            std::cout << "[" << job->getId() << "] 已完成\t" << job->getCommand() << std::endl;
-                            const_cast<Job*>(job.get())->setNotified(true);
-                        }
-                    }
-                    job_control_->cleanupJobs(); // 清理已完成且已通知的作业
-                }
+            // 处理执行命令期间到达的事件；事件循环不可用时每次读取命令前回收一次
+            if (event_loop_->isOpen()) {
+                event_loop_->dispatchPending();
+            } else {
+                reapChildren();
             }
-            
-            // 恢复信号掩码，准备读取用户输入
-            sigprocmask(SIG_SETMASK, &orig_mask, nullptr);
 
             // --- 交互逻辑 ---
             try
@@ -302,17 +300,7 @@ namespace dash
 
                  // 检查是否是文件结尾 (Ctrl+D)
                  if (input_->isEOF()) {
-                    // 在退出前保存历史记录
-                    try {
-                        std::string history_file = variable_manager_->get("HISTORY_FILE");
-                        if (history_file.empty()) {
-                            std::string home_dir = getenv("HOME") ? getenv("HOME") : ".";
-                            history_file = home_dir + "/.dash_history";
-                        }
-                        history_->saveToFile(history_file);
-                    } catch (const std::exception& e) {
-                        std::cerr << "警告: 保存历史记录文件失败: " << e.what() << std::endl;
-                    }
+                    // 历史记录已在每条命令加入时追加到文件，无需再保存
                     std::cout << "exit" << std::endl;
                     break; // 退出循环
                 }
@@ -328,14 +316,8 @@ namespace dash
                 }
 
                 // 3. 执行命令
-                // 在执行期间阻塞SIGCHLD，防止在操作作业列表时出现竞态条件
-                sigprocmask(SIG_BLOCK, &block_mask, &orig_mask);
-                if (command->getType() == NodeType::PIPE) {
-                    execute_pipeline(static_cast<const PipeNode*>(command.get()));
-                } else {
-                    executor_->execute(command.get());
-                }
-                sigprocmask(SIG_SETMASK, &orig_mask, nullptr);
+                // SIGCHLD 在事件循环打开期间一直被屏蔽，执行时不会打断作业列表的操作
+                executor_->execute(command.get());
             }
             catch (const ShellException &e)
             {
@@ -346,56 +328,66 @@ namespace dash
                     // 对于EXIT类型的异常，使用DebugLog输出
                     dash::DebugLog::logCommand(e.getTypeString() + ": " + e.what());
                 }
-                // 确保在异常情况下恢复信号掩码
-                sigprocmask(SIG_SETMASK, &orig_mask, nullptr);
             }
             catch (const std::exception &e)
             {
                 std::cerr << "Error: " << e.what() << std::endl;
-                // 确保在异常情况下恢复信号掩码
-                sigprocmask(SIG_SETMASK, &orig_mask, nullptr);
             }
-            // 在退出前保存历史记录
-        try {
-            history_->saveToFile(history_file);
-        } catch (const std::exception& e) {
-            std::cerr << "警告: 保存历史记录文件失败: " << e.what() << std::endl;
-        }
         }
 
+        event_loop_->close();
         return exit_status_;
     }
 
+    void Shell::handleEvent(int signo)
+    {
+        if (signo == SIGINT) {
+            // 执行命令期间的 Ctrl+C：前台进程已处理，这里只换行
+            std::cout << std::endl;
+        } else if (signo == SIGCHLD) {
+            reapChildren();
+        }
+    }
+
+    void Shell::reapChildren()
+    {
+        job_control_->updateStatus(0); // 更新所有作业状态
+        for (pid_t pid : event_loop_->takeExitedProcesses()) {
+            job_control_->processExited(pid);
+        }
+
+        // 收集已完成作业的通知
+        std::string notice;
+        for (const auto& job : job_control_->getJobs()) {
+            if (job && job->getStatus() == JobStatus::DONE && !job->isNotified()) {
+                notice += "[" + std::to_string(job->getId()) + "] 已完成\t" + job->getCommand() + "\n";
+                const_cast<Job*>(job.get())->setNotified(true);
+            }
+        }
+        job_control_->cleanupJobs(); // 清理已完成且已通知的作业
+
+        if (!notice.empty()) {
+            input_->showNotification(notice);
+        }
+    }
+
     int Shell::runScript()
     {
-        // 修复：恢复到原始的、正确的逐行读取逻辑
         try
         {
             if (!script_file_.empty())
             {
-                input_->pushFile(script_file_, InputHandler::IF_NONE);
-                for (size_t i = 0; i < script_args_.size(); ++i)
+                // $0 是脚本名，其余参数作为位置参数
+                variable_manager_->set("0", script_args_[0]);
+                std::vector<std::string> params(script_args_.begin() + 1, script_args_.end());
+                variable_manager_->swapPositional(params);
+
+                // 逐条解析并执行顶层命令
+                std::shared_ptr<Script> script = script_cache_->load(script_file_);
+                int status = script->execute();
+                if (!exit_requested_)
                 {
-                    variable_manager_->set(std::to_string(i), script_args_[i]);
-                }
-                variable_manager_->set("#", std::to_string(script_args_.size()));
-
-                while (!exit_requested_ && !input_->isEOF())
-                {
-                    std::string line = input_->readLine(false);
-                    if (!line.empty())
-                    {
-                        parser_->setInput(line);
-                        std::unique_ptr<Node> command = parser_->parseCommand(false);
-                        if (command)
-                        {
-                            if (command->getType() == NodeType::PIPE) {
-                                execute_pipeline(static_cast<const PipeNode*>(command.get()));
-                            } else {
-                                executor_->execute(command.get());
-                            }
-                        }
-                    }
+                    exit_status_ = status;
                 }
             }
             else if (!command_string_.empty())
@@ -404,16 +396,20 @@ namespace dash
                 std::unique_ptr<Node> command = parser_->parseCommand(false);
                 if (command)
                 {
-                    if (command->getType() == NodeType::PIPE) {
-                        execute_pipeline(static_cast<const PipeNode*>(command.get()));
-                    } else {
-                        executor_->execute(command.get());
+                    int status = executor_->execute(command.get());
+                    if (!exit_requested_)
+                    {
+                        exit_status_ = status;
                     }
                 }
             }
         }
         catch (const ShellException &e)
         {
+            if (e.getType() == ExceptionType::EXIT)
+            {
+                return exit_status_;
+            }
             std::cerr << e.getTypeString() << ": " << e.what() << std::endl;
             return 1;
         }
@@ -448,205 +444,6 @@ namespace dash
         exit_status_ = status;
     }
 
-    void collect_pipe_commands(const Node* node, std::vector<const Node*>& commands) {
-        if (node->getType() == NodeType::PIPE) {
-            const auto* pipe_node = static_cast<const PipeNode*>(node);
-            collect_pipe_commands(pipe_node->getLeft(), commands);
-            collect_pipe_commands(pipe_node->getRight(), commands);
-        } else {
-            commands.push_back(node);
-        }
-    }
-
-    int Shell::execute_pipeline(const PipeNode *node) {
-        int status = 0;
-        std::vector<const Node*> commands;
-        collect_pipe_commands(node, commands);
-
-        // 检查最后一个命令是否以 & 结尾，表示后台运行
-        bool background = false;
-        const auto *last_command = dynamic_cast<const CommandNode *>(commands.back());
-        if (last_command && !last_command->getArgs().empty()) {
-            const std::string &last_arg = last_command->getArgs().back();
-            if (last_arg == "&") {
-                background = true;
-                // 创建没有 & 的新参数数组
-                std::vector<std::string> new_args = last_command->getArgs();
-                new_args.pop_back(); // 移除 &
-                
-                // 如果是后台任务，使用后台任务控制系统
-                if (bg_job_adapter_->initialize()) {
-                    // 准备命令字符串
-                    std::string cmd_str;
-                    for (size_t i = 0; i < commands.size(); ++i) {
-                        const auto *cmd = dynamic_cast<const CommandNode *>(commands[i]);
-                        if (cmd) {
-                            if (i > 0) cmd_str += " | ";
-                            for (size_t j = 0; j < cmd->getArgs().size(); ++j) {
-                                if (j > 0) cmd_str += " ";
-                                // 跳过最后一个命令的 & 参数
-                                if (!(i == commands.size() - 1 && j == cmd->getArgs().size() - 1 && cmd->getArgs()[j] == "&")) {
-                                    cmd_str += cmd->getArgs()[j];
-                                }
-                            }
-                        }
-                    }
-                    
-                    // 创建作业
-                    struct job *jp = bg_job_adapter_->createJob(cmd_str, commands.size());
-                    if (!jp) {
-                        std::cerr << "无法创建后台作业\n";
-                        return 1;
-                    }
-                    
-                    // 创建管道
-                    int in_fd = 0;
-                    std::vector<pid_t> pids;
-                    
-                    for (size_t i = 0; i < commands.size(); ++i) {
-                        int pipe_fds[2];
-                        if (i < commands.size() - 1) {
-                            if (pipe(pipe_fds) < 0) {
-                                perror("pipe");
-                                return -1;
-                            }
-                        }
-                        
-                        // 获取命令参数
-                        const auto *command_node = dynamic_cast<const CommandNode *>(commands[i]);
-                        if (!command_node) {
-                            continue;
-                        }
-                        
-                        // 准备参数数组
-                        std::vector<std::string> cmd_args = command_node->getArgs();
-                        // 移除最后一个命令的 & 参数
-                        if (i == commands.size() - 1 && background && 
-                            !cmd_args.empty() && cmd_args.back() == "&") {
-                            cmd_args.pop_back();
-                        }
-                        
-                        // 转换为C风格参数数组
-                        std::vector<char*> argv;
-                        for (const auto &arg : cmd_args) {
-                            argv.push_back(const_cast<char*>(arg.c_str()));
-                        }
-                        argv.push_back(nullptr);
-                        
-                        // 使用适配器创建后台任务
-                        pid_t pid = forkparent_bg(jp, i == 0 ? FORK_BG : FORK_NOJOB);
-                        
-                        if (pid < 0) {
-                            perror("fork");
-                            return -1;
-                        } else if (pid == 0) { // 子进程
-                            // 设置管道
-                            forkchild_bg(jp, i == 0 ? FORK_BG : FORK_NOJOB);
-                            
-                            if (i > 0) {
-                                dup2(in_fd, 0);
-                                close(in_fd);
-                            }
-                            if (i < commands.size() - 1) {
-                                close(pipe_fds[0]);
-                                dup2(pipe_fds[1], 1);
-                                close(pipe_fds[1]);
-                            }
-                            
-                            // 执行命令
-                            execvp(argv[0], argv.data());
-                            perror(argv[0]);
-                            _exit(127);
-                        }
-                        
-                        // 父进程处理管道
-                        if (i > 0) {
-                            close(in_fd);
-                        }
-                        if (i < commands.size() - 1) {
-                            in_fd = pipe_fds[0];
-                            close(pipe_fds[1]);
-                        }
-                    }
-                    
-                    return 0;
-                }
-            }
-        }
-        
-        // 如果不是后台任务或初始化失败，使用原有方式执行
-        int in_fd = 0;
-        std::vector<pid_t> pids;
-
-        for (size_t i = 0; i < commands.size(); ++i) {
-            int pipe_fds[2];
-            if (i < commands.size() - 1) {
-                if (pipe(pipe_fds) < 0) {
-                    perror("pipe");
-                    return -1;
-                }
-            }
-
-            pid_t pid = fork();
-            if (pid < 0) {
-                perror("fork");
-                return -1;
-            }
-
-            if (pid == 0) { // Child
-                if (i > 0) {
-                    dup2(in_fd, 0);
-                    close(in_fd);
-                }
-                if (i < commands.size() - 1) {
-                    close(pipe_fds[0]);
-                    dup2(pipe_fds[1], 1);
-                    close(pipe_fds[1]);
-                }
-
-                const auto *command_node = dynamic_cast<const CommandNode *>(commands[i]);
-                if (command_node) {
-                    std::vector<std::string> cmd_args = command_node->getArgs();
-                    // 移除最后一个命令的 & 参数
-                    if (i == commands.size() - 1 && background && 
-                        !cmd_args.empty() && cmd_args.back() == "&") {
-                        cmd_args.pop_back();
-                    }
-                    executor_->exec_in_child(cmd_args[0], cmd_args);
-                } else {
-                    exit(EXIT_FAILURE);
-                }
-            }
-
-            pids.push_back(pid);
-
-            if (i > 0) {
-                close(in_fd);
-            }
-            if (i < commands.size() - 1) {
-                in_fd = pipe_fds[0];
-                close(pipe_fds[1]);
-            }
-        }
-
-        // 如果是后台任务，不等待子进程
-        if (background) {
-            std::cout << "[1] " << pids.back() << std::endl;
-            return 0;
-        }
-
-        // 否则等待所有子进程完成
-        for (pid_t pid : pids) {
-            int child_status;
-            waitpid(pid, &child_status, 0);
-            if (WIFEXITED(child_status)) {
-                status = WEXITSTATUS(child_status);
-            }
-        }
-
-        return status;
-    }
-
     // Getters (无变化)
     InputHandler *Shell::getInput() const { return input_.get(); }
     VariableManager *Shell::getVariableManager() const { return variable_manager_.get(); }
@@ -663,49 +460,6 @@ namespace dash
         return shell->run(argc, argv);
     }
 
-    // 添加executeBackground方法的实现
-    int Shell::executeBackground(const std::string &command, std::vector<std::string> &args)
-    {
-        // 初始化后台任务控制适配器（如果需要）
-        if (!bg_job_adapter_->initialize()) {
-            std::cerr << "无法初始化后台任务控制\n";
-            return 1;
-        }
-        
-        // 创建参数数组
-        std::vector<char*> argv;
-        for (const auto &arg : args) {
-            argv.push_back(const_cast<char*>(arg.c_str()));
-        }
-        argv.push_back(nullptr);
-        
-        // 创建命令字符串
-        std::string cmd_str = command;
-        for (size_t i = 1; i < args.size(); ++i) {
-            cmd_str += " " + args[i];
-        }
-        
-        // 创建作业
-        struct job *jp = bg_job_adapter_->createJob(cmd_str, 1);
-        if (!jp) {
-            std::cerr << "无法创建后台作业\n";
-            return 1;
-        }
-        
-        // 在后台运行命令
-        int result = bg_job_adapter_->runInBackground(jp, command, argv.data());
-        if (result != 0) {
-            return 1;
-        }
-        
-        return 0;
-    }
-    
-    // 添加getter方法实现
-    BGJobAdapter *Shell::getBGJobAdapter() const
-    {
-        return bg_job_adapter_.get();
-    }
     // 添加getHistory方法的实现
     History* Shell::getHistory() const 
     {
@@ -717,4 +471,14 @@ namespace dash
         return alias_manager_.get();
     }
 
+    ScriptCache *Shell::getScriptCache() const
+    {
+        return script_cache_.get();
+    }
+
+    EventLoop *Shell::getEventLoop() const
+    {
+        return event_loop_.get();
+    }
+
 } // namespace dash
\ No newline at end of file
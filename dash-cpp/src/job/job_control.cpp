@@ -13,17 +13,41 @@
 #include <mutex>
 #include <cstring>
 #include <cerrno>
-#include <map>
-#include <ctime>
-#include <unordered_set>
+#include <cctype>
+#include <algorithm>
+#include <functional>
 #include "job/job_control.h"
 #include "core/shell.h"
+#include "core/event_loop.h"
 #include "utils/error.h"
 #include "../src/core/debug.h"
 
 namespace dash
 {
 
+    namespace
+    {
+        /**
+         * @brief 将 waitpid 状态转换为 shell 的退出状态
+         */
+        int exitStatus(int status)
+        {
+            if (WIFEXITED(status))
+            {
+                return WEXITSTATUS(status);
+            }
+            if (WIFSIGNALED(status))
+            {
+                return 128 + WTERMSIG(status);
+            }
+            if (WIFSTOPPED(status))
+            {
+                return 128 + WSTOPSIG(status);
+            }
+            return 0;
+        }
+    }
+
     // Process 实现
 
     Process::Process(pid_t pid, const std::string &command)
@@ -50,77 +74,25 @@ namespace dash
         processes_.push_back(std::make_unique<Process>(pid, command));
     }
 
-    bool Job::updateStatus()
+    bool Job::syncStatus()
     {
-        bool status_changed = false;
-
-        // 检查每个进程的状态
-        for (auto &process : processes_)
-        {
-            if (process->isCompleted())
-            {
-                continue;
-            }
+        // 进程的完成和停止标志由 JobControl 回收子进程时记录，这里不再调用 waitpid
+        JobStatus old_status = status_;
 
-            int status;
-            pid_t result = waitpid(process->getPid(), &status, WUNTRACED | WNOHANG);
-
-            if (result == 0)
-            {
-                // 进程仍在运行
-                continue;
-            }
-            else if (result < 0)
-            {
-                // waitpid错误，但进程可能仍在运行（如果是守护进程）
-                // 使用kill(pid, 0)检查进程是否存在
-                if (errno == ECHILD && kill(process->getPid(), 0) == 0)
-                {
-                    // 进程存在但不是子进程，可能是守护进程
-                    continue; // 保持运行状态
-                }
-                else
-                {
-                    // 进程确实不存在
-                    process->setCompleted(true);
-                    status_changed = true;
-                }
-            }
-            else if (result == process->getPid())
-            {
-                // 进程状态已更改
-                process->setStatus(status);
-
-                if (WIFSTOPPED(status))
-                {
-                    process->setStopped(true);
-                    status_changed = true;
-                }
-                else
-                {
-                    process->setCompleted(true);
-                    status_changed = true;
-                }
-            }
-        }
-
-        // 更新作业状态
         if (isCompleted())
         {
             status_ = JobStatus::DONE;
-            status_changed = true;
         }
         else if (isStopped())
         {
             status_ = JobStatus::STOPPED;
-            status_changed = true;
         }
         else
         {
             status_ = JobStatus::RUNNING;
         }
 
-        return status_changed;
+        return status_ != old_status;
     }
 
     int Job::putInForeground(bool cont)
@@ -275,14 +247,16 @@ namespace dash
     // JobControl 实现
 
     JobControl::JobControl(Shell *shell)
-        : shell_(shell), next_job_id_(1), enabled_(false), terminal_fd_(-1), shell_pgid_(-1), current_job_id_(-1)
+        : shell_(shell), enabled_(false), terminal_fd_(-1), shell_pgid_(-1), current_job_id_(-1)
     {
     }
 
     JobControl::~JobControl()
     {
         // 清理作业
+        pid_index_.clear();
         jobs_.clear();
+        free_ids_.clear();
     }
 
     void JobControl::initialize()
@@ -328,22 +302,103 @@ namespace dash
 
     Job *JobControl::findJob(int id) const
     {
-        auto it = jobs_.find(id);
-        if (it != jobs_.end())
+        if (id < 1 || static_cast<size_t>(id) > jobs_.size())
         {
-            return it->second.get();
+            return nullptr;
         }
 
-        return nullptr;
+        return jobs_[id - 1].get();
+    }
+
+    Job *JobControl::findJobByPid(pid_t pid) const
+    {
+        return findProcess(pid).job;
+    }
+
+    Job *JobControl::resolveJobSpec(const std::string &spec) const
+    {
+        std::string body = !spec.empty() && spec[0] == '%' ? spec.substr(1) : spec;
+
+        if (body.empty() || body == "%" || body == "+")
+        {
+            return findCurrentJob();
+        }
+        if (body == "-")
+        {
+            return findPreviousJob();
+        }
+
+        if (std::all_of(body.begin(), body.end(), [](unsigned char c) { return std::isdigit(c); }))
+        {
+            // 超出范围的作业号按不存在处理
+            return body.size() > 9 ? nullptr : findJob(std::stoi(body));
+        }
+
+        // %?子串 匹配命令中任意位置，其余按命令前缀匹配；匹配多个作业时视为歧义
+        bool substring = body[0] == '?';
+        std::string pattern = substring ? body.substr(1) : body;
+        Job *match = nullptr;
+        for (const auto &job : jobs_)
+        {
+            if (!job)
+            {
+                continue;
+            }
+            const std::string &command = job->getCommand();
+            bool matched = substring ? command.find(pattern) != std::string::npos
+                                     : command.compare(0, pattern.size(), pattern) == 0;
+            if (matched)
+            {
+                if (match)
+                {
+                    return nullptr;
+                }
+                match = job.get();
+            }
+        }
+
+        return match;
     }
 
     int JobControl::addJob(const std::string &command, pid_t pgid)
     {
-        int job_id = next_job_id_++;
-        jobs_[job_id] = std::make_unique<Job>(job_id, command, pgid, terminal_fd_);
+        // 优先复用最小的空闲作业号，否则在槽位数组末尾追加
+        int job_id;
+        if (!free_ids_.empty())
+        {
+            std::pop_heap(free_ids_.begin(), free_ids_.end(), std::greater<int>());
+            job_id = free_ids_.back();
+            free_ids_.pop_back();
+        }
+        else
+        {
+            jobs_.emplace_back();
+            job_id = static_cast<int>(jobs_.size());
+        }
+
+        jobs_[job_id - 1] = std::make_unique<Job>(job_id, command, pgid, terminal_fd_);
         return job_id;
     }
 
+    void JobControl::releaseJob(int job_id)
+    {
+        Job *job = findJob(job_id);
+        if (!job)
+        {
+            return;
+        }
+
+        unindexJob(job);
+        jobs_[job_id - 1].reset();
+        free_ids_.push_back(job_id);
+        std::push_heap(free_ids_.begin(), free_ids_.end(), std::greater<int>());
+
+        if (current_job_id_ == job_id)
+        {
+            current_job_id_ = -1;
+        }
+    }
+
     bool JobControl::addProcess(int job_id, pid_t pid, const std::string &command)
     {
         Job *job = findJob(job_id);
@@ -353,9 +408,38 @@ namespace dash
         }
 
         job->addProcess(pid, command);
+        // 进程 ID 被复用时，新进程覆盖旧的索引项
+        pid_index_[pid] = ProcessRef{job, job->getProcesses().back().get()};
+        // 进程退出时唤醒事件循环
+        shell_->getEventLoop()->watchProcess(pid);
         return true;
     }
 
+    JobControl::ProcessRef JobControl::findProcess(pid_t pid) const
+    {
+        auto it = pid_index_.find(pid);
+        if (it != pid_index_.end())
+        {
+            return it->second;
+        }
+
+        return ProcessRef{nullptr, nullptr};
+    }
+
+    void JobControl::unindexJob(const Job *job)
+    {
+        for (const auto &process : job->getProcesses())
+        {
+            auto it = pid_index_.find(process->getPid());
+            // 只移除仍指向本作业的索引项，进程 ID 可能已被其他作业复用
+            if (it != pid_index_.end() && it->second.process == process.get())
+            {
+                pid_index_.erase(it);
+                shell_->getEventLoop()->unwatchProcess(process->getPid());
+            }
+        }
+    }
+
     // 添加一个静态变量来防止递归调用
     static bool is_updating = false;
 
@@ -391,45 +475,31 @@ namespace dash
 
             if (pid > 0)
             {
-                // 找到了一个状态改变的子进程
-                // 更新对应进程的状态
-                bool process_found = false;
-                for (auto &pair : jobs_)
+                // 找到了一个状态改变的子进程，通过索引定位对应进程
+                ProcessRef ref = findProcess(pid);
+                bool process_found = ref.process != nullptr;
+                if (process_found)
                 {
-                    Job *job = pair.second.get();
-                    bool job_updated = false;
+                    Process *process = ref.process;
+                    Job *job = ref.job;
 
-                    for (const auto &process : job->getProcesses())
+                    // 更新进程状态
+                    if (WIFSTOPPED(status))
                     {
-                        if (process->getPid() == pid)
-                        {
-                            process_found = true;
-                            // 更新进程状态
-                            if (WIFSTOPPED(status))
-                            {
-                                process->setStopped(true);
-                                process->setStatus(status);
-                            }
-                            else
-                            {
-                                process->setCompleted(true);
-                                process->setStatus(status);
-                            }
-                            job_updated = true;
-                            break;
-                        }
+                        process->setStopped(true);
+                        process->setStatus(status);
+                    }
+                    else
+                    {
+                        process->setCompleted(true);
+                        process->setStatus(status);
                     }
 
-                    if (job_updated)
+                    // 只有状态确实发生了变化，才设置为未通知
+                    if (job->syncStatus() &&
+                        (job->getStatus() == JobStatus::DONE || job->getStatus() == JobStatus::STOPPED))
                     {
-                        // 更新作业状态
-                        job->updateStatus();
-                        // 只有状态确实发生了变化，才设置为未通知
-                        if (job->getStatus() == JobStatus::DONE || job->getStatus() == JobStatus::STOPPED)
-                        {
-                            job->setNotified(false);
-                        }
-                        break;
+                        job->setNotified(false);
                     }
                 }
 
@@ -446,44 +516,111 @@ namespace dash
             }
         } while (pid > 0);
 
-        // 无论waitpid结果如何，都要检查所有作业中的进程状态
-        // 这对于处理守护进程（双重fork后被init接管的进程）特别重要
-        for (auto &pair : jobs_)
+        // 所有作业进程都是 shell 的子进程，waitpid 已能取得全部状态变化
+        is_updating = false;
+    }
+
+    void JobControl::processExited(pid_t pid)
+    {
+        ProcessRef ref = findProcess(pid);
+        if (!ref.process || ref.process->isCompleted())
         {
-            Job *job = pair.second.get();
+            return;
+        }
 
-            // 对于每个RUNNING状态的作业，检查其进程是否仍然存在
-            if (job->getStatus() == JobStatus::RUNNING)
-            {
-                bool all_completed = true;
+        // shell 的子进程仍按 waitpid 取得退出状态，其他进程只能记为已完成
+        int status = 0;
+        if (waitpid(pid, &status, WNOHANG) <= 0)
+        {
+            status = 0;
+        }
+        ref.process->setStatus(status);
+        ref.process->setCompleted(true);
 
-                for (const auto &process : job->getProcesses())
+        if (ref.job->syncStatus() && ref.job->getStatus() == JobStatus::DONE)
+        {
+            ref.job->setNotified(false);
+        }
+    }
+
+    int JobControl::waitForChange()
+    {
+        siginfo_t info;
+        info.si_pid = 0;
+
+        // 已有可回收的子进程时不必阻塞；没有子进程时阻塞会永远等下去
+        if (waitid(P_ALL, 0, &info, WEXITED | WSTOPPED | WNOHANG | WNOWAIT) < 0)
+        {
+            markAllCompleted();
+            return -1;
+        }
+
+        if (info.si_pid == 0)
+        {
+            EventLoop *event_loop = shell_->getEventLoop();
+            if (event_loop->isOpen())
+            {
+                // SIGCHLD 和 SIGINT 都被屏蔽并由 signalfd 读取，只能在 epoll 上等待
+                int signo = event_loop->waitSignal();
+                if (signo == SIGINT)
+                {
+                    updateStatus(0);
+                    event_loop->dispatch(SIGINT);
+                    return 0;
+                }
+                if (signo < 0)
+                {
+                    // epoll 出错时按中断处理，避免调用者空转
+                    return 0;
+                }
+            }
+            else
+            {
+                // WNOWAIT 只等待不回收，回收统一交给 updateStatus()
+                while (waitid(P_ALL, 0, &info, WEXITED | WSTOPPED | WNOWAIT) < 0)
                 {
-                    if (!process->isCompleted())
+                    if (errno == ECHILD)
                     {
-                        // 使用kill(pid, 0)检查进程是否存在
-                        if (kill(process->getPid(), 0) == 0)
-                        {
-                            // 进程存在
-                            all_completed = false;
-                        }
-                        else if (errno == ESRCH)
-                        {
-                            // 进程不存在
-                            process->setCompleted(true);
-                        }
+                        markAllCompleted();
+                        return -1;
+                    }
+                    if (errno == EINTR && Shell::received_sigint)
+                    {
+                        Shell::received_sigint = 0;
+                        return 0;
                     }
                 }
+            }
+        }
 
-                // 如果所有进程都已完成，更新作业状态
-                if (all_completed && job->getProcesses().size() > 0)
-                {
-                    job->updateStatus();
-                }
+        updateStatus(0);
+        return 1;
+    }
+
+    void JobControl::markAllCompleted()
+    {
+        for (const auto &job : jobs_)
+        {
+            if (!job || job->isCompleted())
+            {
+                continue;
             }
+            for (const auto &process : job->getProcesses())
+            {
+                process->setCompleted(true);
+            }
+            job->syncStatus();
+            job->setNotified(false);
         }
+    }
 
-        is_updating = false;
+    void JobControl::finishWait(Job *job)
+    {
+        if (job->isCompleted())
+        {
+            job->setNotified(true);
+            releaseJob(job->getId());
+        }
     }
 
     int JobControl::waitForJob(int job_id)
@@ -494,24 +631,128 @@ namespace dash
             return -1;
         }
 
-        // 等待作业完成或停止
-        int status = 0;
-
         while (!job->isCompleted() && !job->isStopped())
         {
-            // 更新作业状态
-            job->updateStatus();
+            if (waitForChange() == 0)
+            {
+                return WAIT_INTERRUPTED;
+            }
         }
 
         // 获取最后一个进程的状态
-        if (!job->getProcesses().empty())
+        int status = job->getProcesses().empty() ? 0 : exitStatus(job->getProcesses().back()->getStatus());
+        finishWait(job);
+        return status;
+    }
+
+    int JobControl::waitForProcess(pid_t pid)
+    {
+        ProcessRef ref = findProcess(pid);
+        if (!ref.process)
         {
-            status = job->getProcesses().back()->getStatus();
+            return 127;
         }
 
+        while (!ref.process->isCompleted())
+        {
+            if (waitForChange() == 0)
+            {
+                return WAIT_INTERRUPTED;
+            }
+        }
+
+        int status = exitStatus(ref.process->getStatus());
+        finishWait(ref.job);
         return status;
     }
 
+    int JobControl::waitForAnyJob(const std::vector<int> &job_ids, int &finished)
+    {
+        while (true)
+        {
+            Job *done = nullptr;
+            bool pending = false;
+            auto check = [&](Job *job)
+            {
+                if (!job || done)
+                {
+                    return;
+                }
+                if (job->isCompleted())
+                {
+                    done = job;
+                }
+                else if (!job->isStopped())
+                {
+                    pending = true;
+                }
+            };
+
+            if (job_ids.empty())
+            {
+                for (const auto &job : jobs_)
+                {
+                    check(job.get());
+                }
+            }
+            else
+            {
+                for (int id : job_ids)
+                {
+                    check(findJob(id));
+                }
+            }
+
+            if (done)
+            {
+                finished = done->getId();
+                int status = done->getProcesses().empty() ? 0 : exitStatus(done->getProcesses().back()->getStatus());
+                finishWait(done);
+                return status;
+            }
+            if (!pending)
+            {
+                return 127;
+            }
+            if (waitForChange() == 0)
+            {
+                return WAIT_INTERRUPTED;
+            }
+        }
+    }
+
+    int JobControl::waitForAllJobs()
+    {
+        auto pending = [this]()
+        {
+            for (const auto &job : jobs_)
+            {
+                if (job && !job->isCompleted() && !job->isStopped())
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        while (pending())
+        {
+            if (waitForChange() == 0)
+            {
+                return WAIT_INTERRUPTED;
+            }
+        }
+
+        for (const auto &job : jobs_)
+        {
+            if (job)
+            {
+                finishWait(job.get());
+            }
+        }
+        return 0;
+    }
+
     int JobControl::putJobInForeground(int job_id, bool cont)
     {
         Job *job = findJob(job_id);
@@ -520,8 +761,14 @@ namespace dash
             return -1;
         }
 
-        // 将作业放入前台
-        return job->putInForeground(cont);
+        // 将作业放入前台，前台结束的作业不再需要通知
+        int status = job->putInForeground(cont);
+        if (job->getStatus() == JobStatus::DONE)
+        {
+            job->setNotified(true);
+            releaseJob(job_id);
+        }
+        return status;
     }
 
     void JobControl::putJobInBackground(int job_id, bool cont)
@@ -538,17 +785,15 @@ namespace dash
 
     void JobControl::showJobs(bool changed_only, bool show_running, bool show_stopped, bool show_pids)
     {
-        // 更新所有作业的状态
-        for (auto &pair : jobs_)
-        {
-            Job *job = pair.second.get();
-            job->updateStatus();
-        }
-
-        // 显示作业状态
-        for (auto &pair : jobs_)
+        // 作业状态已由 updateStatus() 回收子进程时记录，这里只负责显示
+        // 按作业号顺序显示作业状态
+        for (auto &slot : jobs_)
         {
-            Job *job = pair.second.get();
+            Job *job = slot.get();
+            if (!job)
+            {
+                continue;
+            }
 
             // 如果只显示状态已更改的作业，则跳过已通知的作业
             if (changed_only && job->isNotified())
@@ -614,7 +859,7 @@ namespace dash
             }
 
             // 显示命令
-            std::cout << "\t" << job->getCommand() << std::endl;
+            std::cout << "\t" << job->getCommand() << '\n';
 
             // 标记作业为已通知
             job->setNotified(true);
@@ -626,9 +871,9 @@ namespace dash
 
     bool JobControl::hasStoppedJobs() const
     {
-        for (const auto &pair : jobs_)
+        for (const auto &job : jobs_)
         {
-            if (pair.second->getStatus() == JobStatus::STOPPED)
+            if (job && job->getStatus() == JobStatus::STOPPED)
             {
                 return true;
             }
@@ -639,26 +884,21 @@ namespace dash
 
     void JobControl::cleanupJobs()
     {
-        // 删除已完成的作业
-        for (auto it = jobs_.begin(); it != jobs_.end();)
+        // 释放已完成且已通知的作业的槽位
+        for (const auto &job : jobs_)
         {
-            if (it->second->getStatus() == JobStatus::DONE && it->second->isNotified())
+            if (job && job->getStatus() == JobStatus::DONE && job->isNotified())
             {
-                it = jobs_.erase(it);
-            }
-            else
-            {
-                ++it;
+                releaseJob(job->getId());
             }
         }
     }
 
     bool JobControl::hasActiveJobs() const
     {
-        for (const auto &pair : jobs_)
+        for (const auto &job : jobs_)
         {
-            const auto &job = pair.second;
-            if (job->getStatus() == JobStatus::RUNNING || job->getStatus() == JobStatus::STOPPED)
+            if (job && (job->getStatus() == JobStatus::RUNNING || job->getStatus() == JobStatus::STOPPED))
             {
                 return true;
             }
@@ -668,26 +908,33 @@ namespace dash
 
     Job *JobControl::findCurrentJob() const
     {
-        if (current_job_id_ == -1)
+        Job *current = findJob(current_job_id_);
+        if (current)
+        {
+            return current;
+        }
+
+        // 没有当前作业，使用作业号最大的作业
+        for (auto it = jobs_.rbegin(); it != jobs_.rend(); ++it)
         {
-            // 没有当前作业，尝试找到最新的作业
-            int newest_job_id = -1;
-            for (const auto &pair : jobs_)
+            if (*it)
             {
-                if (newest_job_id == -1 || pair.first > newest_job_id)
-                {
-                    newest_job_id = pair.first;
-                }
+                return it->get();
             }
+        }
+        return nullptr;
+    }
 
-            if (newest_job_id != -1)
+    Job *JobControl::findPreviousJob() const
+    {
+        Job *current = findCurrentJob();
+        for (auto it = jobs_.rbegin(); it != jobs_.rend(); ++it)
+        {
+            if (*it && it->get() != current)
             {
-                // 找到最新作业
-                return findJob(newest_job_id);
+                return it->get();
             }
-            return nullptr;
         }
-
-        return findJob(current_job_id_);
+        return nullptr;
     }
 }
\ No newline at end of file
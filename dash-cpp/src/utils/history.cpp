@@ -10,6 +10,13 @@
 #include <algorithm>
 #include <ctime>
 #include <regex>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
 #include "../core/debug.h"
 
 // 添加readline相关头文件，条件包含
@@ -21,12 +28,13 @@
 namespace dash {
 
 History::History(Shell& shell, size_t maxSize)
-    : shell_(shell), maxSize_(maxSize), nextIndex_(1) {
+    : shell_(shell), head_(0), maxSize_(maxSize), nextIndex_(1), journalFd_(-1), journalLines_(0),
+      journalOffset_(0), journalBase_(0) {
     // 初始化
 }
 
 History::~History() {
-    // 清理资源
+    closeJournal();
 }
 
 void History::addCommand(const std::string& command) {
@@ -35,7 +43,7 @@ void History::addCommand(const std::string& command) {
     }
     
     // 避免重复连续的命令
-    if (!history_.empty() && history_.back().command == command) {
+    if (!ring_.empty() && back().command == command) {
         return;
     }
     
@@ -45,11 +53,12 @@ void History::addCommand(const std::string& command) {
     entry.command = command;
     entry.timestamp = std::time(nullptr);
     
-    history_.push_back(entry);
-    
-    // 如果超过最大记录数，删除最旧的记录
-    if (history_.size() > maxSize_) {
-        history_.erase(history_.begin());
+    // 超过最大记录数时覆盖最旧的记录
+    push(std::move(entry));
+
+    // 只把新条目追加到日志
+    if (!ring_.empty()) {
+        appendToJournal(back());
     }
     
     // 同步命令到readline历史记录
@@ -64,40 +73,81 @@ void History::addCommand(const std::string& command) {
 #endif
 }
 
+void History::push(HistoryEntry entry) {
+    if (maxSize_ == 0) {
+        return;
+    }
+    if (ring_.size() < maxSize_) {
+        ring_.push_back(std::move(entry));
+        return;
+    }
+    ring_[head_] = std::move(entry);
+    head_ = head_ + 1 == ring_.size() ? 0 : head_ + 1;
+}
+
+const HistoryEntry& History::back() const {
+    return getAllCommands()[ring_.size() - 1];
+}
+
 const HistoryEntry* History::getCommand(int index) const {
-    for (const auto& entry : history_) {
-        if (entry.index == index) {
-            return &entry;
-        }
+    // 保留的条目编号连续：[nextIndex_ - size, nextIndex_)
+    int first = nextIndex_ - static_cast<int>(ring_.size());
+    if (index < first || index >= nextIndex_) {
+        return nullptr;
     }
-    return nullptr;
+    return &getAllCommands()[static_cast<size_t>(index - first)];
 }
 
-std::vector<HistoryEntry> History::getRecentCommands(size_t count) const {
-    std::vector<HistoryEntry> result;
-    size_t size = history_.size();
-    
+HistoryView History::getRecentCommands(size_t count) const {
+    size_t size = ring_.size();
     if (count > size) {
         count = size;
     }
-    
-    result.reserve(count);
-    auto startIter = history_.end() - count;
-    
-    for (auto it = startIter; it != history_.end(); ++it) {
-        result.push_back(*it);
+
+    // 跳过最旧的 size - count 条
+    size_t start = head_ + (size - count);
+    if (start >= size && size > 0) {
+        start -= size;
     }
-    
-    return result;
+    return HistoryView(ring_, start, count);
 }
 
-const std::vector<HistoryEntry>& History::getAllCommands() const {
-    return history_;
+HistoryView History::getAllCommands() const {
+    return HistoryView(ring_, head_, ring_.size());
+}
+
+void History::setMaxSize(size_t maxSize) {
+    if (maxSize == maxSize_) {
+        return;
+    }
+
+    // 按逻辑顺序重排，只保留最近的 maxSize 条
+    size_t size = ring_.size();
+    size_t keep = std::min(size, maxSize);
+    std::vector<HistoryEntry> ring;
+    ring.reserve(keep);
+    for (size_t i = size - keep; i < size; ++i) {
+        ring.push_back(std::move(ring_[(head_ + i) % size]));
+    }
+    ring_.swap(ring);
+    head_ = 0;
+    maxSize_ = maxSize;
 }
 
 void History::clear() {
-    history_.clear();
+    ring_.clear();
+    head_ = 0;
     nextIndex_ = 1;
+
+    // 日志同时清空
+    if (journalFd_ >= 0 && lockJournal(LOCK_EX)) {
+        if (ftruncate(journalFd_, 0) == 0) {
+            journalLines_ = 0;
+            journalOffset_ = 0;
+            journalBase_ = nextIndex_;
+        }
+        flock(journalFd_, LOCK_UN);
+    }
     
     // 同时清除readline历史记录
 #ifdef READLINE_ENABLED
@@ -112,7 +162,11 @@ bool History::loadFromFile(const std::string& filename) {
         return false;
     }
     
-    clear();  // 这将同时清除内部历史和readline历史
+    // 清除内部历史和readline历史，但不清空日志：加载失败时日志保持原样
+    int journalFd = journalFd_;
+    journalFd_ = -1;
+    clear();
+    journalFd_ = journalFd;
     
     std::string line;
     while (std::getline(file, line)) {
@@ -134,12 +188,12 @@ bool History::loadFromFile(const std::string& filename) {
                 entry.index = nextIndex_++;
                 entry.timestamp = timestamp;
                 entry.command = line.substr(spacePos + 1);
-                history_.push_back(entry);
-                
+
                 // 同步到readline历史记录
 #ifdef READLINE_ENABLED
                 add_history(entry.command.c_str());
 #endif
+                push(std::move(entry));
             } catch (const std::exception& e) {
                 // 如果解析时间戳失败，将整行视为命令
                 DebugLog::logCommand("警告: 解析历史记录行失败: " + line + " (" + e.what() + ")");
@@ -149,12 +203,12 @@ bool History::loadFromFile(const std::string& filename) {
                 entry.index = nextIndex_++;
                 entry.timestamp = std::time(nullptr);  // 使用当前时间作为时间戳
                 entry.command = line;
-                history_.push_back(entry);
-                
+
                 // 同步到readline历史记录
 #ifdef READLINE_ENABLED
                 add_history(entry.command.c_str());
 #endif
+                push(std::move(entry));
             }
         } else {
             // 如果没有空格，将整行视为命令
@@ -162,16 +216,239 @@ bool History::loadFromFile(const std::string& filename) {
             entry.index = nextIndex_++;
             entry.timestamp = std::time(nullptr);  // 使用当前时间作为时间戳
             entry.command = line;
-            history_.push_back(entry);
-            
+
             // 同步到readline历史记录
 #ifdef READLINE_ENABLED
             add_history(entry.command.c_str());
 #endif
+            push(std::move(entry));
         }
     }
     
-    DebugLog::logCommand("从文件加载了 " + std::to_string(history_.size()) + " 条历史记录: " + filename);
+    // 从其他文件加载时，日志改为记录新加载的内容
+    if (journalFd_ >= 0 && filename != journalPath_) {
+        compactJournal(false);
+    } else if (journalFd_ >= 0) {
+        // 重新加载日志本身，内存条目的编号已重排，压缩时整个日志都按尾部读取
+        journalOffset_ = 0;
+        journalBase_ = 0;
+    }
+
+    DebugLog::logCommand("从文件加载了 " + std::to_string(ring_.size()) + " 条历史记录: " + filename);
+    return true;
+}
+
+void History::formatEntry(const HistoryEntry& entry, std::string& out) {
+    // 确保时间戳是有效的
+    time_t timestamp = entry.timestamp;
+    if (timestamp <= 0) {
+        timestamp = std::time(nullptr);  // 如果时间戳无效，使用当前时间
+    }
+
+    // 保存格式：时间戳 命令
+    out += std::to_string(timestamp);
+    out += ' ';
+    out += entry.command;
+    out += '\n';
+}
+
+bool History::openJournal(const std::string& filename) {
+    closeJournal();
+
+    int fd = open(filename.c_str(), O_RDWR | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        DebugLog::logCommand("无法打开历史记录文件: " + filename + " (" + std::strerror(errno) + ")");
+        loadFromFile(filename);
+        return false;
+    }
+    journalFd_ = fd;
+    journalPath_ = filename;
+
+    // 加载期间持有独占锁，其他 shell 不能追加或替换日志，加载的正好是当前文件的全部内容
+    bool locked = lockJournal(LOCK_EX);
+    loadFromFile(filename);
+
+    // 文件中的行数（加载时可能已被截到 maxSize 条）
+    std::ifstream file(filename);
+    journalLines_ = std::count(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>(), '\n');
+
+    if (locked) {
+        // 此后追加的内容，无论来自哪个 shell，压缩时都从这个位置读取
+        struct stat st;
+        if (fstat(journalFd_, &st) == 0) {
+            journalOffset_ = st.st_size;
+            journalBase_ = nextIndex_;
+        }
+        flock(journalFd_, LOCK_UN);
+    }
+
+    if (journalLines_ > maxSize_ * 2) {
+        compactJournal();
+    }
+    return true;
+}
+
+void History::closeJournal() {
+    if (journalFd_ >= 0) {
+        close(journalFd_);
+        journalFd_ = -1;
+    }
+    journalPath_.clear();
+    journalLines_ = 0;
+    journalOffset_ = 0;
+    journalBase_ = 0;
+}
+
+bool History::lockJournal(int operation) {
+    while (true) {
+        while (flock(journalFd_, operation) < 0) {
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+
+        // 锁住的仍是当前的日志文件
+        struct stat opened;
+        struct stat current;
+        if (fstat(journalFd_, &opened) == 0 && stat(journalPath_.c_str(), &current) == 0 &&
+            opened.st_dev == current.st_dev && opened.st_ino == current.st_ino) {
+            return true;
+        }
+
+        // 日志已被其他 shell 压缩替换，旧描述符上的锁随 close 释放
+        int fd = open(journalPath_.c_str(), O_RDWR | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            flock(journalFd_, LOCK_UN);
+            return false;
+        }
+        close(journalFd_);
+        journalFd_ = fd;
+
+        // 新文件由其他 shell 写出，压缩时整个文件都按尾部读取
+        journalOffset_ = 0;
+        journalBase_ = 0;
+    }
+}
+
+void History::appendToJournal(const HistoryEntry& entry) {
+    if (journalFd_ < 0) {
+        return;
+    }
+
+    // 整行一次 write，O_APPEND 保证与其他 shell 的追加不交错；
+    // 共享锁保证不会写进正在被压缩替换的旧文件
+    std::string line;
+    formatEntry(entry, line);
+    if (!lockJournal(LOCK_SH)) {
+        DebugLog::logCommand("锁定历史记录文件失败: " + journalPath_);
+        return;
+    }
+    ssize_t written;
+    do {
+        written = write(journalFd_, line.data(), line.size());
+    } while (written < 0 && errno == EINTR);
+    flock(journalFd_, LOCK_UN);
+    if (written != static_cast<ssize_t>(line.size())) {
+        DebugLog::logCommand("追加历史记录失败: " + journalPath_);
+        return;
+    }
+
+    // 日志增长到 maxSize 的两倍时才压缩一次，平均每条命令的代价是常数
+    if (++journalLines_ > maxSize_ * 2) {
+        compactJournal();
+    }
+}
+
+bool History::compactJournal(bool mergeTail) {
+    if (!lockJournal(LOCK_EX)) {
+        return false;
+    }
+
+    // 内存中的条目只写出日志前缀中的部分，之后的条目会从日志尾部读到
+    std::string contents;
+    for (const auto& entry : getAllCommands()) {
+        if (!mergeTail || entry.index < journalBase_) {
+            formatEntry(entry, contents);
+        }
+    }
+
+    // 尾部含有本 shell 和其他 shell 追加的条目，按写入日志的顺序保留
+    if (mergeTail) {
+        char buffer[8192];
+        off_t position = journalOffset_;
+        while (true) {
+            ssize_t n = pread(journalFd_, buffer, sizeof(buffer), position);
+            if (n == 0) {
+                break;
+            }
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                flock(journalFd_, LOCK_UN);
+                return false;
+            }
+            contents.append(buffer, static_cast<size_t>(n));
+            position += n;
+        }
+        if (!contents.empty() && contents.back() != '\n') {
+            contents += '\n';
+        }
+    }
+
+    // 只保留最后 maxSize 行
+    size_t lines = 0;
+    for (size_t i = contents.size(); i > 0; --i) {
+        if (contents[i - 1] == '\n' && lines++ == maxSize_) {
+            contents.erase(0, i);
+            --lines;
+            break;
+        }
+    }
+
+    std::string tmpPath = journalPath_ + ".tmp";
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        flock(journalFd_, LOCK_UN);
+        return false;
+    }
+
+    size_t offset = 0;
+    while (offset < contents.size()) {
+        ssize_t written = write(fd, contents.data() + offset, contents.size() - offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close(fd);
+            unlink(tmpPath.c_str());
+            flock(journalFd_, LOCK_UN);
+            return false;
+        }
+        offset += static_cast<size_t>(written);
+    }
+
+    // 数据落盘后再替换，避免崩溃后得到空文件
+    if (fsync(fd) != 0 || close(fd) != 0 || rename(tmpPath.c_str(), journalPath_.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        flock(journalFd_, LOCK_UN);
+        return false;
+    }
+
+    // 原描述符指向被替换的旧文件，重新打开；关闭旧描述符时释放锁，
+    // 等在旧文件上的其他 shell 随后发现文件已被替换并重新打开
+    int newFd = open(journalPath_.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+    if (newFd < 0) {
+        flock(journalFd_, LOCK_UN);
+        return false;
+    }
+    close(journalFd_);
+    journalFd_ = newFd;
+    journalLines_ = lines;
+
+    // 合并后的日志可能含有其他 shell 的条目，下次压缩整个文件都按尾部读取
+    journalOffset_ = mergeTail ? 0 : static_cast<off_t>(contents.size());
+    journalBase_ = mergeTail ? 0 : nextIndex_;
     return true;
 }
 
@@ -182,16 +459,11 @@ bool History::saveToFile(const std::string& filename) const {
         return false;
     }
     
-    for (const auto& entry : history_) {
-        // 确保时间戳是有效的
-        time_t timestamp = entry.timestamp;
-        if (timestamp <= 0) {
-            timestamp = std::time(nullptr);  // 如果时间戳无效，使用当前时间
-        }
-        
-        // 保存格式：时间戳 命令
-        file << timestamp << ' ' << entry.command << '\n';
+    std::string contents;
+    for (const auto& entry : getAllCommands()) {
+        formatEntry(entry, contents);
     }
+    file << contents;
     
     return file.good();
 }
@@ -201,14 +473,14 @@ std::vector<HistoryEntry> History::searchCommands(const std::string& pattern) co
     
     try {
         std::regex regex(pattern);
-        for (const auto& entry : history_) {
+        for (const auto& entry : getAllCommands()) {
             if (std::regex_search(entry.command, regex)) {
                 result.push_back(entry);
             }
         }
     } catch (const std::regex_error&) {
         // 正则表达式错误，使用普通的子串搜索
-        for (const auto& entry : history_) {
+        for (const auto& entry : getAllCommands()) {
             if (entry.command.find(pattern) != std::string::npos) {
                 result.push_back(entry);
             }
@@ -101,7 +101,7 @@ namespace dash
             Transaction::current_command_list_ = transaction_map_[transaction_name]->command_list_;
             Transaction::current_command_index = 0;
             setT_InputType(T_InputType::transaction); // 设置为事务开始
-            std::cout<<"开始事务："<<transaction_name<<std::endl;
+            std::cout<<"开始事务："<<transaction_name<<'\n';
             setAutoRun(false); // 设置为单步运行
         }else{
             std::cerr<< transaction_name <<"事务不存在"<<std::endl;
@@ -112,7 +112,7 @@ namespace dash
         Transaction::current_transaction_name_ = transaction_name;
         Transaction::current_command_list_.clear();
         setT_InputType(T_InputType::record); // 设置为记录输入
-        std::cout<<"开始记录事务："<< transaction_name <<std::endl;
+        std::cout<<"开始记录事务："<< transaction_name << '\n';
     }
 
     void Transaction::transactionComplete() {
@@ -127,7 +127,7 @@ namespace dash
         Transaction::current_transaction_name_ = ""; // 清空当前事务名称
         Transaction::current_command_list_.clear(); // 清空当前事务命令列表
         setT_InputType(T_InputType::normal); // 恢复为普通输入
-        std::cout<<"事务记录结束"<<std::endl;
+        std::cout<<"事务记录结束"<<'\n';
     }
 
     void Transaction::transactionDelete(const std::string &transaction_name){
@@ -138,7 +138,7 @@ namespace dash
             }
             transaction_map_.erase(transaction_name);
             std::filesystem::remove(filePath + transaction_name);
-            std::cout<<"已删除事务："<< transaction_name <<std::endl;
+            std::cout<<"已删除事务："<< transaction_name << '\n';
         }else{
             std::cerr<< transaction_name <<"事务不存在"<<std::endl;
         }
@@ -208,10 +208,10 @@ namespace dash
         }
     };
     void Transaction::outputTransactionInfo() {
-        std::cout << "编号" << "\t" << "事务名称" << "\t" << "命令数" << std::endl;
+        std::cout << "编号" << "\t" << "事务名称" << "\t" << "命令数" << '\n';
         int index = 0;
         for(auto &transaction : transaction_map_){
-            std::cout<<index++<<"\t"<<transaction.first<<"\t"<<transaction.second->command_list_.size()<<std::endl;
+            std::cout<<index++<<"\t"<<transaction.first<<"\t"<<transaction.second->command_list_.size()<<'\n';
         }
     }
     void Transaction::transactionInterrupt(){
@@ -0,0 +1,255 @@
+/**
+ * @file expansion_program.cpp
+ * @brief 单词展开程序实现
+ */
+
+#include <cctype>
+#include "variable/expansion_program.h"
+
+namespace dash
+{
+
+    ExpansionProgram::ExpansionProgram()
+        : literal_(true)
+    {
+    }
+
+    ExpansionProgram::ExpansionProgram(std::string_view str)
+        : literal_(true)
+    {
+        size_t i = 0;
+
+        while (i < str.length())
+        {
+            // 算术展开 $((expr))，找不到配对的 )) 时按命令替换处理
+            if (str.compare(i, 3, "$((") == 0)
+            {
+                size_t end = findArithmeticEnd(str, i + 3);
+                if (end != std::string_view::npos)
+                {
+                    std::string_view expression = str.substr(i + 3, end - i - 3);
+                    segments_.emplace_back(ExpansionSegment::Kind::ARITHMETIC, expression);
+                    if (needsExpansion(expression))
+                    {
+                        segments_.back().expansion = std::make_shared<const ExpansionProgram>(expression);
+                    }
+                    else
+                    {
+                        segments_.back().arithmetic = std::make_shared<const ArithmeticProgram>(expression);
+                    }
+                    literal_ = false;
+                    i = end + 2; // 跳过 ))
+                    continue;
+                }
+            }
+
+            // 命令替换 $(command)
+            if (i + 1 < str.length() && str[i] == '$' && str[i + 1] == '(')
+            {
+                i += 2; // 跳过 $(
+                size_t start = i;
+                int paren_count = 1;
+
+                // 查找匹配的右括号
+                while (i < str.length() && paren_count > 0)
+                {
+                    if (str[i] == '(')
+                    {
+                        paren_count++;
+                    }
+                    else if (str[i] == ')')
+                    {
+                        paren_count--;
+                    }
+
+                    if (paren_count > 0)
+                    {
+                        i++;
+                    }
+                }
+
+                if (i < str.length() && paren_count == 0)
+                {
+                    segments_.emplace_back(ExpansionSegment::Kind::COMMAND, str.substr(start, i - start));
+                    literal_ = false;
+                    i++; // 跳过 )
+                }
+                else
+                {
+                    // 未闭合的括号，保持原样
+                    appendLiteral(str.substr(start - 2, i - start + 2));
+                }
+            }
+            // 命令替换 `command`
+            else if (str[i] == '`')
+            {
+                i++; // 跳过开始的 `
+                size_t start = i;
+
+                // 查找匹配的反引号
+                while (i < str.length() && str[i] != '`')
+                {
+                    i++;
+                }
+
+                if (i < str.length())
+                {
+                    segments_.emplace_back(ExpansionSegment::Kind::COMMAND, str.substr(start, i - start));
+                    literal_ = false;
+                    i++; // 跳过结束的 `
+                }
+                else
+                {
+                    // 未闭合的反引号，保持原样
+                    appendLiteral(str.substr(start - 1));
+                }
+            }
+            // 变量引用
+            else if (str[i] == '$' && i + 1 < str.length())
+            {
+                size_t start = i;
+                i++; // 跳过 $
+
+                // ${name} 形式
+                if (str[i] == '{')
+                {
+                    i++; // 跳过 {
+                    size_t name_start = i;
+                    while (i < str.length() && str[i] != '}')
+                    {
+                        i++;
+                    }
+
+                    if (i < str.length())
+                    {
+                        segments_.emplace_back(ExpansionSegment::Kind::VARIABLE, str.substr(name_start, i - name_start));
+                        literal_ = false;
+                        i++; // 跳过 }
+                    }
+                    else
+                    {
+                        // 未闭合的 ${，保持原样
+                        appendLiteral(str.substr(start));
+                    }
+                }
+                // 特殊变量
+                else if (str[i] == '$' || str[i] == '?' || str[i] == '#' || (str[i] >= '0' && str[i] <= '9'))
+                {
+                    segments_.emplace_back(ExpansionSegment::Kind::VARIABLE, str.substr(i, 1));
+                    literal_ = false;
+                    i++;
+                }
+                // 普通变量
+                else if (isalpha(static_cast<unsigned char>(str[i])) || str[i] == '_')
+                {
+                    size_t name_start = i;
+                    while (i < str.length() && (isalnum(static_cast<unsigned char>(str[i])) || str[i] == '_'))
+                    {
+                        i++;
+                    }
+
+                    segments_.emplace_back(ExpansionSegment::Kind::VARIABLE, str.substr(name_start, i - name_start));
+                    literal_ = false;
+                }
+                else
+                {
+                    // 单独的 $，保持原样
+                    appendLiteral("$");
+                }
+            }
+            else
+            {
+                // 连续的普通字符作为一个字面段
+                size_t start = i;
+                while (i < str.length() && str[i] != '$' && str[i] != '`')
+                {
+                    i++;
+                }
+                if (i == start)
+                {
+                    i++; // 末尾单独的 $
+                }
+                appendLiteral(str.substr(start, i - start));
+            }
+        }
+    }
+
+    size_t ExpansionProgram::findArithmeticEnd(std::string_view str, size_t start)
+    {
+        int depth = 0;
+        for (size_t i = start; i < str.length(); ++i)
+        {
+            if (str[i] == '(')
+            {
+                depth++;
+            }
+            else if (str[i] == ')')
+            {
+                if (depth == 0)
+                {
+                    return i + 1 < str.length() && str[i + 1] == ')' ? i : std::string_view::npos;
+                }
+                depth--;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    bool ExpansionProgram::needsExpansion(std::string_view expression)
+    {
+        for (size_t i = 0; i < expression.length(); ++i)
+        {
+            if (expression[i] == '`')
+            {
+                return true;
+            }
+            if (expression[i] != '$' || i + 1 >= expression.length())
+            {
+                continue;
+            }
+            if (expression[i + 1] == '(')
+            {
+                return true;
+            }
+            if (expression[i + 1] == '{')
+            {
+                size_t close = expression.find('}', i + 2);
+                if (close == std::string_view::npos || close == i + 2)
+                {
+                    return true;
+                }
+                for (size_t j = i + 2; j < close; ++j)
+                {
+                    if (!isalnum(static_cast<unsigned char>(expression[j])) && expression[j] != '_')
+                    {
+                        return true;
+                    }
+                }
+                i = close;
+            }
+        }
+        return false;
+    }
+
+    void ExpansionProgram::appendLiteral(std::string_view text)
+    {
+        if (!segments_.empty() && segments_.back().kind == ExpansionSegment::Kind::LITERAL)
+        {
+            segments_.back().text.append(text.data(), text.size());
+        }
+        else
+        {
+            segments_.emplace_back(ExpansionSegment::Kind::LITERAL, text);
+        }
+    }
+
+    std::string_view ExpansionProgram::getLiteral() const
+    {
+        if (segments_.empty())
+        {
+            return std::string_view();
+        }
+        return segments_.front().text;
+    }
+
+} // namespace dash
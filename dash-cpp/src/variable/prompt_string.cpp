@@ -1,5 +1,6 @@
 #include"variable/prompt_string.h"
 #include <stdio.h>
+#include <iostream>
 #include <unistd.h>
 #include <sys/utsname.h>
 #include <string.h>
@@ -15,130 +16,125 @@
 
 namespace dash{
     int prompt_string::promptMode = 3;
+    bool prompt_string::identityLoaded = false;
+    std::string prompt_string::user;
+    std::string prompt_string::hostname;
+    bool prompt_string::isRoot = false;
+    bool prompt_string::cwdValid = false;
+    std::string prompt_string::cwd;
+    bool prompt_string::rawValid = false;
+    std::string prompt_string::rawPrompt;
+    bool prompt_string::formattedValid = false;
+    std::string prompt_string::formattedPrompt;
+
     void prompt_string::setPromptMode(unsigned int mode) {
         int modeHigh = mode >> 16, modeLow = mode & 0xffff;
+        int oldMode = promptMode;
         promptMode |= modeLow;
         promptMode &= ~modeHigh;
+        // 只有格式化的提示符依赖显示模式
+        if (promptMode != oldMode) {
+            formattedValid = false;
+        }
     }
-    void prompt_string::printPromptInfo(){
-        std::string prompt = prompt_string::getFormattedPrompt();
-        printf("%s", prompt.c_str());
-        resetColors();
+    void prompt_string::invalidateCwd(){
+        cwdValid = false;
+        rawValid = false;
+        formattedValid = false;
     }
-    std::string prompt_string::getFormattedPrompt(){
-        std::string prompt;
+    void prompt_string::loadIdentity(){
+        if (identityLoaded) {
+            return;
+        }
+        identityLoaded = true;
+
         // 获取当前用户
         char* login = getlogin();
-        std::string user = (login != NULL) ? login : "unknown";
-        int userlen = user.length();
+        user = (login != NULL) ? login : "unknown";
 
         // 获取主机名
         struct utsname utsname_info;
         if (uname(&utsname_info) == -1) {
             perror("uname");
-            return "";
+            hostname.clear();
+        } else {
+            hostname = utsname_info.nodename;
         }
-        std::string hostname = utsname_info.nodename;
-        int hostnamelen = hostname.length();
 
-        // 获取当前工作目录
-        std::string cwd;
-        char cwd_buffer[PATH_MAX];
-        if (getcwd(cwd_buffer, sizeof(cwd_buffer)) == NULL) {
-            perror("getcwd");
-            cwd = "/";
-        } else {
-            cwd = cwd_buffer;
+        // 检查是否为 root 用户
+        isRoot = (getuid() == 0);
+    }
+    const std::string &prompt_string::currentCwd(){
+        if (!cwdValid) {
+            // 获取当前工作目录
+            char cwd_buffer[PATH_MAX];
+            if (getcwd(cwd_buffer, sizeof(cwd_buffer)) == NULL) {
+                perror("getcwd");
+                cwd = "/";
+            } else {
+                cwd = cwd_buffer;
+            }
+            cwdValid = true;
+        }
+        return cwd;
+    }
+    void prompt_string::printPromptInfo(){
+        std::string prompt = prompt_string::getFormattedPrompt();
+        // 提示符经 stdio 输出，先写出 std::cout 中缓冲的数据
+        std::cout.flush();
+        printf("%s", prompt.c_str());
+        resetColors();
+    }
+    std::string prompt_string::getFormattedPrompt(){
+        if (formattedValid) {
+            return formattedPrompt;
         }
-        int cwdlen = cwd.length();
+
+        loadIdentity();
+        std::string dir = currentCwd();
+        int userlen = user.length();
+        int hostnamelen = hostname.length();
+        int cwdlen = dir.length();
 
         // 构建简略提示符
         if((promptMode & prompt_string::formatShort) && userlen + hostnamelen + cwdlen + 2 >= PROINFORECSIZE){
             int lastLen = PROINFORECSIZE - userlen - hostnamelen - 2;
             if (lastLen > 7) {
-                std::string start = cwd.substr( 0, lastLen / 2 - 2);
-                std::string end = cwd.substr(cwdlen - lastLen / 2 + 3);
+                std::string start = dir.substr( 0, lastLen / 2 - 2);
+                std::string end = dir.substr(cwdlen - lastLen / 2 + 3);
                 const std::string indicator = "+...+";
-                cwd = start + indicator + end;
+                dir = start + indicator + end;
             }
         }
 
-        // 检查是否为 root 用户
-        if (getuid() == 0) {
-            const char *indicator = "#";
-            if(promptMode & prompt_string::color){
-                // 构建提示符
-                prompt = PROINFOGREEN + user + "@" + hostname + 
-                    PROINFORESET + ":" + 
-                    PROINFOBLUE + cwd + 
-                    PROINFORED + indicator + 
-                    PROINFORESET + " ";
-                
-                //snprintf(prompt, PROINFOMAXSIZE, "%s%s@%s%s:%s%s%s%s%s ",
-                //    PROINFOGREEN, user, hostname, PROINFORESET,PROINFOBLUE, cwd, PROINFORED, indicator, PROINFORESET);
-            }
-            else{
-                // 构建提示符
-                prompt = user + "@" + hostname + ":" + cwd + indicator;
-                //snprintf(prompt, PROINFOMAXSIZE, "%s@%s:%s%s ", user, hostname, cwd, indicator);
-            }
-                    
-        }else{
-            const char *indicator = "$";
-            if(promptMode & prompt_string::color){
-                // 构建提示符
-                prompt = PROINFOGREEN + user + "@" + hostname +
-                    PROINFORESET + ":" +
-                    PROINFOBLUE + cwd +
-                    PROINFOYELLOW + indicator +
-                    PROINFORESET + " ";
-
-                //snprintf(prompt, PROINFOMAXSIZE, "%s%s@%s%s:%s%s%s%s%s ",
-                //    PROINFOGREEN, user, hostname, PROINFORESET,PROINFOBLUE, cwd, PROINFOYELLOW, indicator, PROINFORESET);
-            }
-            else{
-                // 构建提示符
-                prompt = user + "@" + hostname + ":" + cwd + indicator;
-                //snprintf(prompt, PROINFOMAXSIZE, "%s@%s:%s%s ", user, hostname, cwd, indicator);
-            }
-        }
-        return prompt;
-    }
-    std::string prompt_string::getRawPrompt(){
         std::string prompt;
-        // 获取当前用户
-        char* login = getlogin();
-        std::string user = (login != NULL) ? login : "unknown";
-        int userlen = user.length();
-
-        // 获取主机名
-        struct utsname utsname_info;
-        if (uname(&utsname_info) == -1) {
-            perror("uname");
-            return "";
+        const char *indicator = isRoot ? "#" : "$";
+        if(promptMode & prompt_string::color){
+            // 构建提示符，root 用户的提示符号为红色
+            prompt = PROINFOGREEN + user + "@" + hostname +
+                PROINFORESET + ":" +
+                PROINFOBLUE + dir +
+                (isRoot ? PROINFORED : PROINFOYELLOW) + indicator +
+                PROINFORESET + " ";
         }
-        std::string hostname = utsname_info.nodename;
-        int hostnamelen = hostname.length();
-
-        // 获取当前工作目录
-        std::string cwd;
-        char cwd_buffer[PATH_MAX];
-        if (getcwd(cwd_buffer, sizeof(cwd_buffer)) == NULL) {
-            perror("getcwd");
-            cwd = "/";
-        } else {
-            cwd = cwd_buffer;
+        else{
+            // 构建提示符
+            prompt = user + "@" + hostname + ":" + dir + indicator;
         }
-        int cwdlen = cwd.length();
 
-        // 检查是否为 root 用户
-        if (getuid() == 0) {
-            prompt = user + "@" + hostname + ":" + cwd + "#" + " ";
-        }else{
-            prompt = user + "@" + hostname + ":" + cwd + "$" + " ";
+        formattedPrompt = prompt;
+        formattedValid = true;
+        return formattedPrompt;
+    }
+    std::string prompt_string::getRawPrompt(){
+        if (rawValid) {
+            return rawPrompt;
         }
-        return prompt;
-        
+
+        loadIdentity();
+        rawPrompt = user + "@" + hostname + ":" + currentCwd() + (isRoot ? "#" : "$") + " ";
+        rawValid = true;
+        return rawPrompt;
     }
     void prompt_string::resetColors() {
         printf("%s",PROINFORESET);
@@ -147,4 +143,4 @@ namespace dash{
 
 void resetColors() {
     printf("\033[0m");
-}
\ No newline at end of file
+}
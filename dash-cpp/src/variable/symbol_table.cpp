@@ -0,0 +1,99 @@
+/**
+ * @file symbol_table.cpp
+ * @brief 变量符号表实现
+ */
+
+#include "variable/symbol_table.h"
+
+namespace dash
+{
+
+    namespace
+    {
+        // 哈希索引的初始槽位数
+        constexpr size_t INITIAL_SLOTS = 256;
+    }
+
+    SymbolTable::SymbolTable()
+        : slots_(INITIAL_SLOTS, Slot{0, INVALID_VAR_HANDLE})
+    {
+        entries_.reserve(INITIAL_SLOTS / 2);
+    }
+
+    uint32_t SymbolTable::hashName(std::string_view name)
+    {
+        uint32_t hash = 2166136261u;
+        for (char c : name)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    VarHandle SymbolTable::find(std::string_view name) const
+    {
+        uint32_t hash = hashName(name);
+        size_t mask = slots_.size() - 1;
+
+        for (size_t i = hash & mask;; i = (i + 1) & mask)
+        {
+            const Slot &slot = slots_[i];
+            if (slot.handle == INVALID_VAR_HANDLE)
+            {
+                return INVALID_VAR_HANDLE;
+            }
+            if (slot.hash == hash && entries_[slot.handle].variable.getName() == name)
+            {
+                return slot.handle;
+            }
+        }
+    }
+
+    VarHandle SymbolTable::intern(std::string_view name)
+    {
+        VarHandle handle = find(name);
+        if (handle != INVALID_VAR_HANDLE)
+        {
+            return handle;
+        }
+
+        if ((entries_.size() + 1) * 2 > slots_.size())
+        {
+            grow();
+        }
+
+        uint32_t hash = hashName(name);
+        handle = static_cast<VarHandle>(entries_.size());
+        entries_.push_back(Entry{Variable(std::string(name), ""), hash, false});
+
+        size_t mask = slots_.size() - 1;
+        size_t i = hash & mask;
+        while (slots_[i].handle != INVALID_VAR_HANDLE)
+        {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = Slot{hash, handle};
+
+        return handle;
+    }
+
+    void SymbolTable::grow()
+    {
+        std::vector<Slot> slots(slots_.size() * 2, Slot{0, INVALID_VAR_HANDLE});
+        size_t mask = slots.size() - 1;
+
+        for (VarHandle handle = 0; handle < entries_.size(); ++handle)
+        {
+            size_t i = entries_[handle].hash & mask;
+            while (slots[i].handle != INVALID_VAR_HANDLE)
+            {
+                i = (i + 1) & mask;
+            }
+            slots[i] = Slot{entries_[handle].hash, handle};
+        }
+
+        slots_.swap(slots);
+    }
+
+} // namespace dash
@@ -0,0 +1,31 @@
+/**
+ * @file variable.cpp
+ * @brief 变量类实现
+ */
+
+#include "variable/variable.h"
+
+namespace dash
+{
+
+    // Variable 实现
+
+    Variable::Variable(const std::string &name, const std::string &value, int flags)
+        : name_(name), value_(value), flags_(flags), updateValueFunc_(nullptr)
+    {
+    }
+
+    bool Variable::setValue(std::string_view value)
+    {
+        // 如果变量是只读的，则不能修改
+        if (hasFlag(VAR_READONLY))
+        {
+            return false;
+        }
+
+        // 复用已有的容量，不重新分配
+        value_.assign(value.data(), value.size());
+        return true;
+    }
+
+} // namespace dash
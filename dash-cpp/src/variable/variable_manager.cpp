@@ -5,11 +5,18 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
 #include <regex>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
 #include "variable/variable_manager.h"
 #include "core/shell.h"
+#include "core/executor.h"
+#include "core/parser.h"
+#include "core/node.h"
 #include "utils/error.h"
 #include "variable/prompt_string.h"
 
@@ -18,37 +25,24 @@ extern char **environ;
 namespace dash
 {
 
-    // Variable 实现
-
-    Variable::Variable(const std::string &name, const std::string &value, int flags)
-        : name_(name), value_(value), flags_(flags)
-    {
-    }
-
-    bool Variable::setValue(const std::string &value)
-    {
-        // 如果变量是只读的，则不能修改
-        if (hasFlag(VAR_READONLY))
-        {
-            return false;
-        }
-
-        value_ = value;
-        return true;
-    }
-
     // VariableManager 实现
 
     VariableManager::VariableManager(Shell *shell)
-        : shell_(shell)
+        : shell_(shell), initialized_(false), export_generation_(1), envp_generation_(0)
     {
+        // 特殊参数最先驻留，占据固定句柄
+        symbols_.intern("?");
+        symbols_.intern("$");
+        symbols_.intern("#");
+        symbols_.intern("0");
+        path_handle_ = symbols_.intern("PATH");
+
         initialize();
+        initialized_ = true;
     }
 
     VariableManager::~VariableManager()
     {
-        // 清空变量表
-        variables_.clear();
     }
 
     void VariableManager::initialize()
@@ -75,8 +69,8 @@ namespace dash
         set("IFS", " \t\n", Variable::VAR_NONE);
 
         // 设置特殊变量
-        set("?", "0", Variable::VAR_SPECIAL);
-        set("$", std::to_string(getpid()), Variable::VAR_SPECIAL);
+        setSpecialNumber(SPECIAL_STATUS, 0);
+        setSpecialNumber(SPECIAL_PID, getpid());
 
         // 设置 PATH 如果不存在
         if (!exists("PATH"))
@@ -107,138 +101,246 @@ namespace dash
             return false;
         }
 
-        // 检查是否是特殊变量
-        if (name == "?" || name == "$" || name == "#" || name == "0")
+        size_t index;
+        if (positionalIndex(name, index))
         {
-            flags |= Variable::VAR_SPECIAL;
+            if (index >= positional_.size())
+            {
+                positional_.resize(index + 1);
+                setSpecialNumber(SPECIAL_ARGC, static_cast<long>(positional_.size()));
+            }
+            positional_[index] = value;
+            return true;
         }
 
-        // 如果变量已存在
-        auto it = variables_.find(name);
-        if (it != variables_.end())
+        return setByHandle(symbols_.intern(name), value, flags);
+    }
+
+    bool VariableManager::positionalIndex(std::string_view name, size_t &index)
+    {
+        // $0 是普通的特殊参数，其余全数字的名字是位置参数
+        if (name.empty() || name.size() > 9 || name == "0")
         {
-            // 如果变量是只读的，则不能修改
-            if (it->second->hasFlag(Variable::VAR_READONLY))
+            return false;
+        }
+        size_t value = 0;
+        for (char c : name)
+        {
+            if (c < '0' || c > '9')
             {
                 return false;
             }
+            value = value * 10 + static_cast<size_t>(c - '0');
+        }
+        if (value == 0)
+        {
+            return false;
+        }
+        index = value - 1;
+        return true;
+    }
 
-            // 更新变量值和标志
-            it->second->setValue(value);
+    void VariableManager::swapPositional(std::vector<std::string> &params)
+    {
+        positional_.swap(params);
+        setSpecialNumber(SPECIAL_ARGC, static_cast<long>(positional_.size()));
+    }
 
-            // 保留原有标志，添加新标志
-            int new_flags = it->second->getFlags() | flags;
-            it->second->setFlags(new_flags);
+    bool VariableManager::setByHandle(VarHandle handle, std::string_view value, int flags)
+    {
+        // 检查是否是特殊变量
+        if (handle <= SPECIAL_ARG0)
+        {
+            flags |= Variable::VAR_SPECIAL;
+        }
+
+        Variable &var = symbols_.at(handle);
 
-            // 如果变量是导出的，则更新环境变量
-            if (it->second->hasFlag(Variable::VAR_EXPORT))
+        // 如果变量已存在
+        if (symbols_.isDefined(handle))
+        {
+            // 如果变量是只读的，则不能修改
+            if (var.hasFlag(Variable::VAR_READONLY))
             {
-                setenv(name.c_str(), value.c_str(), 1);
+                return false;
             }
+
+            // 更新变量值，保留原有标志，添加新标志
+            var.setValue(value);
+            var.setFlags(var.getFlags() | flags);
         }
         else
         {
-            // 创建新变量
-            variables_[name] = std::make_unique<Variable>(name, value, flags);
+            // 定义新变量（槽位可能是之前 unset 留下的，重置全部状态）
+            var.setFlags(Variable::VAR_NONE);
+            var.setUpdateValueFunc(nullptr);
+            var.setValue(value);
+            var.setFlags(flags);
+            symbols_.setDefined(handle, true);
+        }
 
-            // 如果变量是导出的，则设置环境变量
-            if (flags & Variable::VAR_EXPORT)
-            {
-                setenv(name.c_str(), value.c_str(), 1);
-            }
+        // 导出变量改变后，envp 快照需要重建
+        if (var.hasFlag(Variable::VAR_EXPORT))
+        {
+            export_generation_++;
+        }
+
+        if (handle == path_handle_)
+        {
+            invalidateCommandHash();
         }
 
         return true;
     }
 
+    void VariableManager::setSpecialNumber(VarHandle handle, long value)
+    {
+        char buf[24];
+        auto result = std::to_chars(buf, buf + sizeof(buf), value);
+        setByHandle(handle, std::string_view(buf, result.ptr - buf), Variable::VAR_SPECIAL);
+    }
+
+    void VariableManager::invalidateCommandHash()
+    {
+        // PATH 改变后，缓存的命令路径全部失效
+        if (initialized_ && shell_ && shell_->getExecutor())
+        {
+            shell_->getExecutor()->getCommandHash().clear();
+        }
+    }
+
     void VariableManager::setUpdateValueFunc(const std::string &name, std::string (*func)()) {
-        auto it = variables_.find(name);
-        if (it != variables_.end())
+        VarHandle handle = symbols_.find(name);
+        if (symbols_.isDefined(handle))
         {
-            it->second->setUpdateValueFunc(func);
+            symbols_.at(handle).setUpdateValueFunc(func);
         }
     }
 
     std::string VariableManager::get(const std::string &name) const
     {
-        auto it = variables_.find(name);
-        if (it != variables_.end())
+        size_t index;
+        if (positionalIndex(name, index))
         {
+            return index < positional_.size() ? positional_[index] : std::string();
+        }
+        return get(symbols_.find(name));
+    }
 
-            return it->second->getValue();
+    VarHandle VariableManager::resolve(std::string_view name) const
+    {
+        size_t index;
+        if (positionalIndex(name, index))
+        {
+            return POSITIONAL_HANDLE_BASE + static_cast<VarHandle>(index);
         }
+        return symbols_.intern(name);
+    }
 
-        return "";
+    const std::string &VariableManager::get(VarHandle handle) const
+    {
+        static const std::string empty;
+        if (handle >= POSITIONAL_HANDLE_BASE && handle != INVALID_VAR_HANDLE)
+        {
+            size_t index = handle - POSITIONAL_HANDLE_BASE;
+            return index < positional_.size() ? positional_[index] : empty;
+        }
+        if (!symbols_.isDefined(handle))
+        {
+            return empty;
+        }
+        return symbols_.at(handle).getValue();
+    }
+
+    void VariableManager::setLastStatus(int exit_status)
+    {
+        setSpecialNumber(SPECIAL_STATUS, exit_status);
     }
 
     bool VariableManager::exists(const std::string &name) const
     {
-        return variables_.find(name) != variables_.end();
+        size_t index;
+        if (positionalIndex(name, index))
+        {
+            return index < positional_.size();
+        }
+        return symbols_.isDefined(symbols_.find(name));
     }
 
     bool VariableManager::unset(const std::string &name)
     {
-        auto it = variables_.find(name);
-        if (it != variables_.end())
+        VarHandle handle = symbols_.find(name);
+        if (!symbols_.isDefined(handle))
         {
-            // 如果变量是只读的或特殊的，则不能删除
-            if (it->second->hasFlag(Variable::VAR_READONLY) ||
-                it->second->hasFlag(Variable::VAR_SPECIAL))
-            {
-                return false;
-            }
+            return false;
+        }
 
-            // 如果变量是导出的，则从环境中删除
-            if (it->second->hasFlag(Variable::VAR_EXPORT))
-            {
-                unsetenv(name.c_str());
-            }
+        Variable &var = symbols_.at(handle);
 
-            // 从变量表中删除
-            variables_.erase(it);
-            return true;
+        // 如果变量是只读的或特殊的，则不能删除
+        if (var.hasFlag(Variable::VAR_READONLY) ||
+            var.hasFlag(Variable::VAR_SPECIAL))
+        {
+            return false;
         }
 
-        return false;
+        // 如果变量是导出的，则 envp 快照需要重建
+        if (var.hasFlag(Variable::VAR_EXPORT))
+        {
+            export_generation_++;
+        }
+
+        // 保留槽位和句柄，只标记为未定义
+        symbols_.setDefined(handle, false);
+
+        if (handle == path_handle_)
+        {
+            invalidateCommandHash();
+        }
+        return true;
     }
 
     bool VariableManager::exportVar(const std::string &name)
     {
-        auto it = variables_.find(name);
-        if (it != variables_.end())
+        VarHandle handle = symbols_.find(name);
+        if (!symbols_.isDefined(handle))
         {
-            // 添加导出标志
-            it->second->addFlag(Variable::VAR_EXPORT);
-
-            // 设置环境变量
-            setenv(name.c_str(), it->second->getValue().c_str(), 1);
-            return true;
+            return false;
         }
 
-        return false;
+        // 添加导出标志
+        Variable &var = symbols_.at(handle);
+        if (!var.hasFlag(Variable::VAR_EXPORT))
+        {
+            var.addFlag(Variable::VAR_EXPORT);
+            export_generation_++;
+        }
+        return true;
     }
 
     bool VariableManager::setReadOnly(const std::string &name)
     {
-        auto it = variables_.find(name);
-        if (it != variables_.end())
+        VarHandle handle = symbols_.find(name);
+        if (!symbols_.isDefined(handle))
         {
-            // 添加只读标志
-            it->second->addFlag(Variable::VAR_READONLY);
-            return true;
+            return false;
         }
 
-        return false;
+        // 添加只读标志
+        symbols_.at(handle).addFlag(Variable::VAR_READONLY);
+        return true;
     }
 
     std::vector<std::string> VariableManager::getAllNames() const
     {
         std::vector<std::string> names;
-        names.reserve(variables_.size());
 
-        for (const auto &pair : variables_)
+        for (VarHandle handle = 0; handle < symbols_.size(); ++handle)
         {
-            names.push_back(pair.first);
+            if (symbols_.isDefined(handle))
+            {
+                names.push_back(symbols_.at(handle).getName());
+            }
         }
 
         return names;
@@ -248,11 +350,12 @@ namespace dash
     {
         std::vector<std::pair<std::string, std::string>> exports;
 
-        for (const auto &pair : variables_)
+        for (VarHandle handle = 0; handle < symbols_.size(); ++handle)
         {
-            if (pair.second->hasFlag(Variable::VAR_EXPORT))
+            const Variable &var = symbols_.at(handle);
+            if (symbols_.isDefined(handle) && var.hasFlag(Variable::VAR_EXPORT))
             {
-                exports.emplace_back(pair.first, pair.second->getValue());
+                exports.emplace_back(var.getName(), var.getValue());
             }
         }
 
@@ -263,182 +366,191 @@ namespace dash
     {
         std::vector<std::string> env;
 
-        for (const auto &pair : variables_)
+        for (VarHandle handle = 0; handle < symbols_.size(); ++handle)
         {
-            if (pair.second->hasFlag(Variable::VAR_EXPORT))
+            const Variable &var = symbols_.at(handle);
+            if (symbols_.isDefined(handle) && var.hasFlag(Variable::VAR_EXPORT))
             {
-                env.push_back(pair.first + "=" + pair.second->getValue());
+                env.push_back(var.getName() + "=" + var.getValue());
             }
         }
 
         return env;
     }
 
-    std::string VariableManager::expand(const std::string &str) const
+    char *const *VariableManager::getEnvp() const
     {
-        std::string result;
-        size_t i = 0;
-        
-        while (i < str.length())
+        if (envp_generation_ == export_generation_)
         {
-            // 处理命令替换 $(command)
-            if (i + 1 < str.length() && str[i] == '$' && str[i + 1] == '(')
+            return envp_.data();
+        }
+
+        // 所有条目追加到同一块存储区（容量在多次重建之间复用），先记录偏移，最后再转换为指针
+        envp_storage_.clear();
+        std::vector<size_t> offsets;
+        for (VarHandle handle = 0; handle < symbols_.size(); ++handle)
+        {
+            const Variable &var = symbols_.at(handle);
+            if (!symbols_.isDefined(handle) || !var.hasFlag(Variable::VAR_EXPORT))
             {
-                i += 2; // 跳过 $(
-                size_t start = i;
-                int paren_count = 1;
-                
-                // 查找匹配的右括号
-                while (i < str.length() && paren_count > 0)
-                {
-                    if (str[i] == '(')
-                    {
-                        paren_count++;
-                    }
-                    else if (str[i] == ')')
-                    {
-                        paren_count--;
-                    }
-                    
-                    if (paren_count > 0)
-                    {
-                        i++;
-                    }
-                }
-                
-                if (i < str.length() && paren_count == 0)
-                {
-                    // 提取命令
-                    std::string cmd = str.substr(start, i - start);
-                    i++; // 跳过 )
-                    
-                    // 执行命令并获取输出
-                    std::string output = executeCommandSubstitution(cmd);
-                    
-                    // 移除尾部的换行符
-                    if (!output.empty() && output[output.length() - 1] == '\n')
-                    {
-                        output.pop_back();
-                    }
-                    
-                    // 添加到结果
-                    result += output;
-                }
-                else
-                {
-                    // 未闭合的括号，保持原样
-                    result += "$(" + str.substr(start, i - start);
-                }
+                continue;
             }
-            // 处理命令替换 `command`
-            else if (str[i] == '`')
+
+            offsets.push_back(envp_storage_.size());
+            const std::string &name = var.getName();
+            const std::string &value = var.getValue();
+            envp_storage_.insert(envp_storage_.end(), name.begin(), name.end());
+            envp_storage_.push_back('=');
+            envp_storage_.insert(envp_storage_.end(), value.begin(), value.end());
+            envp_storage_.push_back('\0');
+        }
+
+        envp_.clear();
+        for (size_t offset : offsets)
+        {
+            envp_.push_back(envp_storage_.data() + offset);
+        }
+        envp_.push_back(nullptr);
+
+        envp_generation_ = export_generation_;
+        return envp_.data();
+    }
+
+    char *const *VariableManager::getEnvp(const std::vector<std::string> &overlay, std::vector<char *> &envp) const
+    {
+        char *const *base = getEnvp();
+        if (overlay.empty())
+        {
+            return base;
+        }
+
+        envp.assign(envp_.begin(), envp_.end() - 1);
+        for (const auto &entry : overlay)
+        {
+            // 名字包括等号，避免 FOO 匹配 FOOBAR
+            size_t name_len = entry.find('=') + 1;
+            bool replaced = false;
+            for (auto &slot : envp)
             {
-                i++; // 跳过开始的 `
-                size_t start = i;
-                
-                // 查找匹配的反引号
-                while (i < str.length() && str[i] != '`')
+                if (std::strncmp(slot, entry.c_str(), name_len) == 0)
                 {
-                    i++;
-                }
-                
-                if (i < str.length() && str[i] == '`')
-                {
-                    // 提取命令
-                    std::string cmd = str.substr(start, i - start);
-                    i++; // 跳过结束的 `
-                    
-                    // 执行命令并获取输出
-                    std::string output = executeCommandSubstitution(cmd);
-                    
-                    // 移除尾部的换行符
-                    if (!output.empty() && output[output.length() - 1] == '\n')
-                    {
-                        output.pop_back();
-                    }
-                    
-                    // 添加到结果
-                    result += output;
-                }
-                else
-                {
-                    // 未闭合的反引号，保持原样
-                    result += "`" + str.substr(start, i - start);
+                    slot = const_cast<char *>(entry.c_str());
+                    replaced = true;
+                    break;
                 }
             }
-            // 处理变量引用
-            else if (str[i] == '$' && i + 1 < str.length())
+            if (!replaced)
             {
-                // 找到变量引用
-                size_t start = i;
-                i++; // 跳过 $
-                
-                // 处理 ${name} 形式
-                if (str[i] == '{')
-                {
-                    i++; // 跳过 {
-                    size_t name_start = i;
-                    while (i < str.length() && str[i] != '}')
-                    {
-                        i++;
-                    }
-                    
-                    if (i < str.length() && str[i] == '}')
-                    {
-                        std::string var_name = str.substr(name_start, i - name_start);
-                        result += get(var_name);
-                        i++; // 跳过 }
-                    }
-                    else
-                    {
-                        // 未闭合的 ${，保持原样
-                        result += str.substr(start, i - start);
-                    }
-                }
-                // 处理特殊变量
-                else if (str[i] == '$' || str[i] == '?' || str[i] == '#' || (str[i] >= '0' && str[i] <= '9'))
+                envp.push_back(const_cast<char *>(entry.c_str()));
+            }
+        }
+        envp.push_back(nullptr);
+
+        return envp.data();
+    }
+
+    std::string VariableManager::expand(const std::string &str) const
+    {
+        return evaluate(ExpansionProgram(str));
+    }
+
+    std::string VariableManager::evaluate(const ExpansionProgram &program) const
+    {
+        if (program.isLiteral())
+        {
+            return std::string(program.getLiteral());
+        }
+
+        std::string result;
+        for (const auto &segment : program.getSegments())
+        {
+            switch (segment.kind)
+            {
+            case ExpansionSegment::Kind::LITERAL:
+                result += segment.text;
+                break;
+            case ExpansionSegment::Kind::VARIABLE:
+                // 第一次求值时解析句柄并缓存在段上
+                if (segment.handle == INVALID_VAR_HANDLE)
                 {
-                    std::string var_name = str.substr(i, 1);
-                    result += get(var_name);
-                    i++;
+                    segment.handle = resolve(segment.text);
                 }
-                // 处理普通变量
-                else if (isalpha(str[i]) || str[i] == '_')
+                result += get(segment.handle);
+                break;
+            case ExpansionSegment::Kind::COMMAND:
+                // 执行命令并获取输出（尾部换行符已去除）
+                result += executeCommandSubstitution(std::string(segment.text));
+                break;
+            case ExpansionSegment::Kind::ARITHMETIC:
+                // 表达式通常在解析时已编译，赋值类运算需要可写的变量管理器
+                try
                 {
-                    size_t name_start = i;
-                    while (i < str.length() && (isalnum(str[i]) || str[i] == '_'))
+                    if (segment.expansion)
                     {
-                        i++;
+                        // 含命令替换等的表达式先展开，展开结果变化时才重新编译
+                        std::string expression = evaluate(*segment.expansion);
+                        if (!segment.arithmetic || expression != segment.expanded)
+                        {
+                            segment.arithmetic = std::make_shared<const ArithmeticProgram>(expression);
+                            segment.expanded = std::move(expression);
+                        }
                     }
-                    
-                    std::string var_name = str.substr(name_start, i - name_start);
-                    result += get(var_name);
+                    result += std::to_string(segment.arithmetic->evaluate(*shell_->getVariableManager()));
                 }
-                else
+                catch (const ShellException &e)
                 {
-                    // 单独的 $，保持原样
-                    result += '$';
+                    // 报告错误并中止当前命令
+                    std::cerr << e.getTypeString() << ": " << e.what() << std::endl;
+                    throw;
                 }
-            }
-            else
-            {
-                result += str[i];
-                i++;
+                break;
             }
         }
-        
+
         return result;
     }
 
     // 执行命令替换并返回输出
     std::string VariableManager::executeCommandSubstitution(const std::string &cmd) const
     {
+        // 使用本 shell 的解析器解析命令文本
+        std::unique_ptr<Node> node;
+        try
+        {
+            node = shell_->getParser()->parseSubstitution(cmd);
+        }
+        catch (const ShellException &e)
+        {
+            std::cerr << e.getTypeString() << ": " << e.what() << std::endl;
+            return "";
+        }
+
+        if (!node)
+        {
+            return "";
+        }
+
+        Executor *executor = shell_->getExecutor();
+
+        // 纯内置命令直接在当前进程执行，捕获输出，不 fork
+        std::string output;
+        int status = 0;
+        if (executor->runCaptured(node.get(), output, status))
+        {
+            trimTrailingNewlines(output);
+            return output;
+        }
+
         int pipefd[2];
         if (pipe(pipefd) == -1)
         {
             return "";
         }
-        
+
+        // fork 前刷新缓冲区，避免子进程重复输出
+        std::cout.flush();
+        std::cerr.flush();
+
         pid_t pid = fork();
         if (pid == -1)
         {
@@ -456,45 +568,110 @@ namespace dash
             dup2(pipefd[1], STDOUT_FILENO);
             close(pipefd[1]);
             
-            // 执行命令
-            execl("/bin/sh", "sh", "-c", cmd.c_str(), NULL);
-            
-            // 如果 execl 返回，则表示执行失败
-            exit(1);
+            // 用本 shell 的执行器执行命令，保留变量、别名和内置命令
+            try
+            {
+                status = executor->execute(node.get());
+            }
+            catch (const ShellException &e)
+            {
+                if (e.getType() == ExceptionType::EXIT)
+                {
+                    status = shell_->getExitStatus();
+                }
+                else
+                {
+                    std::cerr << e.getTypeString() << ": " << e.what() << std::endl;
+                    status = 1;
+                }
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Error: " << e.what() << std::endl;
+                status = 1;
+            }
+
+            std::cout.flush();
+            std::cerr.flush();
+            _exit(status);
         }
         
         // 父进程
         close(pipefd[1]); // 关闭写端
         
         // 从管道读取输出
-        std::string output;
-        char buffer[4096];
-        ssize_t n;
-        
-        while ((n = read(pipefd[0], buffer, sizeof(buffer) - 1)) > 0)
-        {
-            buffer[n] = '\0';
-            output += buffer;
-        }
-        
+        readAll(pipefd[0], output);
         close(pipefd[0]);
+        trimTrailingNewlines(output);
         
         // 等待子进程结束
-        int status;
-        waitpid(pid, &status, 0);
+        while (waitpid(pid, &status, 0) == -1 && errno == EINTR)
+        {
+        }
         
         return output;
     }
 
+    void VariableManager::readAll(int fd, std::string &output)
+    {
+        // 直接读入字符串尾部的空闲空间，不经过中间缓冲区；
+        // 每次读满就把读取大小翻倍，减少大输出时的系统调用次数
+        size_t chunk = 4096;
+        const size_t max_chunk = 1 << 20;
+        size_t length = output.size();
+
+        while (true)
+        {
+            if (output.size() < length + chunk)
+            {
+                // 至少按几何级数增长，保证追加的均摊代价为常数
+                output.resize(std::max(length + chunk, output.size() * 2));
+            }
+
+            ssize_t n = read(fd, &output[length], chunk);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                break;
+            }
+            if (n == 0)
+            {
+                break;
+            }
+
+            length += static_cast<size_t>(n);
+            if (static_cast<size_t>(n) == chunk && chunk < max_chunk)
+            {
+                chunk *= 2;
+            }
+        }
+
+        output.resize(length);
+    }
+
+    void VariableManager::trimTrailingNewlines(std::string &output)
+    {
+        // 原地去除所有尾部换行符，输出中的 NUL 字节原样保留
+        size_t length = output.size();
+        while (length > 0 && output[length - 1] == '\n')
+        {
+            length--;
+        }
+        output.resize(length);
+    }
+
     void VariableManager::updateSpecialVars(int exit_status)
     {
         // 更新 $? (上一个命令的退出状态)
-        set("?", std::to_string(exit_status), Variable::VAR_SPECIAL);
+        setSpecialNumber(SPECIAL_STATUS, exit_status);
 
         // 更新 $$ (当前进程ID)
-        set("$", std::to_string(getpid()), Variable::VAR_SPECIAL);
+        setSpecialNumber(SPECIAL_PID, getpid());
 
         // TODO: 更新 $# (位置参数数量) 和 $0 (脚本名称) 等其他特殊变量
     }
 
-} // namespace dash
\ No newline at end of file
+} // namespace dash